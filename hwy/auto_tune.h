@@ -418,9 +418,18 @@ class AutoTune {
     list_ = NextWithSkip(candidates_.size());
   }
 
+  // Ends auto-tuning by declaring `Candidates()[idx]` the winner, with `cost`
+  // as its measurements. Useful for restoring the results of a previous run.
+  void SetBest(size_t idx, const CostDistribution& cost) {
+    HWY_DASSERT(!Best() && HasCandidates());
+    HWY_ASSERT(idx < candidates_.size());
+    costs_[idx] = cost;
+    best_ = &candidates_[idx];
+  }
+
   // Typically called after Best() is non-null to compare all candidates' costs.
   Span<const Config> Candidates() const {
-    HWY_DASSERT(HasCandidates());
+    HWY_DASSERT(!candidates_.empty());
     return Span<const Config>(candidates_.data(), candidates_.size());
   }
   Span<CostDistribution> Costs() {
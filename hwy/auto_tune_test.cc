@@ -119,6 +119,19 @@ TEST(AutoTuneTest, TestNextSkipAllButOne) {
   }
 }
 
+TEST(AutoTuneTest, TestSetBest) {
+  AutoTune<int> auto_tune;
+  auto_tune.SetCandidates({10, 20, 30});
+  HWY_ASSERT(!auto_tune.Best());
+
+  CostDistribution cost;
+  for (size_t i = 0; i < CostDistribution::kMaxValues; ++i) cost.Notify(5.0);
+  auto_tune.SetBest(1, cost);
+  HWY_ASSERT(auto_tune.Best() && *auto_tune.Best() == 20);
+  HWY_ASSERT(auto_tune.Best() == &auto_tune.Candidates()[1]);
+  HWY_ASSERT(auto_tune.Costs()[1].EstimateCost() == 5.0);
+}
+
 }  // namespace
 }  // namespace hwy
 
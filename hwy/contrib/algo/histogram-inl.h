@@ -0,0 +1,189 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_ALGO_HISTOGRAM_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_ALGO_HISTOGRAM_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_ALGO_HISTOGRAM_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_ALGO_HISTOGRAM_INL_H_
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmath>  // std::ldexp
+
+#include "hwy/base.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Histograms of 32 or 64-bit integer or floating-point values, for estimating
+// quantiles in a single streaming pass over arbitrarily large inputs. Each
+// function adds to `counts[0, num_bins)`, hence can be called for successive
+// chunks of a stream. Computing the bin index is vectorized; the increments
+// are scalar because lanes may share a bin.
+
+namespace detail {
+
+template <class DF, class V, HWY_IF_FLOAT_V(V)>
+HWY_INLINE V ToFloat(DF /*df*/, V v) {
+  return v;
+}
+
+template <class DF, class V, HWY_IF_NOT_FLOAT_V(V)>
+HWY_INLINE Vec<DF> ToFloat(DF df, V v) {
+  return ConvertTo(df, v);
+}
+
+// Calls `func(d, v)` for each vector of `in[0, num)` and increments the bin
+// indices it returns. The last vector may be partial; its invalid lanes are
+// not counted.
+template <class D, class Func, typename T = TFromD<D>>
+HWY_INLINE void CountBins(D d, const T* HWY_RESTRICT in, const size_t num,
+                          uint64_t* HWY_RESTRICT counts, const Func& func) {
+  using TU = MakeUnsigned<T>;
+  const RebindToUnsigned<D> du;
+  const size_t N = Lanes(d);
+  HWY_ALIGN TU bins[HWY_MAX_LANES_D(D)];
+
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      Store(func(d, LoadU(d, in + i)), du, bins);
+      for (size_t j = 0; j < N; ++j) {
+        ++counts[bins[j]];
+      }
+    }
+  }
+  const size_t remaining = num - i;
+  if (remaining != 0) {
+    Store(func(d, LoadN(d, in + i, remaining)), du, bins);
+    for (size_t j = 0; j < remaining; ++j) {
+      ++counts[bins[j]];
+    }
+  }
+}
+
+}  // namespace detail
+
+// Bin `b` counts values in `[min + b * w, min + (b + 1) * w)`, where the bin
+// width `w = (max - min) / num_bins`. Values outside `[min, max)` are counted
+// in the first or last bin. Requires `min < max` and `num_bins != 0`. NaN are
+// counted in an unspecified bin.
+template <class D, typename T = TFromD<D>>
+void HistogramFixed(D d, const T* HWY_RESTRICT in, const size_t num,
+                    const T min, const T max, const size_t num_bins,
+                    uint64_t* HWY_RESTRICT counts) {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Only 32/64-bit supported");
+  using TF = MakeFloat<T>;
+  HWY_DASSERT(min < max && num_bins != 0);
+  const RebindToFloat<D> df;
+  const RebindToSigned<D> di;
+  const RebindToUnsigned<D> du;
+  const Vec<decltype(df)> vmin = Set(df, ConvertScalarTo<TF>(min));
+  const Vec<decltype(df)> scale = Set(
+      df, static_cast<TF>(static_cast<double>(num_bins) /
+                          (ConvertScalarTo<double>(max) -
+                           ConvertScalarTo<double>(min))));
+  const Vec<decltype(df)> max_bin_f =
+      Set(df, ConvertScalarTo<TF>(num_bins - 1));
+  const Vec<decltype(du)> max_bin =
+      Set(du, static_cast<MakeUnsigned<T>>(num_bins - 1));
+  detail::CountBins(d, in, num, counts, [&](D /*d*/, Vec<D> v) HWY_ATTR {
+    const Vec<decltype(df)> vf = detail::ToFloat(df, v);
+    const Vec<decltype(df)> x =
+        Min(ZeroIfNegative(Mul(Sub(vf, vmin), scale)), max_bin_f);
+    // Also clamp the integer, in case `x` was NaN.
+    return Min(BitCast(du, ConvertTo(di, x)), max_bin);
+  });
+}
+
+// Log-linear bins as in HdrHistogram: bin 0 counts values less than 1,
+// including zero and negative values. Each subsequent power of two is split
+// into `1 << sub_bits` bins of equal width, hence the relative error of a
+// quantile is at most `2^-sub_bits`. Values larger than the last bin, and
+// infinities, are counted in the last bin. `num_bins != 0`, and `sub_bits`
+// must be at most the number of mantissa bits (23 for 32-bit values).
+template <class D, typename T = TFromD<D>>
+void HistogramLog(D d, const T* HWY_RESTRICT in, const size_t num,
+                  const size_t sub_bits, const size_t num_bins,
+                  uint64_t* HWY_RESTRICT counts) {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Only 32/64-bit supported");
+  using TF = MakeFloat<T>;
+  using TU = MakeUnsigned<T>;
+  HWY_DASSERT(num_bins != 0 && sub_bits <= MantissaBits<TF>());
+  const RebindToFloat<D> df;
+  const RebindToUnsigned<D> du;
+  const Vec<decltype(df)> one = Set(df, ConvertScalarTo<TF>(1));
+  const Vec<decltype(du)> one_bits = BitCast(du, one);
+  const Vec<decltype(du)> max_bin = Set(du, static_cast<TU>(num_bins - 1));
+  const int shift = static_cast<int>(MantissaBits<TF>() - sub_bits);
+  detail::CountBins(d, in, num, counts, [&](D /*d*/, Vec<D> v) HWY_ATTR {
+    const Vec<decltype(df)> vf = detail::ToFloat(df, v);
+    // For values >= 1, the difference of their bit patterns is the number of
+    // representable values above 1, which is log-linear.
+    const Vec<decltype(du)> above_one = ShiftRightSame(
+        Sub(BitCast(du, Max(vf, one)), one_bits), shift);
+    const Vec<decltype(du)> bins = IfThenElseZero(
+        RebindMask(du, Ge(vf, one)), Add(above_one, Set(du, TU{1})));
+    return Min(bins, max_bin);
+  });
+}
+
+// Returns the smallest value counted in `bin` of HistogramLog with the same
+// `sub_bits`, or zero for bin 0.
+static inline double HistogramLogLowerBound(const size_t sub_bits,
+                                            const size_t bin) {
+  if (bin == 0) return 0.0;
+  const size_t pos = bin - 1;
+  const double mantissa =
+      1.0 + static_cast<double>(pos & ((size_t{1} << sub_bits) - 1)) /
+                static_cast<double>(size_t{1} << sub_bits);
+  return std::ldexp(mantissa, static_cast<int>(pos >> sub_bits));
+}
+
+// Returns the index of the bin containing the `q`-quantile, `0 <= q <= 1`, of
+// the values counted in `counts[0, num_bins)`: the first bin at which the
+// cumulative count exceeds `q` times the total, or the last non-empty bin.
+static inline size_t HistogramQuantileBin(const uint64_t* HWY_RESTRICT counts,
+                                          const size_t num_bins,
+                                          const double q) {
+  uint64_t total = 0;
+  for (size_t bin = 0; bin < num_bins; ++bin) {
+    total += counts[bin];
+  }
+  const double rank = q * static_cast<double>(total);
+  uint64_t cumulative = 0;
+  size_t last_nonempty = 0;
+  for (size_t bin = 0; bin < num_bins; ++bin) {
+    if (counts[bin] == 0) continue;
+    cumulative += counts[bin];
+    last_nonempty = bin;
+    if (static_cast<double>(cumulative) > rank) return bin;
+  }
+  return last_nonempty;
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_ALGO_HISTOGRAM_INL_H_
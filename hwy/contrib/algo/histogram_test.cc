@@ -0,0 +1,179 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "hwy/base.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/algo/histogram_test.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/algo/histogram-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+// Random values in [-2^19, 2^19) / 64, or [0, 2^20) for unsigned T. These are
+// exactly representable in float, so the conversion does not affect the bin.
+template <typename T>
+std::vector<T> RandomValues(RandomState& rng, size_t num) {
+  std::vector<T> values(num);
+  for (T& value : values) {
+    const int64_t bits = static_cast<int64_t>(Random32(&rng) & 0xFFFFF);
+    if (IsFloat<T>()) {
+      value = ConvertScalarTo<T>(static_cast<double>(bits - 0x80000) / 64.0);
+    } else if (IsSigned<T>()) {
+      value = ConvertScalarTo<T>(bits - 0x80000);
+    } else {
+      value = ConvertScalarTo<T>(bits);
+    }
+  }
+  return values;
+}
+
+template <typename T>
+void VerifyCounts(const char* caption, size_t num,
+                  const std::vector<uint64_t>& expected,
+                  const std::vector<uint64_t>& counts) {
+  for (size_t bin = 0; bin < expected.size(); ++bin) {
+    if (expected[bin] != counts[bin]) {
+      HWY_ABORT("%s %s %s num %zu: bin %zu count %zu, expected %zu\n",
+                hwy::TargetName(HWY_TARGET), caption, TypeName(T(), 1).c_str(),
+                num, bin, static_cast<size_t>(counts[bin]),
+                static_cast<size_t>(expected[bin]));
+    }
+  }
+}
+
+struct TestHistogramFixed {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    using TF = MakeFloat<T>;
+    RandomState rng;
+    const size_t N = Lanes(d);
+    const T min = ConvertScalarTo<T>(IsSigned<T>() ? -3000 : 1000);
+    const T max = ConvertScalarTo<T>(IsFloat<T>() ? 5000 : 400000);
+    const size_t all_num[] = {0, 1, N - 1, N, 3 * N + 1, 10000};
+    for (size_t num : all_num) {
+      for (size_t num_bins : {size_t{1}, size_t{7}, size_t{100}}) {
+        const std::vector<T> values = RandomValues<T>(rng, num);
+        // Computed as in HistogramFixed, so that values at bin boundaries
+        // are rounded identically.
+        const TF scale = static_cast<TF>(
+            static_cast<double>(num_bins) /
+            (ConvertScalarTo<double>(max) - ConvertScalarTo<double>(min)));
+        std::vector<uint64_t> expected(num_bins);
+        for (const T value : values) {
+          TF x = (ConvertScalarTo<TF>(value) - ConvertScalarTo<TF>(min)) *
+                 scale;
+          x = HWY_MIN(HWY_MAX(x, TF{0}), static_cast<TF>(num_bins - 1));
+          ++expected[static_cast<size_t>(x)];
+        }
+
+        // Two calls to verify that counts are accumulated.
+        std::vector<uint64_t> counts(num_bins);
+        const size_t half = num / 2;
+        HistogramFixed(d, values.data(), half, min, max, num_bins,
+                       counts.data());
+        HistogramFixed(d, values.data() + half, num - half, min, max,
+                       num_bins, counts.data());
+        VerifyCounts<T>("Fixed", num, expected, counts);
+      }
+    }
+  }
+};
+
+void TestAllHistogramFixed() {
+  ForUIF3264(ForPartialVectors<TestHistogramFixed>());
+}
+
+struct TestHistogramLog {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    RandomState rng;
+    const size_t N = Lanes(d);
+    const size_t all_num[] = {0, 1, N - 1, N, 3 * N + 1, 10000};
+    for (size_t num : all_num) {
+      for (size_t sub_bits : {size_t{0}, size_t{3}, size_t{7}}) {
+        // Also includes values beyond the last bin.
+        const size_t num_bins = size_t{12} << sub_bits;
+        const std::vector<T> values = RandomValues<T>(rng, num);
+        std::vector<uint64_t> expected(num_bins);
+        for (const T value : values) {
+          const double x = ConvertScalarTo<double>(value);
+          size_t bin = 0;
+          while (bin + 1 < num_bins &&
+                 x >= HistogramLogLowerBound(sub_bits, bin + 1)) {
+            ++bin;
+          }
+          ++expected[bin];
+        }
+
+        std::vector<uint64_t> counts(num_bins);
+        HistogramLog(d, values.data(), num, sub_bits, num_bins, counts.data());
+        VerifyCounts<T>("Log", num, expected, counts);
+      }
+    }
+  }
+};
+
+void TestAllHistogramLog() {
+  ForUIF3264(ForPartialVectors<TestHistogramLog>());
+}
+
+void TestQuantileBin() {
+  const uint64_t counts[6] = {0, 10, 0, 80, 10, 0};
+  HWY_ASSERT_EQ(size_t{1}, HistogramQuantileBin(counts, 6, 0.0));
+  HWY_ASSERT_EQ(size_t{1}, HistogramQuantileBin(counts, 6, 0.05));
+  HWY_ASSERT_EQ(size_t{3}, HistogramQuantileBin(counts, 6, 0.1));
+  HWY_ASSERT_EQ(size_t{3}, HistogramQuantileBin(counts, 6, 0.5));
+  HWY_ASSERT_EQ(size_t{4}, HistogramQuantileBin(counts, 6, 0.95));
+  HWY_ASSERT_EQ(size_t{4}, HistogramQuantileBin(counts, 6, 1.0));
+
+  HWY_ASSERT_EQ(0.0, HistogramLogLowerBound(3, 0));
+  HWY_ASSERT_EQ(1.0, HistogramLogLowerBound(3, 1));
+  HWY_ASSERT_EQ(1.125, HistogramLogLowerBound(3, 2));
+  HWY_ASSERT_EQ(2.0, HistogramLogLowerBound(3, 9));
+  HWY_ASSERT_EQ(12.0, HistogramLogLowerBound(3, 29));
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_BEFORE_TEST(HistogramTest);
+HWY_EXPORT_AND_TEST_P(HistogramTest, TestAllHistogramFixed);
+HWY_EXPORT_AND_TEST_P(HistogramTest, TestAllHistogramLog);
+HWY_EXPORT_AND_TEST_P(HistogramTest, TestQuantileBin);
+HWY_AFTER_TEST();
+}  // namespace
+}  // namespace hwy
+HWY_TEST_MAIN();
+#endif  // HWY_ONCE
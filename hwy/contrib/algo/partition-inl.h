@@ -0,0 +1,144 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_ALGO_PARTITION_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_ALGO_PARTITION_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_ALGO_PARTITION_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_ALGO_PARTITION_INL_H_
+#endif
+
+#include <stddef.h>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"       // SortAscending
+#include "hwy/contrib/sort/vqsort-inl.h"  // Partition
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+// Adapts a predicate to the subset of the sort traits interface used by
+// Partition, which moves keys to the back if `Compare(d, pivot, v)`.
+template <class Func>
+struct PredicateTraits {
+  static constexpr size_t LanesPerKey() { return 1; }
+  static constexpr bool Is128() { return false; }
+
+  template <class D>
+  HWY_INLINE Vec<D> SetKey(D d, const TFromD<D>* /*key*/) const {
+    return Zero(d);
+  }
+
+  template <class D>
+  HWY_INLINE Mask<D> Compare(D d, Vec<D> /*pivot*/, Vec<D> v) const {
+    return Not(func(d, v));
+  }
+
+  // Same as KeyLane: keys for which `mask` is false are moved to the front.
+  template <class V, class M>
+  HWY_INLINE V CompressKeys(V keys, M mask) const {
+    return CompressNot(keys, mask);
+  }
+
+  const Func& func;
+};
+
+// Lomuto partition, one key at a time. Used for inputs too small for
+// Partition, and on targets where VQSort is disabled.
+template <class Traits, typename T>
+size_t PartitionSlow(Traits st, T* HWY_RESTRICT keys, const size_t num,
+                     const T* HWY_RESTRICT pivot_key) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const CappedTag<T, kLPK> d1;
+  const Vec<decltype(d1)> pivot = st.SetKey(d1, pivot_key);
+  size_t bound = 0;
+  for (size_t i = 0; i < num; i += kLPK) {
+    const Vec<decltype(d1)> v = LoadU(d1, keys + i);
+    if (!AllFalse(d1, st.Compare(d1, pivot, v))) continue;
+    StoreU(LoadU(d1, keys + bound), d1, keys + i);
+    StoreU(v, d1, keys + bound);
+    bound += kLPK;
+  }
+  return bound;
+}
+
+// Returns the number of lanes in the left partition, whose keys are those for
+// which `st.Compare(d, pivot, key)` is false.
+template <class D, class Traits, typename T>
+size_t PartitionKeys(D d, Traits st, T* HWY_RESTRICT keys, const size_t num,
+                     const T* HWY_RESTRICT pivot_key) {
+#if VQSORT_ENABLED || HWY_IDE
+  const size_t N = Lanes(d);
+  // Partition requires more than two vectors, and 128-bit keys require at
+  // least one whole key per vector.
+  if (HWY_LIKELY(num > 2 * N && N >= st.LanesPerKey())) {
+    HWY_ALIGN T buf[Constants::PartitionBufNum(HWY_MAX_LANES_D(D))];
+    return Partition(d, st, keys, num, st.SetKey(d, pivot_key), buf);
+  }
+#else
+  (void)d;
+#endif
+  return PartitionSlow(st, keys, num, pivot_key);
+}
+
+}  // namespace detail
+
+// Reorders `keys[0, count)` such that those for which `func(d, v)` is true
+// come first, and returns their number, like std::partition. Not stable. Uses
+// the in-place partitioning of VQSort, hence is faster than CopyIf into a
+// second array, and does not allocate.
+//
+// `func` is either a functor with a templated operator()(d, v) returning a
+// mask, or a generic lambda if using C++14. It may also be called with a tag
+// for a single lane. See CopyIf regarding HWY_ATTR.
+//
+// NOTE: this is only supported for 16-, 32- or 64-bit types.
+template <class D, class Func, typename T = TFromD<D>>
+size_t PartitionIf(D d, T* HWY_RESTRICT keys, const size_t count,
+                   const Func& func) {
+  const detail::PredicateTraits<Func> st{func};
+  return detail::PartitionKeys(d, st, keys, count,
+                               static_cast<const T*>(nullptr));
+}
+
+// Reorders `keys[0, num_keys)` such that keys before or equivalent to `pivot`
+// according to Order (SortAscending or SortDescending) come first, and returns
+// their number. This is one step of quickselect; see also VQSelect. Supports
+// the same key types as VQSortStatic, but neither the keys nor `pivot` may be
+// NaN. Not stable.
+template <typename Key, class Order>
+size_t VQPartition(Key* HWY_RESTRICT keys, const size_t num_keys,
+                   const Key& pivot, Order) {
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  const size_t num_lanes =
+      detail::PartitionKeys(d, st, reinterpret_cast<LaneType*>(keys),
+                            num_keys * st.LanesPerKey(),
+                            reinterpret_cast<const LaneType*>(&pivot));
+  return num_lanes / st.LanesPerKey();
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_ALGO_PARTITION_INL_H_
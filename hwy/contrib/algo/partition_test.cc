@@ -0,0 +1,171 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>  // std::sort
+#include <vector>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/algo/partition_test.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/algo/partition-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+// If your project requires C++14 or later, you can ignore this and pass lambdas
+// directly to PartitionIf, without requiring an lvalue as we do here for C++11.
+#if __cplusplus < 201402L
+#define HWY_GENERIC_LAMBDA 0
+#else
+#define HWY_GENERIC_LAMBDA 1
+#endif
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+#if !HWY_GENERIC_LAMBDA
+
+struct IsOdd {
+  template <class D, class V>
+  Mask<D> operator()(D d, V v) const {
+    return TestBit(v, Set(d, TFromD<D>{1}));
+  }
+};
+
+#endif  // !HWY_GENERIC_LAMBDA
+
+// Sizes around the vector length, where Partition hands over to the fallback,
+// plus larger ones that reach its main loop.
+std::vector<size_t> PartitionSizes(size_t N) {
+  return {0,         1,         N - 1,     N,    N + 1, 2 * N, 2 * N + 1,
+          3 * N + 2, 8 * N + 3, 100 * N + 7, 1000, 10000};
+}
+
+// Verifies that `keys[0, bound)` are exactly those of `original` for which
+// `is_left` is true, and the remaining keys are a permutation of the others.
+template <typename T, class IsLeft>
+void VerifyPartition(const std::vector<T>& original, std::vector<T> keys,
+                     size_t bound, const IsLeft& is_left) {
+  const char* target = hwy::TargetName(HWY_TARGET);
+  size_t expected_bound = 0;
+  for (const T& key : original) expected_bound += is_left(key);
+  if (bound != expected_bound) {
+    HWY_ABORT("%s: %s size %zu: bound %zu, expected %zu\n", target,
+              TypeName(T(), 1).c_str(), original.size(), bound,
+              expected_bound);
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (is_left(keys[i]) != (i < bound)) {
+      HWY_ABORT("%s: %s size %zu: key %zu is on the wrong side of %zu\n",
+                target, TypeName(T(), 1).c_str(), original.size(), i, bound);
+    }
+  }
+  std::vector<T> expected = original;
+  std::sort(expected.begin(), expected.end());
+  std::sort(keys.begin(), keys.end());
+  HWY_ASSERT(expected == keys);
+}
+
+struct TestPartitionIf {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    RandomState rng;
+    for (size_t num : PartitionSizes(Lanes(d))) {
+      // From all odd to none, so that all keys may be on one side.
+      for (uint32_t mask : {1u, 3u, 255u}) {
+        std::vector<T> original(num);
+        for (T& key : original) {
+          // Only odd if all bits of `mask` are set; fits in any lane type.
+          const uint32_t bits = Random32(&rng) & 127;
+          key = ConvertScalarTo<T>(((bits & mask) == mask) ? bits | 1
+                                                           : bits & ~1u);
+        }
+        std::vector<T> keys = original;
+
+#if HWY_GENERIC_LAMBDA
+        const auto is_odd = [](const auto d2, const auto v) HWY_ATTR {
+          return TestBit(v, Set(d2, TFromD<decltype(d2)>{1}));
+        };
+#else
+        const IsOdd is_odd;
+#endif
+        const size_t bound = PartitionIf(d, keys.data(), num, is_odd);
+        VerifyPartition(original, keys, bound,
+                        [](T key) { return (key & 1) != 0; });
+      }
+    }
+  }
+};
+
+void TestAllPartitionIf() {
+  ForUI163264(ForPartialVectors<TestPartitionIf>());
+}
+
+template <typename Key, class Order>
+void TestVQPartition(Order order) {
+  RandomState rng;
+  const size_t N = Lanes(ScalableTag<uint8_t>()) / sizeof(Key);
+  for (size_t num : PartitionSizes(HWY_MAX(N, size_t{1}))) {
+    // Many duplicates, including of the pivot.
+    for (uint32_t max_key : {0u, 3u, 1000u}) {
+      std::vector<Key> original(num);
+      for (Key& key : original) {
+        key = ConvertScalarTo<Key>(Random32(&rng) % (max_key + 1));
+      }
+      const Key pivot = ConvertScalarTo<Key>(max_key / 2);
+      std::vector<Key> keys = original;
+      const size_t bound = VQPartition(keys.data(), num, pivot, order);
+      VerifyPartition(original, keys, bound, [&](Key key) {
+        return Order().IsAscending() ? !(pivot < key) : !(key < pivot);
+      });
+    }
+  }
+}
+
+void TestAllVQPartition() {
+  TestVQPartition<int16_t>(SortAscending());
+  TestVQPartition<uint32_t>(SortDescending());
+  TestVQPartition<int64_t>(SortAscending());
+  TestVQPartition<float>(SortAscending());
+  TestVQPartition<double>(SortDescending());
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_BEFORE_TEST(PartitionTest);
+HWY_EXPORT_AND_TEST_P(PartitionTest, TestAllPartitionIf);
+HWY_EXPORT_AND_TEST_P(PartitionTest, TestAllVQPartition);
+HWY_AFTER_TEST();
+}  // namespace
+}  // namespace hwy
+HWY_TEST_MAIN();
+#endif  // HWY_ONCE
@@ -39,6 +39,28 @@ TA AddScalar(TA a, TB b) {
                              ConvertScalarTo<float>(b));
 }
 
+// Calls `func(chunk, worker)` for each of `num_chunks` consecutive chunks of
+// rows, each `chunk_bytes` of the matrix. Each task handles as many chunks as
+// fit in the L2, which amortizes the cost of claiming a task, but there should
+// still be several tasks per worker for load balancing.
+template <class Func>
+HWY_INLINE void RunTiled(uint64_t num_chunks, size_t chunk_bytes,
+                         hwy::ThreadPool& pool, const Func& func) {
+  const Tiles tiles = TileRange(static_cast<size_t>(num_chunks) * chunk_bytes,
+                                chunk_bytes, /*level=*/2);
+  const uint64_t max_chunks = num_chunks / (4 * pool.NumWorkers());
+  const uint64_t chunks_per_task = HWY_MAX(
+      uint64_t{1}, HWY_MIN(uint64_t{tiles.items_per_tile}, max_chunks));
+  pool.Run(0, DivCeil(num_chunks, chunks_per_task),
+           [&](const uint64_t task, size_t worker) HWY_ATTR {
+             const uint64_t first = task * chunks_per_task;
+             const uint64_t last = HWY_MIN(first + chunks_per_task, num_chunks);
+             for (uint64_t chunk = first; chunk < last; ++chunk) {
+               func(chunk, worker);
+             }
+           });
+}
+
 template <size_t kOuter, size_t kInner, typename T, bool kAdd>
 HWY_NOINLINE void MatVecAddImpl(const T* HWY_RESTRICT mat,
                                 const T* HWY_RESTRICT vec,
@@ -56,7 +78,7 @@ HWY_NOINLINE void MatVecAddImpl(const T* HWY_RESTRICT mat,
   const size_t N = Lanes(d);
   // Required for Stream loop, otherwise we might have partial vectors.
   HWY_DASSERT(kChunkSize >= N);
-  pool.Run(0, num_chunks,
+  RunTiled(num_chunks, kChunkSize * kInner * sizeof(T), pool,
            [&](const uint64_t chunk, size_t /*thread*/) HWY_ATTR {
              // MSVC workaround: duplicate to ensure constexpr.
              constexpr size_t kChunkSize = 64 / sizeof(T);
@@ -66,7 +88,7 @@ HWY_NOINLINE void MatVecAddImpl(const T* HWY_RESTRICT mat,
              HWY_ALIGN T buf[kChunkSize];
 
              // Only handle entire chunks here because the Stream is not masked.
-             // Remaining rows are handled after the pool.Run.
+             // Remaining rows are handled after RunTiled.
              const size_t begin = static_cast<size_t>(chunk * kChunkSize);
              for (size_t idx_row = 0; idx_row < kChunkSize; ++idx_row) {
                auto sum0 = Zero(d);
@@ -208,7 +230,7 @@ HWY_NOINLINE void MatVecAddImpl(const hwy::bfloat16_t* HWY_RESTRICT mat,
   const size_t N = Lanes(d);
   // Required for Stream loop, otherwise we might have partial vectors.
   HWY_DASSERT(kChunkSize2 >= N);
-  pool.Run(0, num_chunks,
+  RunTiled(num_chunks, kChunkSize2 * kInner * sizeof(bfloat16_t), pool,
            [&](const uint64_t chunk, size_t /*thread*/) HWY_ATTR {
              // MSVC workaround: duplicate to ensure constexpr.
              constexpr size_t kChunkSize = 64 / sizeof(float);
@@ -218,7 +240,7 @@ HWY_NOINLINE void MatVecAddImpl(const hwy::bfloat16_t* HWY_RESTRICT mat,
              HWY_ALIGN float buf[kChunkSize];
 
              // Only handle entire chunks here because the Stream is not masked.
-             // Remaining rows are handled after the pool.Run.
+             // Remaining rows are handled after RunTiled.
              const size_t begin = static_cast<size_t>(chunk * kChunkSize);
              for (size_t idx_row = 0; idx_row < kChunkSize; ++idx_row) {
                auto sum0 = Zero(d);
@@ -343,7 +365,7 @@ HWY_NOINLINE void MatVecAddImpl(const hwy::bfloat16_t* HWY_RESTRICT mat,
   const size_t N = Lanes(d16);
   // Required for Stream loop, otherwise we might have partial vectors.
   HWY_DASSERT(kChunkSize2 >= N);
-  pool.Run(0, num_chunks,
+  RunTiled(num_chunks, kChunkSize2 * kInner * sizeof(bfloat16_t), pool,
            [&](const uint64_t chunk, size_t /*thread*/) HWY_ATTR {
              // MSVC workaround: duplicate to ensure constexpr.
              constexpr size_t kChunkSize = 64 / sizeof(bfloat16_t);
@@ -353,7 +375,7 @@ HWY_NOINLINE void MatVecAddImpl(const hwy::bfloat16_t* HWY_RESTRICT mat,
              HWY_ALIGN float buf[kChunkSize];
 
              // Only handle entire chunks here because the Stream is not masked.
-             // Remaining rows are handled after the pool.Run.
+             // Remaining rows are handled after RunTiled.
              const size_t begin = static_cast<size_t>(chunk * kChunkSize);
              for (size_t idx_row = 0; idx_row < kChunkSize; ++idx_row) {
                auto sum0 = Zero(df);
@@ -0,0 +1,191 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>  // std::lower_bound, std::set_intersection
+#include <vector>
+
+#include "hwy/base.h"
+#include "hwy/timer.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/search/bench_search.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/search/search-inl.h"
+#include "hwy/contrib/search/set_ops-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+constexpr size_t kReps = 5;
+
+// Sorted keys without duplicates, spaced so that a random key has a
+// 1/`spacing` chance of being present.
+template <typename T>
+std::vector<T> RandomSet(RandomState& rng, size_t num, uint32_t spacing) {
+  std::vector<T> keys(num);
+  T key = 0;
+  for (T& k : keys) {
+    key = static_cast<T>(key + 1 + Random32(&rng) % (2 * spacing - 1));
+    k = key;
+  }
+  return keys;
+}
+
+template <typename T>
+void BenchSearch(size_t num_keys, size_t num_queries) {
+  using TU = MakeUnsigned<T>;
+  const ScalableTag<T> d;
+  RandomState rng;
+  const std::vector<T> keys = RandomSet<T>(rng, num_keys, 4);
+  std::vector<T> queries(num_queries);
+  for (T& q : queries) {
+    q = keys[Random64(&rng) % num_keys];
+  }
+  std::vector<TU> out(num_queries);
+  std::vector<TU> expected(num_queries);
+
+  double min_hwy = HighestValue<double>();
+  double min_std = HighestValue<double>();
+  for (size_t rep = 0; rep < kReps; ++rep) {
+    const Timestamp t0;
+    LowerBound(d, keys.data(), num_keys, queries.data(), num_queries,
+               out.data());
+    min_hwy = HWY_MIN(min_hwy, SecondsSince(t0));
+
+    const Timestamp t1;
+    for (size_t i = 0; i < num_queries; ++i) {
+      expected[i] = static_cast<TU>(
+          std::lower_bound(keys.begin(), keys.end(), queries[i]) -
+          keys.begin());
+    }
+    min_std = HWY_MIN(min_std, SecondsSince(t1));
+    HWY_ASSERT(out == expected);
+  }
+
+  const double queries_per_us = static_cast<double>(num_queries) * 1E-6;
+  fprintf(stderr,
+          "%s: LowerBound %s %8zu keys: %7.2f M/s (std::lower_bound %7.2f)\n",
+          hwy::TargetName(HWY_TARGET), TypeName(T(), 1).c_str(), num_keys,
+          queries_per_us / min_hwy, queries_per_us / min_std);
+}
+
+template <typename T>
+void BenchSetOps(size_t num, uint32_t spacing) {
+  const ScalableTag<T> d;
+  RandomState rng;
+  const std::vector<T> a = RandomSet<T>(rng, num, spacing);
+  const std::vector<T> b = RandomSet<T>(rng, num, spacing);
+  std::vector<T> out(2 * num);
+  std::vector<T> expected(2 * num);
+
+  double min_hwy[3];
+  double min_std[3];
+  for (size_t op = 0; op < 3; ++op) {
+    min_hwy[op] = min_std[op] = HighestValue<double>();
+  }
+  for (size_t rep = 0; rep < kReps; ++rep) {
+    for (size_t op = 0; op < 3; ++op) {
+      const Timestamp t0;
+      size_t num_out;
+      if (op == 0) {
+        num_out = Intersect(d, a.data(), num, b.data(), num, out.data());
+      } else if (op == 1) {
+        num_out = Union(d, a.data(), num, b.data(), num, out.data());
+      } else {
+        num_out = Difference(d, a.data(), num, b.data(), num, out.data());
+      }
+      min_hwy[op] = HWY_MIN(min_hwy[op], SecondsSince(t0));
+
+      const Timestamp t1;
+      T* end;
+      if (op == 0) {
+        end = std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                                    expected.data());
+      } else if (op == 1) {
+        end = std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                             expected.data());
+      } else {
+        end = std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                  expected.data());
+      }
+      min_std[op] = HWY_MIN(min_std[op], SecondsSince(t1));
+      HWY_ASSERT(num_out == static_cast<size_t>(end - expected.data()));
+      HWY_ASSERT(std::equal(expected.data(), end, out.data()));
+    }
+  }
+
+  const char* names[3] = {"Intersect", "Union", "Difference"};
+  const double keys_per_us = static_cast<double>(2 * num) * 1E-6;
+  for (size_t op = 0; op < 3; ++op) {
+    fprintf(stderr,
+            "%s: %-10s %s %8zu keys, 1/%u match: %7.1f M/s (std: %7.1f)\n",
+            hwy::TargetName(HWY_TARGET), names[op], TypeName(T(), 1).c_str(),
+            num, spacing, keys_per_us / min_hwy[op],
+            keys_per_us / min_std[op]);
+  }
+}
+
+HWY_NOINLINE void BenchAllSearch() {
+  // Not interested in benchmark results for these targets.
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+
+  const size_t num_queries = AdjustedReps(size_t{1} << 20);
+  for (size_t num_keys : {size_t{1} << 10, size_t{1} << 16, size_t{1} << 22}) {
+    BenchSearch<uint32_t>(AdjustedReps(num_keys), num_queries);
+    BenchSearch<uint64_t>(AdjustedReps(num_keys), num_queries);
+  }
+}
+
+HWY_NOINLINE void BenchAllSetOps() {
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+
+  const size_t num = AdjustedReps(size_t{1} << 20);
+  for (uint32_t spacing : {1u, 4u, 32u}) {
+    BenchSetOps<uint32_t>(num, spacing);
+    BenchSetOps<uint64_t>(num, spacing);
+  }
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_BEFORE_TEST(BenchSearch);
+HWY_EXPORT_AND_TEST_P(BenchSearch, BenchAllSearch);
+HWY_EXPORT_AND_TEST_P(BenchSearch, BenchAllSetOps);
+HWY_AFTER_TEST();
+}  // namespace
+}  // namespace hwy
+HWY_TEST_MAIN();
+#endif  // HWY_ONCE
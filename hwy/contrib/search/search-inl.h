@@ -0,0 +1,127 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_SEARCH_SEARCH_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_SEARCH_SEARCH_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_SEARCH_SEARCH_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_SEARCH_SEARCH_INL_H_
+#endif
+
+#include <stddef.h>
+
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+// Branchless binary search for a vector of queries, one per lane, as in Khuong
+// and Morin, "Array Layouts for Comparison-Based Searching". All lanes execute
+// the same number of steps, so there are no mispredictions, and their gathers
+// are independent, which hides much of the memory latency. `is_after(k, q)`
+// returns whether the result is after key `k` for query `q`.
+template <class D, class IsAfter, typename T = TFromD<D>>
+HWY_INLINE Vec<RebindToSigned<D>> SearchLanes(D d, const T* HWY_RESTRICT keys,
+                                              const size_t num_keys,
+                                              const Vec<D> queries,
+                                              const IsAfter& is_after) {
+  const RebindToSigned<D> di;
+  using TI = TFromD<decltype(di)>;
+  using VI = Vec<decltype(di)>;
+  VI base = Zero(di);
+  size_t num = num_keys;
+  while (num > 1) {
+    const size_t half = num / 2;
+    const VI vhalf = Set(di, static_cast<TI>(half));
+    const Vec<D> k = GatherIndex(d, keys, Add(base, vhalf));
+    base = MaskedAddOr(base, RebindMask(di, is_after(k, queries)), base, vhalf);
+    num -= half;
+  }
+  const Vec<D> k = GatherIndex(d, keys, base);
+  return MaskedAddOr(base, RebindMask(di, is_after(k, queries)), base,
+                     Set(di, TI{1}));
+}
+
+// Calls SearchLanes for each vector of queries and stores the results.
+template <class D, class IsAfter, typename T = TFromD<D>>
+HWY_INLINE void SearchBatch(D d, const T* HWY_RESTRICT keys,
+                            const size_t num_keys,
+                            const T* HWY_RESTRICT queries,
+                            const size_t num_queries,
+                            MakeUnsigned<T>* HWY_RESTRICT out,
+                            const IsAfter& is_after) {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Gather requires 32/64-bit");
+  HWY_DASSERT(num_keys <= static_cast<size_t>(LimitsMax<MakeSigned<T>>()));
+  const RebindToUnsigned<D> du;
+  const size_t N = Lanes(d);
+  if (HWY_UNLIKELY(num_keys == 0)) {
+    ZeroBytes(out, num_queries * sizeof(MakeUnsigned<T>));
+    return;
+  }
+
+  size_t i = 0;
+  if (num_queries >= N) {
+    for (; i <= num_queries - N; i += N) {
+      const Vec<D> q = LoadU(d, queries + i);
+      StoreU(BitCast(du, SearchLanes(d, keys, num_keys, q, is_after)), du,
+             out + i);
+    }
+  }
+  const size_t remaining = num_queries - i;
+  if (remaining != 0) {
+    const Vec<D> q = LoadN(d, queries + i, remaining);
+    StoreN(BitCast(du, SearchLanes(d, keys, num_keys, q, is_after)), du,
+           out + i, remaining);
+  }
+}
+
+}  // namespace detail
+
+// Batched std::lower_bound: for each `queries[i]`, writes to `out[i]` the index
+// of the first of the sorted (ascending) `keys[0, num_keys)` that is not less
+// than the query, or `num_keys` if there is none. T is a 32 or 64-bit integer
+// or floating-point type (not NaN); `num_keys` must not exceed the largest
+// signed value of that size. Queries need not be sorted, but the search is
+// faster if consecutive queries access the same keys, which then remain in
+// cache.
+template <class D, typename T = TFromD<D>>
+void LowerBound(D d, const T* HWY_RESTRICT keys, const size_t num_keys,
+                const T* HWY_RESTRICT queries, const size_t num_queries,
+                MakeUnsigned<T>* HWY_RESTRICT out) {
+  detail::SearchBatch(d, keys, num_keys, queries, num_queries, out,
+                      [](const Vec<D> k, const Vec<D> q)
+                          HWY_ATTR { return Lt(k, q); });
+}
+
+// As above, but for std::upper_bound: the first key greater than the query.
+template <class D, typename T = TFromD<D>>
+void UpperBound(D d, const T* HWY_RESTRICT keys, const size_t num_keys,
+                const T* HWY_RESTRICT queries, const size_t num_queries,
+                MakeUnsigned<T>* HWY_RESTRICT out) {
+  detail::SearchBatch(d, keys, num_keys, queries, num_queries, out,
+                      [](const Vec<D> k, const Vec<D> q)
+                          HWY_ATTR { return Le(k, q); });
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SEARCH_SEARCH_INL_H_
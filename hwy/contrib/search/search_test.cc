@@ -0,0 +1,194 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <algorithm>  // std::lower_bound, std::set_intersection
+#include <iterator>   // std::back_inserter
+#include <vector>
+
+#include "hwy/base.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/search/search_test.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/search/search-inl.h"
+#include "hwy/contrib/search/set_ops-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+// Sorted keys in [0, max_key], possibly with duplicates.
+template <typename T>
+std::vector<T> SortedKeys(RandomState& rng, size_t num, uint32_t max_key) {
+  std::vector<T> keys(num);
+  for (T& key : keys) {
+    key = ConvertScalarTo<T>(Random32(&rng) % (max_key + 1));
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+struct TestLowerUpperBound {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    using TU = MakeUnsigned<T>;
+    RandomState rng;
+    const size_t N = Lanes(d);
+    const size_t all_num_keys[] = {0, 1, 2, 3, 7, 16, 100, 1000};
+    for (size_t num_keys : all_num_keys) {
+      // Duplicate keys, and queries before, between and after the keys.
+      const uint32_t max_key = static_cast<uint32_t>(num_keys);
+      const std::vector<T> keys = SortedKeys<T>(rng, num_keys, max_key);
+      for (size_t num_queries : {size_t{0}, size_t{1}, N - 1, N, 3 * N + 1}) {
+        std::vector<T> queries(num_queries);
+        for (T& q : queries) {
+          q = ConvertScalarTo<T>(Random32(&rng) % (max_key + 3));
+        }
+        std::vector<TU> lower(num_queries + 1, TU{0x55});
+        std::vector<TU> upper(num_queries + 1, TU{0x55});
+        LowerBound(d, keys.data(), num_keys, queries.data(), num_queries,
+                   lower.data());
+        UpperBound(d, keys.data(), num_keys, queries.data(), num_queries,
+                   upper.data());
+
+        for (size_t i = 0; i < num_queries; ++i) {
+          const size_t expected_lower = static_cast<size_t>(
+              std::lower_bound(keys.begin(), keys.end(), queries[i]) -
+              keys.begin());
+          const size_t expected_upper = static_cast<size_t>(
+              std::upper_bound(keys.begin(), keys.end(), queries[i]) -
+              keys.begin());
+          if (lower[i] != expected_lower || upper[i] != expected_upper) {
+            fprintf(stderr,
+                    "%s keys %zu queries %zu: i %zu lower %zu (expected %zu) "
+                    "upper %zu (expected %zu)\n",
+                    TypeName(T(), N).c_str(), num_keys, num_queries, i,
+                    static_cast<size_t>(lower[i]), expected_lower,
+                    static_cast<size_t>(upper[i]), expected_upper);
+            HWY_ASSERT(false);
+          }
+        }
+        // Must not write past the end.
+        HWY_ASSERT_EQ(TU{0x55}, lower[num_queries]);
+        HWY_ASSERT_EQ(TU{0x55}, upper[num_queries]);
+      }
+    }
+  }
+};
+
+void TestAllLowerUpperBound() {
+  ForUIF3264(ForPartialVectors<TestLowerUpperBound>());
+}
+
+// Sorted keys in [0, max_key] without duplicates.
+template <typename T>
+std::vector<T> SortedSet(RandomState& rng, size_t num, uint32_t max_key) {
+  std::vector<T> keys = SortedKeys<T>(rng, num, max_key);
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  return keys;
+}
+
+template <typename T>
+void VerifySetOp(const char* caption, const std::vector<T>& expected,
+                 const std::vector<T>& actual, size_t num_actual) {
+  if (num_actual != expected.size() ||
+      !std::equal(expected.begin(), expected.end(), actual.begin())) {
+    fprintf(stderr, "%s %s: expected %zu keys, got %zu\n", caption,
+            TypeName(T(), 1).c_str(), expected.size(), num_actual);
+    HWY_ASSERT(false);
+  }
+}
+
+struct TestSetOps {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    RandomState rng;
+    const size_t N = Lanes(d);
+    const size_t sizes[] = {0, 1, N - 1, N, N + 1, 5 * N + 3, 1000};
+    for (size_t size_a : sizes) {
+      for (size_t size_b : sizes) {
+        // Dense ranges have many matches, sparse ones few.
+        for (uint32_t max_key : {static_cast<uint32_t>(size_a + size_b),
+                                 static_cast<uint32_t>(20 * (size_a + 1))}) {
+          const std::vector<T> a = SortedSet<T>(rng, size_a, max_key);
+          const std::vector<T> b = SortedSet<T>(rng, size_b, max_key);
+          Check(d, a, b);
+        }
+      }
+    }
+    // Identical and disjoint inputs.
+    const std::vector<T> a = SortedSet<T>(rng, 300, 400);
+    Check(d, a, a);
+    std::vector<T> b = a;
+    for (T& key : b) key = static_cast<T>(key + 1000);
+    Check(d, a, b);
+    Check(d, b, a);
+  }
+
+  template <class D, typename T>
+  static void Check(D d, const std::vector<T>& a, const std::vector<T>& b) {
+    std::vector<T> expected;
+    // Output sized exactly as documented, so ASAN detects overruns.
+    std::vector<T> out(HWY_MIN(a.size(), b.size()));
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(expected));
+    VerifySetOp("Intersect", expected, out,
+                Intersect(d, a.data(), a.size(), b.data(), b.size(),
+                          out.data()));
+
+    expected.clear();
+    out.resize(a.size());
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected));
+    VerifySetOp("Difference", expected, out,
+                Difference(d, a.data(), a.size(), b.data(), b.size(),
+                           out.data()));
+
+    expected.clear();
+    out.resize(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(expected));
+    VerifySetOp("Union", expected, out,
+                Union(d, a.data(), a.size(), b.data(), b.size(), out.data()));
+  }
+};
+
+void TestAllSetOps() { ForUI3264(ForPartialVectors<TestSetOps>()); }
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_BEFORE_TEST(SearchTest);
+HWY_EXPORT_AND_TEST_P(SearchTest, TestAllLowerUpperBound);
+HWY_EXPORT_AND_TEST_P(SearchTest, TestAllSetOps);
+HWY_AFTER_TEST();
+}  // namespace
+}  // namespace hwy
+HWY_TEST_MAIN();
+#endif  // HWY_ONCE
@@ -0,0 +1,202 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_SEARCH_SET_OPS_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_SEARCH_SET_OPS_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_SEARCH_SET_OPS_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_SEARCH_SET_OPS_INL_H_
+#endif
+
+#include <stddef.h>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"        // SortAscending
+#include "hwy/contrib/sort/vqmerge-inl.h"  // VQMergeStatic
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Set operations on sorted (ascending) arrays of 32 or 64-bit integers without
+// duplicates, as with std::set_intersection etc. Each returns the number of
+// keys written to `out`, which must not overlap the inputs.
+
+namespace detail {
+
+// Returns the mask of lanes of `va` equal to any of the N keys at `b`. This
+// all-pairs comparison of a block of each input requires no data-dependent
+// branches, as in Schlegel et al., "Fast Sorted-Set Intersection using SIMD
+// Instructions". Broadcasting each key of `b` is a single instruction on x86.
+template <class D, typename T = TFromD<D>>
+HWY_INLINE Mask<D> MatchBlock(D d, const Vec<D> va, const T* HWY_RESTRICT b) {
+  const size_t N = Lanes(d);
+  Mask<D> match = Eq(va, Set(d, b[0]));
+  for (size_t k = 1; k < N; ++k) {
+    match = Or(match, Eq(va, Set(d, b[k])));
+  }
+  return match;
+}
+
+template <typename T>
+size_t IntersectScalar(const T* HWY_RESTRICT a, size_t num_a,
+                       const T* HWY_RESTRICT b, size_t num_b,
+                       T* HWY_RESTRICT out) {
+  size_t num_out = 0;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < num_a && j < num_b) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      out[num_out++] = a[i];
+      ++i;
+      ++j;
+    }
+  }
+  return num_out;
+}
+
+// Also advances `j`, the position in `b`, so that callers can continue with
+// subsequent keys of `a`.
+template <typename T>
+size_t DifferenceScalar(const T* HWY_RESTRICT a, size_t num_a,
+                        const T* HWY_RESTRICT b, size_t num_b, size_t& j,
+                        T* HWY_RESTRICT out) {
+  size_t num_out = 0;
+  for (size_t i = 0; i < num_a; ++i) {
+    while (j < num_b && b[j] < a[i]) ++j;
+    if (j == num_b || a[i] != b[j]) out[num_out++] = a[i];
+  }
+  return num_out;
+}
+
+}  // namespace detail
+
+// Writes the keys of `a` that are also in `b`. `out` must have space for
+// HWY_MIN(num_a, num_b) keys.
+template <class D, typename T = TFromD<D>>
+size_t Intersect(D d, const T* HWY_RESTRICT a, const size_t num_a,
+                 const T* HWY_RESTRICT b, const size_t num_b,
+                 T* HWY_RESTRICT out) {
+  static_assert(IsInteger<T>() && (sizeof(T) == 4 || sizeof(T) == 8), "");
+  const size_t N = Lanes(d);
+  size_t num_out = 0;
+  size_t i = 0;
+  size_t j = 0;
+  while (i + N <= num_a && j + N <= num_b) {
+    const Vec<D> va = LoadU(d, a + i);
+    const Mask<D> match = detail::MatchBlock(d, va, b + j);
+    // Only writes the matching keys, hence `out` need not be padded.
+    num_out += CompressBlendedStore(va, match, d, out + num_out);
+    // Advance whichever block ends first, or both if they end with the same
+    // key. Keys of the other block may still match the next block.
+    const T last_a = a[i + N - 1];
+    const T last_b = b[j + N - 1];
+    i += (last_a <= last_b) ? N : 0;
+    j += (last_b <= last_a) ? N : 0;
+  }
+  return num_out + detail::IntersectScalar(a + i, num_a - i, b + j, num_b - j,
+                                           out + num_out);
+}
+
+// Writes the keys of `a` that are not in `b`. `out` must have space for
+// `num_a` keys.
+template <class D, typename T = TFromD<D>>
+size_t Difference(D d, const T* HWY_RESTRICT a, const size_t num_a,
+                  const T* HWY_RESTRICT b, const size_t num_b,
+                  T* HWY_RESTRICT out) {
+  static_assert(IsInteger<T>() && (sizeof(T) == 4 || sizeof(T) == 8), "");
+  const size_t N = Lanes(d);
+  size_t num_out = 0;
+  size_t i = 0;
+  size_t j = 0;
+  // Lanes of the current block of `a` that matched any previous block of `b`.
+  Mask<D> matched = MaskFalse(d);
+  while (i + N <= num_a && j + N <= num_b) {
+    const Vec<D> va = LoadU(d, a + i);
+    matched = Or(matched, detail::MatchBlock(d, va, b + j));
+    const T last_a = a[i + N - 1];
+    const T last_b = b[j + N - 1];
+    // Subsequent blocks of `b` cannot match this block of `a`.
+    if (last_a <= last_b) {
+      num_out += CompressBlendedStore(va, Not(matched), d, out + num_out);
+      matched = MaskFalse(d);
+      i += N;
+    }
+    j += (last_b <= last_a) ? N : 0;
+  }
+
+  // The remaining keys of a partially matched block of `a` may still match
+  // the remaining keys of `b`.
+  if (i + N <= num_a) {
+    HWY_ALIGN T unmatched[HWY_MAX_LANES_D(D)];
+    const size_t num_unmatched =
+        CompressStore(LoadU(d, a + i), Not(matched), d, unmatched);
+    num_out += detail::DifferenceScalar(unmatched, num_unmatched, b, num_b, j,
+                                        out + num_out);
+    i += N;
+  }
+  return num_out + detail::DifferenceScalar(a + i, num_a - i, b, num_b, j,
+                                            out + num_out);
+}
+
+// Writes the keys that are in either `a` or `b`. `out` must have space for
+// `num_a + num_b` keys. Uses the vectorized merge of VQMerge, then removes
+// the duplicates, of which there are at most two of each key.
+template <class D, typename T = TFromD<D>>
+size_t Union(D d, const T* HWY_RESTRICT a, const size_t num_a,
+             const T* HWY_RESTRICT b, const size_t num_b,
+             T* HWY_RESTRICT out) {
+  static_assert(IsInteger<T>() && (sizeof(T) == 4 || sizeof(T) == 8), "");
+  const size_t num = num_a + num_b;
+  if (num == 0) return 0;
+  VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+
+  // In-place compaction: writes at `num_out` never exceed the current read
+  // position, but may overwrite keys before it. Hence the preceding key is
+  // taken from a register, not reloaded.
+  const size_t N = Lanes(d);
+  size_t num_out = 1;
+  T prev_key = out[0];
+  size_t i = 1;
+  if (num >= N + 1) {
+    for (; i <= num - N; i += N) {
+      const Vec<D> v = LoadU(d, out + i);
+      const Vec<D> prev =
+          IfThenElse(FirstN(d, 1), Set(d, prev_key), Slide1Up(d, v));
+      prev_key = out[i + N - 1];
+      num_out += CompressBlendedStore(v, Ne(v, prev), d, out + num_out);
+    }
+  }
+  for (; i < num; ++i) {
+    const T key = out[i];
+    if (key != prev_key) out[num_out++] = key;
+    prev_key = key;
+  }
+  return num_out;
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SEARCH_SET_OPS_INL_H_
@@ -22,9 +22,14 @@
 
 #include <algorithm>  // std::sort
 #include <functional>  // std::less, std::greater
+#include <memory>      // std::unique_ptr
 #include <vector>
 
+#include "hwy/contrib/sort/vqradix.h"
 #include "hwy/contrib/sort/vqsort.h"
+#include "hwy/contrib/sort/vqsort_parallel.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/contrib/thread_pool/topology.h"
 #include "hwy/highway.h"
 #include "hwy/print.h"
 
@@ -105,13 +110,28 @@ HWY_POP_ATTRIBUTES
 
 namespace hwy {
 
-enum class Dist { kUniform8, kUniform16, kUniform32 };
+// The presorted distributions are uniform32 with ascending lanes, descending
+// lanes, ascending runs of kSawtoothLanes, and eight ascending runs.
+enum class Dist {
+  kUniform8,
+  kUniform16,
+  kUniform32,
+  kSorted,
+  kReversed,
+  kSawtooth,
+  kFewRuns
+};
 
 static inline std::vector<Dist> AllDist() {
   // Also include lower-entropy distributions to test MaybePartitionTwoValue.
   return {Dist::kUniform8, /*Dist::kUniform16,*/ Dist::kUniform32};
 }
 
+// Inputs that are (partially) sorted already, e.g. timestamps.
+static inline std::vector<Dist> PresortedDist() {
+  return {Dist::kSorted, Dist::kReversed, Dist::kSawtooth, Dist::kFewRuns};
+}
+
 static inline const char* DistName(Dist dist) {
   switch (dist) {
     case Dist::kUniform8:
@@ -120,6 +140,14 @@ static inline const char* DistName(Dist dist) {
       return "uniform16";
     case Dist::kUniform32:
       return "uniform32";
+    case Dist::kSorted:
+      return "sorted";
+    case Dist::kReversed:
+      return "reversed";
+    case Dist::kSawtooth:
+      return "sawtooth";
+    case Dist::kFewRuns:
+      return "few_runs";
   }
   return "unreachable";
 }
@@ -201,6 +229,8 @@ enum class Algo {
   kVQSort,
   kVQPartialSort,
   kVQSelect,
+  kVQSortParallel,
+  kVQRadix,
   kHeapSort,
   kHeapPartialSort,
   kHeapSelect,
@@ -211,6 +241,7 @@ static inline bool IsVQ(Algo algo) {
     case Algo::kVQSort:
     case Algo::kVQPartialSort:
     case Algo::kVQSelect:
+    case Algo::kVQSortParallel:
       return true;
     default:
       return false;
@@ -290,6 +321,10 @@ static inline const char* AlgoName(Algo algo) {
       return "vq_partial";
     case Algo::kVQSelect:
       return "vq_select";
+    case Algo::kVQSortParallel:
+      return "vq_par";
+    case Algo::kVQRadix:
+      return "vq_radix";
     case Algo::kHeapSort:
       return "heap";
     case Algo::kHeapPartialSort:
@@ -450,6 +485,22 @@ InputStats<T> GenerateInput(const Dist dist, T* v, size_t num_lanes) {
     CopyBytes(buf.get(), v + i, (num_lanes - i) * sizeof(T));
   }
 
+  // Presorted: sort runs of lanes. For 128-bit keys, keys within a run are
+  // then also sorted, because the upper lane is the more significant.
+  constexpr size_t kSawtoothLanes = 1024;
+  const size_t run_lanes =
+      (dist == Dist::kSawtooth)  ? kSawtoothLanes
+      : (dist == Dist::kFewRuns) ? HWY_MAX(num_lanes / 8, size_t{1})
+                                 : num_lanes;
+  if (dist == Dist::kReversed) {
+    std::sort(v, v + num_lanes, std::greater<T>());
+  } else if (dist == Dist::kSorted || dist == Dist::kSawtooth ||
+             dist == Dist::kFewRuns) {
+    for (size_t begin = 0; begin < num_lanes; begin += run_lanes) {
+      std::sort(v + begin, v + HWY_MIN(begin + run_lanes, num_lanes));
+    }
+  }
+
   InputStats<T> input_stats;
   for (size_t i = 0; i < num_lanes; ++i) {
     input_stats.Notify(v[i]);
@@ -463,6 +514,20 @@ struct SharedState {
   ips4o::StdThreadPool pool{static_cast<int>(
       HWY_MIN(max_threads, std::thread::hardware_concurrency() / 2))};
 #endif
+
+  // For Algo::kVQSortParallel. Created on first use because most callers only
+  // run single-threaded algorithms. At least three threads so that tests also
+  // cover the parallel code path on machines with few cores.
+  hwy::ThreadPool& VQPool() {
+    if (!vq_pool) {
+      const size_t num_threads =
+          HWY_MAX(hwy::ThreadPool::MaxThreads(), size_t{3});
+      vq_pool.reset(
+          new hwy::ThreadPool(hwy::HaveThreadingSupport() ? num_threads : 0));
+    }
+    return *vq_pool;
+  }
+  std::unique_ptr<hwy::ThreadPool> vq_pool;
 };
 
 // Adapters from Run's num_keys to vqsort-inl.h num_lanes.
@@ -499,10 +564,6 @@ void Run(Algo algo, KeyType* inout, size_t num_keys, SharedState& shared,
 
   constexpr bool kAscending = Order::IsAscending();
 
-#if !HAVE_PARALLEL_IPS4O
-  (void)shared;
-#endif
-
   switch (algo) {
 #if HAVE_INTEL && HWY_TARGET <= HWY_AVX3
     case Algo::kIntel:
@@ -599,6 +660,10 @@ void Run(Algo algo, KeyType* inout, size_t num_keys, SharedState& shared,
       return VQPartialSort(inout, num_keys, k_keys, Order());
     case Algo::kVQSelect:
       return VQSelect(inout, num_keys, k_keys, Order());
+    case Algo::kVQSortParallel:
+      return VQSortParallel(inout, num_keys, Order(), shared.VQPool());
+    case Algo::kVQRadix:
+      return VQRadixSort(inout, num_keys, Order());
 
     case Algo::kHeapSort:
       return CallHeapSort(inout, num_keys, Order());
@@ -14,19 +14,16 @@
 // limitations under the License.
 
 // Concurrent, independent sorts for generating more memory traffic and testing
-// scalability when bandwidth-limited. If you want to use multiple threads for
-// a single sort, you can use ips4o and integrate vqsort by calling it from
-// `baseCaseSort` and increasing `IPS4OML_BASE_CASE_SIZE` to say 8192.
+// scalability when bandwidth-limited, plus a single multi-threaded sort via
+// VQSortParallel, compared with ips4o's parallel sort if available.
 
 #include <stdint.h>
 #include <stdio.h>
 
-#include <condition_variable>  //NOLINT
-#include <functional>
-#include <mutex>   //NOLINT
-#include <thread>  //NOLINT
 #include <vector>
 
+#include "hwy/contrib/sort/vqsort_parallel.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
 #include "hwy/timer.h"
 
 // clang-format off
@@ -47,126 +44,12 @@ namespace hwy {
 namespace HWY_NAMESPACE {
 namespace {
 
-class ThreadPool {
- public:
-  // Starts the given number of worker threads and blocks until they are ready.
-  explicit ThreadPool(
-      const size_t num_threads = std::thread::hardware_concurrency())
-      : num_threads_(num_threads) {
-    HWY_ASSERT(num_threads_ > 0);
-    threads_.reserve(num_threads_);
-    for (size_t i = 0; i < num_threads_; ++i) {
-      threads_.emplace_back(ThreadFunc, this, i);
-    }
-
-    WorkersReadyBarrier();
-  }
-
-  ThreadPool(const ThreadPool&) = delete;
-  ThreadPool& operator&(const ThreadPool&) = delete;
-
-  // Waits for all threads to exit.
-  ~ThreadPool() {
-    StartWorkers(kWorkerExit);
-
-    for (std::thread& thread : threads_) {
-      thread.join();
-    }
-  }
-
-  size_t NumThreads() const { return threads_.size(); }
-
-  template <class Func>
-  void RunOnThreads(size_t max_threads, const Func& func) {
-    task_ = &CallClosure<Func>;
-    data_ = &func;
-    StartWorkers(max_threads);
-    WorkersReadyBarrier();
-  }
-
- private:
-  // After construction and between calls to Run, workers are "ready", i.e.
-  // waiting on worker_start_cv_. They are "started" by sending a "command"
-  // and notifying all worker_start_cv_ waiters. (That is why all workers
-  // must be ready/waiting - otherwise, the notification will not reach all of
-  // them and the main thread waits in vain for them to report readiness.)
-  using WorkerCommand = uint64_t;
-
-  static constexpr WorkerCommand kWorkerWait = ~1ULL;
-  static constexpr WorkerCommand kWorkerExit = ~2ULL;
-
-  // Calls a closure (lambda with captures).
-  template <class Closure>
-  static void CallClosure(const void* f, size_t thread) {
-    (*reinterpret_cast<const Closure*>(f))(thread);
-  }
-
-  void WorkersReadyBarrier() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    // Typically only a single iteration.
-    while (workers_ready_ != threads_.size()) {
-      workers_ready_cv_.wait(lock);
-    }
-    workers_ready_ = 0;
-
-    // Safely handle spurious worker wakeups.
-    worker_start_command_ = kWorkerWait;
-  }
-
-  // Precondition: all workers are ready.
-  void StartWorkers(const WorkerCommand worker_command) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    worker_start_command_ = worker_command;
-    // Workers will need this lock, so release it before they wake up.
-    lock.unlock();
-    worker_start_cv_.notify_all();
-  }
-
-  static void ThreadFunc(ThreadPool* self, size_t thread) {
-    // Until kWorkerExit command received:
-    for (;;) {
-      std::unique_lock<std::mutex> lock(self->mutex_);
-      // Notify main thread that this thread is ready.
-      if (++self->workers_ready_ == self->num_threads_) {
-        self->workers_ready_cv_.notify_one();
-      }
-    RESUME_WAIT:
-      // Wait for a command.
-      self->worker_start_cv_.wait(lock);
-      const WorkerCommand command = self->worker_start_command_;
-      switch (command) {
-        case kWorkerWait:    // spurious wakeup:
-          goto RESUME_WAIT;  // lock still held, avoid incrementing ready.
-        case kWorkerExit:
-          return;  // exits thread
-        default:
-          break;
-      }
-
-      lock.unlock();
-      // Command is the maximum number of threads that should run the task.
-      HWY_ASSERT(command < self->NumThreads());
-      if (thread < command) {
-        self->task_(self->data_, thread);
-      }
-    }
-  }
-
-  const size_t num_threads_;
-
-  // Unmodified after ctor, but cannot be const because we call thread::join().
-  std::vector<std::thread> threads_;
-
-  std::mutex mutex_;  // guards both cv and their variables.
-  std::condition_variable workers_ready_cv_;
-  size_t workers_ready_ = 0;
-  std::condition_variable worker_start_cv_;
-  WorkerCommand worker_start_command_;
-
-  // Written by main thread, read by workers (after mutex lock/unlock).
-  std::function<void(const void*, size_t)> task_;  // points to CallClosure
-  const void* data_;                               // points to caller's Func
-};
+// Not interested in benchmark results for other targets on x86.
+bool SkipTarget() {
+  return HWY_ARCH_X86 &&
+         (HWY_TARGET != HWY_AVX2 && HWY_TARGET != HWY_AVX3 &&
+          HWY_TARGET != HWY_AVX3_ZEN4 && HWY_TARGET != HWY_AVX3_SPR);
+}
 
 template <class Traits>
 void RunWithoutVerify(Traits st, const Dist dist, const size_t num_keys,
@@ -186,15 +69,10 @@ void RunWithoutVerify(Traits st, const Dist dist, const size_t num_keys,
 }
 
 void BenchParallel() {
-  // Not interested in benchmark results for other targets on x86
-  if (HWY_ARCH_X86 &&
-      (HWY_TARGET != HWY_AVX2 && HWY_TARGET != HWY_AVX3 &&
-       HWY_TARGET != HWY_AVX3_ZEN4 && HWY_TARGET != HWY_AVX3_SPR)) {
-    return;
-  }
+  if (SkipTarget()) return;
 
-  ThreadPool pool;
-  const size_t NT = pool.NumThreads();
+  ThreadPool pool(HaveThreadingSupport() ? ThreadPool::MaxThreads() : 0);
+  const size_t NW = pool.NumWorkers();
 
   detail::SharedTraits<detail::TraitsLane<detail::OrderAscending<int64_t>>> st;
   using KeyType = typename decltype(st)::KeyType;
@@ -210,19 +88,81 @@ void BenchParallel() {
   SharedState shared;
 
   std::vector<SortResult> results;
-  for (size_t nt = 1; nt < NT; nt += HWY_MAX(1, NT / 16)) {
+  for (size_t nw = 1; nw <= NW; nw += HWY_MAX(1, NW / 16)) {
     Timestamp t0;
-    // Default capture because MSVC wants algo/dist but clang does not.
-    pool.RunOnThreads(nt, [=, &shared](size_t thread) {
-      RunWithoutVerify(st, dist, num_keys, algo, shared, thread);
+    // One task per concurrent sort. Default capture because MSVC wants
+    // algo/dist but clang does not.
+    pool.Run(0, nw, [=, &shared](uint64_t task, size_t /*worker*/) {
+      RunWithoutVerify(st, dist, num_keys, algo, shared,
+                       static_cast<size_t>(task));
     });
     const double sec = SecondsSince(t0);
-    results.emplace_back(algo, dist, num_keys, nt, sec, sizeof(KeyType),
+    results.emplace_back(algo, dist, num_keys, nw, sec, sizeof(KeyType),
                          st.KeyString());
     results.back().Print();
   }
 }
 
+// A single sort using all threads.
+template <class Traits>
+void BenchParallelSort(Traits st, size_t num_keys) {
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  using Order = typename Traits::Order;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  auto aligned = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(aligned);
+
+  SharedState shared;
+  const size_t num_workers = shared.VQPool().NumWorkers();
+
+  std::vector<Algo> algos;
+#if HAVE_PARALLEL_IPS4O
+  algos.push_back(Algo::kParallelIPS4O);
+#endif
+  algos.push_back(Algo::kVQSortParallel);
+  algos.push_back(Algo::kVQSort);  // single-threaded baseline
+
+  for (Algo algo : algos) {
+    for (Dist dist : AllDist()) {
+      std::vector<double> seconds;
+      for (size_t rep = 0; rep < 3; ++rep) {
+        InputStats<LaneType> input_stats =
+            GenerateInput(dist, aligned.get(), num_lanes);
+        const Timestamp t0;
+        Run(algo, reinterpret_cast<KeyType*>(aligned.get()), num_keys, shared,
+            /*thread=*/0, /*k_keys=*/0, Order());
+        seconds.push_back(SecondsSince(t0));
+        SortOrderVerifier<Traits>()(algo, input_stats, aligned.get(), num_keys,
+                                    num_keys);
+      }
+      const size_t num_threads = algo == Algo::kVQSort ? 1 : num_workers;
+      SortResult(algo, dist, num_keys, num_threads,
+                 SummarizeMeasurements(seconds), sizeof(KeyType),
+                 st.KeyString())
+          .Print();
+    }
+  }
+}
+
+void BenchAllParallelSort() {
+  if (SkipTarget()) return;
+
+  const size_t num_keys = size_t{100} * 1000 * 1000;
+  BenchParallelSort(
+      detail::SharedTraits<detail::TraitsLane<detail::OrderAscending<float>>>(),
+      num_keys);
+  BenchParallelSort(
+      detail::SharedTraits<
+          detail::TraitsLane<detail::OrderAscending<int64_t>>>(),
+      num_keys);
+#if HWY_TARGET != HWY_SCALAR
+  BenchParallelSort(
+      detail::SharedTraits<detail::Traits128<detail::OrderAscending128>>(),
+      num_keys);
+#endif
+}
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -235,6 +175,7 @@ namespace hwy {
 namespace {
 HWY_BEFORE_TEST(BenchParallel);
 HWY_EXPORT_AND_TEST_P(BenchParallel, BenchParallel);
+HWY_EXPORT_AND_TEST_P(BenchParallel, BenchAllParallelSort);
 HWY_AFTER_TEST();
 }  // namespace
 }  // namespace hwy
@@ -13,9 +13,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <math.h>  // pow
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>  // memcmp
 
+#include <algorithm>  // std::sort
+#include <string>
 #include <vector>
 
 // clang-format off
@@ -26,6 +30,8 @@
 // After foreach_target
 #include "hwy/contrib/sort/algo-inl.h"
 #include "hwy/contrib/sort/vqsort.h"
+#include "hwy/contrib/sort/vqexternal-inl.h"
+#include "hwy/contrib/sort/vqmerge-inl.h"
 #include "hwy/contrib/sort/result-inl.h"
 #include "hwy/contrib/sort/sorting_networks-inl.h"  // SharedTraits
 #include "hwy/contrib/sort/traits-inl.h"
@@ -46,6 +52,18 @@
 #ifndef SORT_BENCH_BASE_AND_PARTITION
 #define SORT_BENCH_BASE_AND_PARTITION (!SORT_ONLY_COLD && 0)
 #endif
+#ifndef SORT_BENCH_MERGE
+#define SORT_BENCH_MERGE (!SORT_ONLY_COLD)
+#endif
+#ifndef SORT_BENCH_RECORDS
+#define SORT_BENCH_RECORDS (!SORT_ONLY_COLD)
+#endif
+#ifndef SORT_BENCH_EXTERNAL
+#define SORT_BENCH_EXTERNAL (!SORT_ONLY_COLD)
+#endif
+#ifndef SORT_BENCH_STRINGS
+#define SORT_BENCH_STRINGS (!SORT_ONLY_COLD)
+#endif
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -297,6 +315,7 @@ std::vector<Algo> AlgoForBench() {
 #if VQSORT_ENABLED
         Algo::kVQSort,
 #endif
+        Algo::kVQRadix,
 #endif  // !HAVE_PARALLEL_IPS4O
   };
 }
@@ -319,12 +338,16 @@ HWY_NOINLINE void BenchSort(size_t num_keys) {
     // Other algorithms don't depend on the vector instructions, so only run
     // them for the first target.
 #if !HAVE_VXSORT
-    if (algo != Algo::kVQSort && HWY_TARGET != first_sort_target) {
+    if (algo != Algo::kVQSort && algo != Algo::kVQRadix &&
+        HWY_TARGET != first_sort_target) {
       continue;
     }
 #endif
 
-    for (Dist dist : AllDist()) {
+    std::vector<Dist> dists = AllDist();
+    const std::vector<Dist> presorted = PresortedDist();
+    dists.insert(dists.end(), presorted.begin(), presorted.end());
+    for (Dist dist : dists) {
       std::vector<double> seconds;
       for (size_t rep = 0; rep < reps; ++rep) {
         InputStats<LaneType> input_stats =
@@ -445,6 +468,330 @@ HWY_NOINLINE void BenchAllSort() {
   }
 }
 
+#if SORT_BENCH_MERGE || HWY_IDE
+
+// Throughput of merging `num_runs` sorted runs with `num_keys` in total,
+// compared with re-sorting their concatenation.
+template <class Traits>
+HWY_NOINLINE void BenchMerge(size_t num_keys, size_t num_runs) {
+  detail::SharedTraits<Traits> st;
+  using Order = typename Traits::Order;
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  auto in = hwy::AllocateAligned<LaneType>(num_lanes);
+  auto out = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(in && out);
+  KeyType* in_keys = HWY_RCAST_ALIGNED(KeyType*, in.get());
+  KeyType* out_keys = HWY_RCAST_ALIGNED(KeyType*, out.get());
+
+  const Dist dist = Dist::kUniform32;
+  InputStats<LaneType> input_stats = GenerateInput(dist, in.get(), num_lanes);
+  std::vector<const KeyType*> runs;
+  std::vector<size_t> sizes;
+  for (size_t i = 0; i < num_runs; ++i) {
+    const size_t begin = num_keys * i / num_runs;
+    const size_t end = num_keys * (i + 1) / num_runs;
+    VQSortStatic(in_keys + begin, end - begin, Order());
+    runs.push_back(in_keys + begin);
+    sizes.push_back(end - begin);
+  }
+
+  std::vector<double> merge_seconds;
+  std::vector<double> sort_seconds;
+  for (size_t rep = 0; rep < 10; ++rep) {
+    const Timestamp t0;
+    VQMergeKStatic(runs.data(), sizes.data(), num_runs, out_keys, Order());
+    merge_seconds.push_back(SecondsSince(t0));
+    SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats, out.get(),
+                                num_keys, num_keys);
+
+    CopyBytes(in.get(), out.get(), num_lanes * sizeof(LaneType));
+    const Timestamp t1;
+    VQSortStatic(out_keys, num_keys, Order());
+    sort_seconds.push_back(SecondsSince(t1));
+  }
+
+  const double bytes = static_cast<double>(num_keys * sizeof(KeyType));
+  const double merge_GBps = bytes * 1E-9 / SummarizeMeasurements(merge_seconds);
+  const double sort_GBps = bytes * 1E-9 / SummarizeMeasurements(sort_seconds);
+  fprintf(stderr,
+          "%s: merge %3zu runs %s %9zu keys: %6.2f GB/s (re-sort: %6.2f)\n",
+          hwy::TargetName(HWY_TARGET), num_runs, st.KeyString(), num_keys,
+          merge_GBps, sort_GBps);
+}
+
+HWY_NOINLINE void BenchAllMerge() {
+  // Not interested in benchmark results for these targets, see BenchAllSort.
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+
+  const size_t num_keys = AdjustedReps(size_t{1000} * 1000);
+  for (size_t num_runs : {size_t{2}, size_t{16}, size_t{64}}) {
+    BenchMerge<TraitsLane<OrderAscending<int32_t>>>(num_keys, num_runs);
+    BenchMerge<TraitsLane<OtherOrder<int64_t>>>(num_keys, num_runs);
+#if HWY_TARGET != HWY_SCALAR
+    BenchMerge<Traits128<OrderAscending128>>(num_keys, num_runs);
+#endif
+  }
+}
+
+#endif  // SORT_BENCH_MERGE
+
+#if SORT_BENCH_RECORDS || HWY_IDE
+
+template <size_t kBytes, typename Key>
+struct BenchRecord {
+  Key key;
+  uint8_t payload[kBytes - sizeof(Key)];
+};
+
+// Compares VQSortRecords with std::sort of the same structs.
+template <size_t kBytes, typename Key>
+HWY_NOINLINE void BenchRecords(size_t num, RecordKey record_key) {
+  using Record = BenchRecord<kBytes, Key>;
+  static_assert(sizeof(Record) == kBytes, "Unexpected padding");
+  std::vector<Record> input(num);
+  RandomState rng;
+  for (Record& r : input) {
+    r.key = static_cast<Key>(Random64(&rng));
+    for (uint8_t& byte : r.payload) {
+      byte = static_cast<uint8_t>(Random32(&rng));
+    }
+  }
+
+  std::vector<Record> records;
+  std::vector<double> vq_seconds;
+  std::vector<double> std_seconds;
+  for (size_t rep = 0; rep < 5; ++rep) {
+    records = input;
+    const Timestamp t0;
+    VQSortRecords(records.data(), num, kBytes, 0, record_key,
+                  SortAscending());
+    vq_seconds.push_back(SecondsSince(t0));
+    for (size_t i = 1; i < num; ++i) {
+      HWY_ASSERT(records[i - 1].key <= records[i].key);
+    }
+
+    records = input;
+    const Timestamp t1;
+    std::sort(records.begin(), records.end(),
+              [](const Record& a, const Record& b) { return a.key < b.key; });
+    std_seconds.push_back(SecondsSince(t1));
+  }
+
+  const double bytes = static_cast<double>(num * kBytes);
+  fprintf(stderr,
+          "%s: records %2zu bytes %s %9zu: %6.2f GB/s (std::sort: %6.2f)\n",
+          hwy::TargetName(HWY_TARGET), kBytes, TypeName(Key(), 1).c_str(),
+          num, bytes * 1E-9 / SummarizeMeasurements(vq_seconds),
+          bytes * 1E-9 / SummarizeMeasurements(std_seconds));
+}
+
+HWY_NOINLINE void BenchAllRecords() {
+  // Not interested in benchmark results for these targets, see BenchAllSort.
+  // Note that VQSortRecords always dispatches to the best target.
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+
+  const size_t num = AdjustedReps(size_t{1000} * 1000);
+  BenchRecords<16, uint32_t>(num, RecordKey::kU32);
+  BenchRecords<16, uint64_t>(num, RecordKey::kU64);
+  BenchRecords<32, uint64_t>(num, RecordKey::kU64);
+  BenchRecords<48, uint32_t>(num, RecordKey::kU32);
+  BenchRecords<48, uint64_t>(num, RecordKey::kU64);
+}
+
+#endif  // SORT_BENCH_RECORDS
+
+#if SORT_BENCH_EXTERNAL || HWY_IDE
+
+// Sorts a file larger than the buffer, i.e. memory budget.
+template <class Traits>
+HWY_NOINLINE void BenchExternal(size_t num_keys, size_t buf_bytes) {
+  detail::SharedTraits<Traits> st;
+  using Order = typename Traits::Order;
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  auto keys = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(keys);
+  KeyType* HWY_RESTRICT key_ptr = HWY_RCAST_ALIGNED(KeyType*, keys.get());
+  InputStats<LaneType> input_stats =
+      GenerateInput(Dist::kUniform32, keys.get(), num_lanes);
+
+  FILE* in = tmpfile();
+  FILE* out = tmpfile();
+  HWY_ASSERT(in != nullptr && out != nullptr);
+  HWY_ASSERT(fwrite(key_ptr, sizeof(KeyType), num_keys, in) == num_keys);
+  const size_t buf_keys = buf_bytes / sizeof(KeyType);
+  auto buf = hwy::AllocateAligned<KeyType>(buf_keys);
+  HWY_ASSERT(buf);
+
+  std::vector<double> seconds;
+  for (size_t rep = 0; rep < 3; ++rep) {
+    rewind(in);
+    rewind(out);
+    const Timestamp t0;
+    HWY_ASSERT(VQSortExternalStatic(in, out, buf.get(), buf_keys, Order()));
+    HWY_ASSERT(fflush(out) == 0);
+    seconds.push_back(SecondsSince(t0));
+  }
+
+  rewind(out);
+  HWY_ASSERT(fread(key_ptr, sizeof(KeyType), num_keys, out) == num_keys);
+  SortOrderVerifier<Traits>()(Algo::kVQSort, input_stats, keys.get(),
+                              num_keys, num_keys);
+  fclose(in);
+  fclose(out);
+
+  const double bytes = static_cast<double>(num_keys * sizeof(KeyType));
+  fprintf(stderr, "%s: external %s %9zu keys, budget %5zu KiB: %6.2f GB/s\n",
+          hwy::TargetName(HWY_TARGET), st.KeyString(), num_keys,
+          buf_bytes >> 10, bytes * 1E-9 / SummarizeMeasurements(seconds));
+}
+
+HWY_NOINLINE void BenchAllExternal() {
+  // Not interested in benchmark results for these targets, see BenchAllSort.
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+
+  // 32 MiB of 64-bit keys.
+  const size_t num_keys = AdjustedReps(size_t{4} << 20);
+  for (size_t buf_bytes : {size_t{1} << 20, size_t{8} << 20}) {
+    BenchExternal<TraitsLane<OrderAscending<int64_t>>>(num_keys, buf_bytes);
+#if HWY_TARGET != HWY_SCALAR
+    BenchExternal<Traits128<OrderAscending128>>(num_keys / 2, buf_bytes);
+#endif
+  }
+}
+
+#endif  // SORT_BENCH_EXTERNAL
+
+#if SORT_BENCH_STRINGS || HWY_IDE
+
+// Returns a pronounceable lowercase word of 1 to 4 syllables.
+std::string RandomWord(RandomState& rng) {
+  static constexpr const char* kConsonants = "bcdfghklmnprstvwz";
+  static constexpr const char* kVowels = "aeiou";
+  std::string word;
+  const size_t syllables = 1 + Random32(&rng) % 4;
+  for (size_t i = 0; i < syllables; ++i) {
+    word.push_back(kConsonants[Random32(&rng) % 17]);
+    word.push_back(kVowels[Random32(&rng) % 5]);
+    if (Random32(&rng) & 1) word.push_back(kConsonants[Random32(&rng) % 17]);
+  }
+  return word;
+}
+
+// Returns an index in [0, num) with approximately Zipfian frequencies, as for
+// words of natural language.
+size_t ZipfIndex(size_t num, RandomState& rng) {
+  const double u = static_cast<double>(Random32(&rng)) * (1.0 / 4294967296.0);
+  const size_t index =
+      static_cast<size_t>(pow(static_cast<double>(num), u)) - 1;
+  return HWY_MIN(index, num - 1);
+}
+
+// Words drawn from a vocabulary with Zipfian frequencies, hence many
+// duplicates and short strings.
+std::vector<std::string> GenerateWords(size_t num, RandomState& rng) {
+  std::vector<std::string> vocabulary(50000);
+  for (std::string& word : vocabulary) {
+    word = RandomWord(rng);
+  }
+  std::vector<std::string> words(num);
+  for (std::string& word : words) {
+    word = vocabulary[ZipfIndex(vocabulary.size(), rng)];
+  }
+  return words;
+}
+
+// URLs with a few schemes, popular hosts and paths of several words, hence
+// long common prefixes.
+std::vector<std::string> GenerateURLs(size_t num, RandomState& rng) {
+  static constexpr const char* kTLDs[4] = {".com", ".org", ".net", ".de"};
+  std::vector<std::string> hosts(2000);
+  for (std::string& host : hosts) {
+    host = (Random32(&rng) & 1) ? "https://www." : "https://";
+    host += RandomWord(rng) + kTLDs[Random32(&rng) % 4];
+  }
+  std::vector<std::string> urls(num);
+  for (std::string& url : urls) {
+    url = hosts[ZipfIndex(hosts.size(), rng)];
+    const size_t segments = Random32(&rng) % 5;
+    for (size_t i = 0; i < segments; ++i) {
+      url += "/" + RandomWord(rng);
+    }
+    if (Random32(&rng) % 4 == 0) {
+      url += "?id=" + std::to_string(Random32(&rng) % 100000);
+    }
+  }
+  return urls;
+}
+
+bool StringLess(const StringKey& a, const StringKey& b) {
+  const int cmp = memcmp(a.data, b.data, HWY_MIN(a.size, b.size));
+  return cmp != 0 ? cmp < 0 : a.size < b.size;
+}
+
+// Compares VQSortStrings with std::sort of the same references.
+HWY_NOINLINE void BenchStrings(const char* caption,
+                               const std::vector<std::string>& strings) {
+  const size_t num = strings.size();
+  std::vector<StringKey> input(num);
+  size_t bytes = 0;
+  for (size_t i = 0; i < num; ++i) {
+    input[i] = StringKey{strings[i].data(), strings[i].size()};
+    bytes += strings[i].size();
+  }
+
+  std::vector<StringKey> keys;
+  std::vector<double> vq_seconds;
+  std::vector<double> std_seconds;
+  for (size_t rep = 0; rep < 5; ++rep) {
+    keys = input;
+    const Timestamp t0;
+    VQSortStrings(keys.data(), num, SortAscending());
+    vq_seconds.push_back(SecondsSince(t0));
+    for (size_t i = 1; i < num; ++i) {
+      HWY_ASSERT(!StringLess(keys[i], keys[i - 1]));
+    }
+
+    keys = input;
+    const Timestamp t1;
+    std::sort(keys.begin(), keys.end(), StringLess);
+    std_seconds.push_back(SecondsSince(t1));
+  }
+
+  fprintf(stderr,
+          "%s: strings %-5s %9zu, %5.1f bytes avg: %6.2f M/s (std::sort: "
+          "%6.2f)\n",
+          hwy::TargetName(HWY_TARGET), caption, num,
+          static_cast<double>(bytes) / static_cast<double>(num),
+          static_cast<double>(num) * 1E-6 / SummarizeMeasurements(vq_seconds),
+          static_cast<double>(num) * 1E-6 /
+              SummarizeMeasurements(std_seconds));
+}
+
+HWY_NOINLINE void BenchAllStrings() {
+  // Not interested in benchmark results for these targets, see BenchAllSort.
+  // Note that VQSortStrings always dispatches to the best target.
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+
+  const size_t num = AdjustedReps(size_t{1000} * 1000);
+  RandomState rng;
+  BenchStrings("words", GenerateWords(num, rng));
+  BenchStrings("URLs", GenerateURLs(num, rng));
+}
+
+#endif  // SORT_BENCH_STRINGS
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -466,6 +813,18 @@ HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllBase);
 #if !SORT_ONLY_COLD  // skip (warms up vector unit for next run)
 HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllSort);
 #endif
+#if SORT_BENCH_MERGE
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllMerge);
+#endif
+#if SORT_BENCH_RECORDS
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllRecords);
+#endif
+#if SORT_BENCH_EXTERNAL
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllExternal);
+#endif
+#if SORT_BENCH_STRINGS
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllStrings);
+#endif
 HWY_AFTER_TEST();
 }  // namespace hwy
 
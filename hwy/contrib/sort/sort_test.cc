@@ -15,13 +15,18 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>  // memcmp
 
-#include <numeric>  // std::iota
+#include <algorithm>  // std::shuffle, std::stable_sort
+#include <numeric>    // std::iota
 #include <random>
+#include <string>
 #include <vector>
 
 #include "hwy/aligned_allocator.h"  // IsAligned
 #include "hwy/base.h"
+#include "hwy/contrib/sort/vqexternal.h"
+#include "hwy/contrib/sort/vqmerge.h"
 #include "hwy/contrib/sort/vqsort.h"
 #include "hwy/contrib/thread_pool/thread_pool.h"
 #include "hwy/contrib/thread_pool/topology.h"
@@ -34,7 +39,10 @@
 // After highway.h
 #include "hwy/contrib/sort/algo-inl.h"
 #include "hwy/contrib/sort/result-inl.h"
+#include "hwy/contrib/sort/vqselect-inl.h"
 #include "hwy/contrib/sort/vqsort-inl.h"  // BaseCase
+#include "hwy/contrib/sort/vqtopk-inl.h"
+#include "hwy/contrib/sort/vqunique-inl.h"
 #include "hwy/print-inl.h"
 #include "hwy/tests/test_util-inl.h"
 
@@ -91,7 +99,8 @@ void TestAllSortIota() {
 
 // Supports full/partial sort and select.
 template <class Traits>
-void TestAnySort(const std::vector<Algo>& algos, size_t num_lanes) {
+void TestAnySort(const std::vector<Algo>& algos, size_t num_lanes,
+                 const std::vector<Dist>& dists) {
 // Workaround for stack overflow on clang-cl (/F 8388608 does not help).
 #if defined(_MSC_VER)
   return;
@@ -117,7 +126,7 @@ void TestAnySort(const std::vector<Algo>& algos, size_t num_lanes) {
   for (Algo algo : algos) {
     if (IsVQ(algo) && !VQSORT_ENABLED) continue;
 
-    for (Dist dist : AllDist()) {
+    for (Dist dist : dists) {
       for (size_t misalign :
            {size_t{0}, size_t{kLPK}, size_t{3 * kLPK}, kMaxMisalign / 2}) {
         for (size_t k_rep = 0; k_rep < AdjustedReps(10); ++k_rep) {
@@ -166,17 +175,18 @@ void TestAnySort(const std::vector<Algo>& algos, size_t num_lanes) {
 }
 
 // Calls TestAnySort with all traits.
-void CallAllSortTraits(const std::vector<Algo>& algos, size_t num_lanes) {
+void CallAllSortTraits(const std::vector<Algo>& algos, size_t num_lanes,
+                       const std::vector<Dist>& dists = AllDist()) {
 #if !HAVE_INTEL
-  TestAnySort<TraitsLane<OrderAscending<int16_t>>>(algos, num_lanes);
-  TestAnySort<TraitsLane<OtherOrder<uint16_t>>>(algos, num_lanes);
+  TestAnySort<TraitsLane<OrderAscending<int16_t>>>(algos, num_lanes, dists);
+  TestAnySort<TraitsLane<OtherOrder<uint16_t>>>(algos, num_lanes, dists);
 #endif
 
-  TestAnySort<TraitsLane<OtherOrder<int32_t>>>(algos, num_lanes);
-  TestAnySort<TraitsLane<OtherOrder<uint32_t>>>(algos, num_lanes);
+  TestAnySort<TraitsLane<OtherOrder<int32_t>>>(algos, num_lanes, dists);
+  TestAnySort<TraitsLane<OtherOrder<uint32_t>>>(algos, num_lanes, dists);
 
-  TestAnySort<TraitsLane<OrderAscending<int64_t>>>(algos, num_lanes);
-  TestAnySort<TraitsLane<OrderAscending<uint64_t>>>(algos, num_lanes);
+  TestAnySort<TraitsLane<OrderAscending<int64_t>>>(algos, num_lanes, dists);
+  TestAnySort<TraitsLane<OrderAscending<uint64_t>>>(algos, num_lanes, dists);
 
   // WARNING: for float types, SIMD comparisons will flush denormals to
   // zero, causing mismatches with scalar sorts. In this test, we avoid
@@ -184,29 +194,30 @@ void CallAllSortTraits(const std::vector<Algo>& algos, size_t num_lanes) {
 #if HWY_HAVE_FLOAT16  // #if protects algo-inl.h's GenerateRandom
   // Must also check whether the dynamic-dispatch target supports float16_t!
   if (hwy::HaveFloat16()) {
-    TestAnySort<TraitsLane<OrderAscending<float16_t>>>(algos, num_lanes);
+    TestAnySort<TraitsLane<OrderAscending<float16_t>>>(algos, num_lanes,
+                                                       dists);
   }
 #endif
-  TestAnySort<TraitsLane<OrderAscending<float>>>(algos, num_lanes);
+  TestAnySort<TraitsLane<OrderAscending<float>>>(algos, num_lanes, dists);
 #if HWY_HAVE_FLOAT64  // #if protects algo-inl.h's GenerateRandom
   // Must also check whether the dynamic-dispatch target supports float64!
   if (hwy::HaveFloat64()) {
-    TestAnySort<TraitsLane<OtherOrder<double>>>(algos, num_lanes);
+    TestAnySort<TraitsLane<OtherOrder<double>>>(algos, num_lanes, dists);
   }
 #endif
 
   // Other algorithms do not support 128-bit nor KV keys.
 #if !HAVE_VXSORT && !HAVE_INTEL
-  TestAnySort<TraitsLane<OrderAscendingKV64>>(algos, num_lanes);
-  TestAnySort<TraitsLane<OrderDescendingKV64>>(algos, num_lanes);
+  TestAnySort<TraitsLane<OrderAscendingKV64>>(algos, num_lanes, dists);
+  TestAnySort<TraitsLane<OrderDescendingKV64>>(algos, num_lanes, dists);
 
 // 128-bit keys require 128-bit SIMD.
 #if HWY_TARGET != HWY_SCALAR
-  TestAnySort<Traits128<OrderAscending128>>(algos, num_lanes);
-  TestAnySort<Traits128<OrderDescending128>>(algos, num_lanes);
+  TestAnySort<Traits128<OrderAscending128>>(algos, num_lanes, dists);
+  TestAnySort<Traits128<OrderDescending128>>(algos, num_lanes, dists);
 
-  TestAnySort<Traits128<OrderAscendingKV128>>(algos, num_lanes);
-  TestAnySort<Traits128<OrderDescendingKV128>>(algos, num_lanes);
+  TestAnySort<Traits128<OrderAscendingKV128>>(algos, num_lanes, dists);
+  TestAnySort<Traits128<OrderDescendingKV128>>(algos, num_lanes, dists);
 #endif  // HWY_TARGET != HWY_SCALAR
 #endif  // !HAVE_VXSORT && !HAVE_INTEL
 }
@@ -252,6 +263,726 @@ void TestAllSelect() {
   }
 }
 
+// Inputs that HandleSpecialCases may finish in O(n). PartialSort and Select
+// share that code, but would take far longer due to their repetitions.
+void TestAllSortPresorted() {
+  const std::vector<Algo> algos{Algo::kVQSort};
+  for (int num : {129, 3 * 1000, 34567}) {
+    const size_t num_lanes = AdjustedReps(static_cast<size_t>(num));
+    CallAllSortTraits(algos, num_lanes, PresortedDist());
+  }
+}
+
+void TestAllSortParallel() {
+  const std::vector<Algo> algos{Algo::kVQSortParallel};
+
+  // The larger size exceeds the minimum for which VQSortParallel actually uses
+  // multiple threads, even for 16-bit keys.
+  for (int num : {3 * 1000, 3 << 16}) {
+    const size_t num_lanes = AdjustedReps(static_cast<size_t>(num));
+    CallAllSortTraits(algos, num_lanes);
+  }
+}
+
+void TestAllSortRadix() {
+  const std::vector<Algo> algos{Algo::kVQRadix};
+
+  // The smallest size is forwarded to VQSort.
+  for (int num : {129, 3 * 1000, 34567}) {
+    const size_t num_lanes = AdjustedReps(static_cast<size_t>(num));
+    CallAllSortTraits(algos, num_lanes);
+  }
+}
+
+template <typename Key, typename Index, class Order>
+void TestArgSort(const size_t num, Order order) {
+  // Few distinct values, so that there are many ties for checking stability.
+  std::mt19937 rng(static_cast<uint32_t>(num));
+  std::uniform_int_distribution<int> dist(IsSigned<Key>() ? -50 : 0, 49);
+  std::vector<Key> keys(num);
+  for (Key& key : keys) {
+    key = ConvertScalarTo<Key>(dist(rng));
+  }
+  const std::vector<Key> copy = keys;
+
+  std::vector<Index> indices(num);
+  VQArgSort(keys.data(), num, indices.data(), order);
+
+  HWY_ASSERT(keys == copy);  // keys are not modified
+  std::vector<bool> seen(num);
+  for (size_t i = 0; i < num; ++i) {
+    const size_t idx = static_cast<size_t>(indices[i]);
+    HWY_ASSERT(idx < num && !seen[idx]);  // is a permutation
+    seen[idx] = true;
+    if (i == 0) continue;
+    const Key prev = keys[indices[i - 1]];
+    const Key cur = keys[idx];
+    if (prev == cur) {
+      if (indices[i - 1] >= indices[i]) {
+        HWY_ABORT("%s num %zu i %zu: not stable, indices %zu %zu\n",
+                  TypeName(Key(), 1).c_str(), num, i,
+                  static_cast<size_t>(indices[i - 1]), idx);
+      }
+    } else if (Order::IsAscending() ? !(prev < cur) : !(cur < prev)) {
+      HWY_ABORT("%s num %zu i %zu: wrong order %f %f\n",
+                TypeName(Key(), 1).c_str(), num, i,
+                ConvertScalarTo<double>(prev), ConvertScalarTo<double>(cur));
+    }
+  }
+}
+
+template <typename Key>
+void TestArgSortKey() {
+  for (size_t num : {size_t{0}, size_t{1}, size_t{15}, size_t{1000},
+                     AdjustedReps(40000)}) {
+    TestArgSort<Key, uint32_t>(num, SortAscending());
+    TestArgSort<Key, uint32_t>(num, SortDescending());
+    TestArgSort<Key, uint64_t>(num, SortAscending());
+    TestArgSort<Key, uint64_t>(num, SortDescending());
+  }
+}
+
+void TestAllArgSort() {
+  TestArgSortKey<uint16_t>();
+  TestArgSortKey<int16_t>();
+  TestArgSortKey<uint32_t>();
+  TestArgSortKey<int32_t>();
+  TestArgSortKey<uint64_t>();
+  TestArgSortKey<int64_t>();
+  TestArgSortKey<float>();
+  // Argsort only requires integer ops, hence works even without native f16/64.
+  TestArgSortKey<float16_t>();
+  TestArgSortKey<double>();
+}
+
+// Input shared by the tests below: few distinct keys, so that there are many
+// ties. Values of key-value types are derived from the key so that the expected
+// result is unique.
+template <typename Key>
+void SetTiedKey(uint64_t bits, Key& key) {
+  const int64_t offset = IsSigned<Key>() ? 500 : 0;
+  key = ConvertScalarTo<Key>(static_cast<int64_t>(bits % 1000) - offset);
+}
+void SetTiedKey(uint64_t bits, K32V32& key) {
+  key.key = static_cast<uint32_t>(bits % 1000);
+  key.value = key.key * 3;
+}
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+void SetTiedKey(uint64_t bits, K64V64& key) {
+  key.key = bits % 1000;
+  key.value = key.key * 3;
+}
+void SetTiedKey(uint64_t bits, uint128_t& key) {
+  key.hi = bits % 1000;
+  key.lo = (bits >> 32) % 7;
+}
+#endif  // HWY_TARGET != HWY_SCALAR
+
+template <typename Key>
+std::vector<Key> GenerateTiedKeys(size_t num, std::mt19937_64& rng) {
+  std::vector<Key> keys(num);
+  for (Key& key : keys) {
+    SetTiedKey(rng(), key);
+  }
+  return keys;
+}
+
+// For failure messages.
+template <class Order>
+const char* OrderString() {
+  return Order::IsAscending() ? "asc" : "desc";
+}
+
+// Returns whether `a` and `b` have the same key. Their values may differ.
+template <class Order, typename Key>
+bool SameKey(const Key& a, const Key& b) {
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  return st.Equal1(reinterpret_cast<const LaneType*>(&a),
+                   reinterpret_cast<const LaneType*>(&b));
+}
+
+// Sorted keys followed by a few unsorted keys, for which VQSort merges the
+// latter into the former.
+template <typename Key, class Order>
+void TestSortedTail(size_t num, size_t num_tail, Order order,
+                    std::mt19937_64& rng) {
+  std::vector<Key> keys = GenerateTiedKeys<Key>(num, rng);
+  VQSort(keys.data(), num - num_tail, order);
+  // Shuffled, so that the expected result does not also use the special case.
+  std::vector<Key> expected = keys;
+  std::shuffle(expected.begin(), expected.end(), rng);
+  VQSort(expected.data(), num, order);
+
+  VQSort(keys.data(), num, order);
+  if (memcmp(keys.data(), expected.data(), num * sizeof(Key)) != 0) {
+    HWY_ABORT("SortedTail %s %zu keys, tail %zu: mismatch\n",
+              OrderString<Order>(), num, num_tail);
+  }
+}
+
+template <typename Key>
+void TestSortedTailKey(std::mt19937_64& rng) {
+  for (size_t num_tail : {size_t{0}, size_t{1}, size_t{7}, size_t{64}}) {
+    for (size_t num : {size_t{1000}, size_t{30001}}) {
+      TestSortedTail<Key>(num, num_tail, SortAscending(), rng);
+      TestSortedTail<Key>(num, num_tail, SortDescending(), rng);
+    }
+  }
+}
+
+void TestAllSortedTail() {
+  std::mt19937_64 rng(12345);
+  TestSortedTailKey<uint16_t>(rng);
+  TestSortedTailKey<int32_t>(rng);
+  TestSortedTailKey<float>(rng);
+  TestSortedTailKey<uint64_t>(rng);
+  TestSortedTailKey<K32V32>(rng);
+#if HWY_TARGET != HWY_SCALAR
+  TestSortedTailKey<uint128_t>(rng);
+  TestSortedTailKey<K64V64>(rng);
+#endif
+}
+
+template <typename Key, class Order>
+void TestMergeK(size_t num_runs, Order order, std::mt19937_64& rng) {
+  // Includes empty runs and runs shorter than a vector.
+  std::uniform_int_distribution<size_t> size_dist(0, 3000);
+  std::vector<size_t> sizes(num_runs);
+  size_t total = 0;
+  for (size_t& size : sizes) {
+    size = size_dist(rng);
+    total += size;
+  }
+  std::vector<Key> keys = GenerateTiedKeys<Key>(total, rng);
+  std::vector<Key> expected = keys;
+  VQSort(expected.data(), total, order);
+
+  std::vector<const Key*> runs(num_runs);
+  size_t pos = 0;
+  for (size_t i = 0; i < num_runs; ++i) {
+    runs[i] = keys.data() + pos;
+    VQSort(keys.data() + pos, sizes[i], order);
+    pos += sizes[i];
+  }
+
+  std::vector<Key> out(total);
+  if (num_runs == 2) {
+    VQMerge(runs[0], sizes[0], runs[1], sizes[1], out.data(), order);
+  } else {
+    VQMergeK(runs.data(), sizes.data(), num_runs, out.data(), order);
+  }
+  for (size_t i = 0; i < total; ++i) {
+    if (memcmp(&out[i], &expected[i], sizeof(Key)) != 0) {
+      HWY_ABORT("Merge %s %zu runs of total %zu: mismatch at %zu\n",
+                OrderString<Order>(), num_runs, total, i);
+    }
+  }
+}
+
+template <typename Key>
+void TestMergeKey(std::mt19937_64& rng) {
+  for (size_t num_runs : {size_t{1}, size_t{2}, size_t{3}, size_t{5},
+                          size_t{17}, size_t{64}}) {
+    TestMergeK<Key>(num_runs, SortAscending(), rng);
+    TestMergeK<Key>(num_runs, SortDescending(), rng);
+  }
+}
+
+void TestAllMerge() {
+  std::mt19937_64 rng(12345);
+  TestMergeKey<uint16_t>(rng);
+  TestMergeKey<int32_t>(rng);
+  TestMergeKey<uint64_t>(rng);
+  TestMergeKey<float>(rng);
+  if (hwy::HaveFloat16()) {
+    TestMergeKey<float16_t>(rng);
+  }
+  if (hwy::HaveFloat64()) {
+    TestMergeKey<double>(rng);
+  }
+  TestMergeKey<K32V32>(rng);
+#if HWY_TARGET != HWY_SCALAR
+  TestMergeKey<uint128_t>(rng);
+  TestMergeKey<K64V64>(rng);
+#endif
+}
+
+template <class KV, class Order>
+void TestStableSort(size_t num, Order order, std::mt19937_64& rng) {
+  // Few distinct keys, and values are the original position.
+  std::vector<KV> pairs(num);
+  for (size_t i = 0; i < num; ++i) {
+    pairs[i].key = static_cast<decltype(pairs[i].key)>(rng() % 100);
+    pairs[i].value = static_cast<decltype(pairs[i].value)>(i);
+  }
+  std::vector<KV> expected = pairs;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const KV& a, const KV& b) {
+                     return Order::IsAscending() ? a.key < b.key
+                                                 : b.key < a.key;
+                   });
+  VQStableSort(pairs.data(), num, order);
+  for (size_t i = 0; i < num; ++i) {
+    if (pairs[i].key != expected[i].key ||
+        pairs[i].value != expected[i].value) {
+      HWY_ABORT("StableSort %s %zu: mismatch at %zu\n",
+                OrderString<Order>(), num, i);
+    }
+  }
+}
+
+void TestAllStableSort() {
+  std::mt19937_64 rng(12345);
+  for (size_t num : {size_t{0}, size_t{1}, size_t{2}, size_t{7}, size_t{1000},
+                     size_t{100003}}) {
+    TestStableSort<K32V32>(num, SortAscending(), rng);
+    TestStableSort<K32V32>(num, SortDescending(), rng);
+    TestStableSort<K64V64>(num, SortAscending(), rng);
+    TestStableSort<K64V64>(num, SortDescending(), rng);
+  }
+}
+
+template <size_t kBytes>
+struct TestRecord {
+  uint8_t bytes[kBytes];
+};
+
+template <size_t kBytes, typename Key, class Order>
+void TestSortRecords(size_t num, size_t key_offset, RecordKey record_key,
+                     Order order, std::mt19937_64& rng) {
+  using Record = TestRecord<kBytes>;
+  std::vector<Record> records(num);
+  for (size_t i = 0; i < num; ++i) {
+    for (uint8_t& byte : records[i].bytes) {
+      byte = static_cast<uint8_t>(rng());
+    }
+    // Few distinct keys, so that stability matters.
+    Key key;
+    SetTiedKey(rng(), key);
+    CopyBytes<sizeof(Key)>(&key, records[i].bytes + key_offset);
+  }
+  const auto get_key = [key_offset](const Record& r) {
+    Key key;
+    CopyBytes<sizeof(Key)>(r.bytes + key_offset, &key);
+    return key;
+  };
+  std::vector<Record> expected = records;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&get_key](const Record& a, const Record& b) {
+                     return Order::IsAscending() ? get_key(a) < get_key(b)
+                                                 : get_key(b) < get_key(a);
+                   });
+
+  VQSortRecords(records.data(), num, kBytes, key_offset, record_key, order);
+  if (num != 0 &&
+      memcmp(records.data(), expected.data(), num * sizeof(Record)) != 0) {
+    HWY_ABORT("SortRecords %s %zu bytes, offset %zu, %zu records: mismatch\n",
+              OrderString<Order>(), kBytes, key_offset, num);
+  }
+}
+
+template <size_t kBytes, typename Key>
+void TestSortRecordsSize(size_t key_offset, RecordKey record_key,
+                         std::mt19937_64& rng) {
+  for (size_t num : {size_t{0}, size_t{1}, size_t{15}, size_t{1000},
+                     size_t{30001}}) {
+    TestSortRecords<kBytes, Key>(num, key_offset, record_key, SortAscending(),
+                                 rng);
+    TestSortRecords<kBytes, Key>(num, key_offset, record_key,
+                                 SortDescending(), rng);
+  }
+}
+
+void TestAllSortRecords() {
+  std::mt19937_64 rng(12345);
+  TestSortRecordsSize<16, uint32_t>(0, RecordKey::kU32, rng);
+  TestSortRecordsSize<24, int32_t>(20, RecordKey::kI32, rng);
+  TestSortRecordsSize<32, float>(6, RecordKey::kF32, rng);
+  TestSortRecordsSize<16, uint64_t>(8, RecordKey::kU64, rng);
+  TestSortRecordsSize<40, int64_t>(3, RecordKey::kI64, rng);
+  TestSortRecordsSize<48, double>(40, RecordKey::kF64, rng);
+}
+
+template <class Order>
+void TestSortStrings(size_t num, Order order, std::mt19937_64& rng) {
+  // Few distinct bytes: 0xFE, 0xFF, 0 and 1, which must compare as unsigned.
+  // Lengths straddle the 8-byte digits, and some strings share a long prefix
+  // to require several passes.
+  const std::string prefix = "https://www.example.com/";
+  std::uniform_int_distribution<size_t> length_dist(0, 40);
+  std::vector<std::string> strings(num);
+  for (std::string& str : strings) {
+    if (rng() & 1) str = prefix.substr(0, rng() % (prefix.size() + 1));
+    const size_t length = length_dist(rng);
+    for (size_t i = 0; i < length; ++i) {
+      str.push_back(static_cast<char>(0xFE + rng() % 4));
+    }
+  }
+  std::vector<StringKey> keys(num);
+  for (size_t i = 0; i < num; ++i) {
+    keys[i] = StringKey{strings[i].data(), strings[i].size()};
+  }
+  std::vector<std::string> expected = strings;
+  std::sort(expected.begin(), expected.end());
+  if (!Order::IsAscending()) std::reverse(expected.begin(), expected.end());
+
+  VQSortStrings(keys.data(), num, order);
+  for (size_t i = 0; i < num; ++i) {
+    if (expected[i] != std::string(keys[i].data, keys[i].size)) {
+      HWY_ABORT("SortStrings %s %zu: mismatch at %zu\n",
+                OrderString<Order>(), num, i);
+    }
+  }
+}
+
+void TestAllSortStrings() {
+  std::mt19937_64 rng(12345);
+  for (size_t num : {size_t{0}, size_t{1}, size_t{2}, size_t{31}, size_t{33},
+                     size_t{1000}, size_t{30001}}) {
+    TestSortStrings(num, SortAscending(), rng);
+    TestSortStrings(num, SortDescending(), rng);
+  }
+}
+
+template <typename Key, class Order>
+void TestTopK(size_t k, size_t num, std::mt19937_64& rng) {
+  std::vector<Key> keys = GenerateTiedKeys<Key>(num, rng);
+
+  StreamingTopK<Key, Order> top_k(k);
+  // Chunks of varying size, including empty and partial vectors.
+  std::uniform_int_distribution<size_t> chunk_dist(0, 700);
+  for (size_t pos = 0; pos < num;) {
+    const size_t max_chunk = chunk_dist(rng);
+    const size_t chunk = HWY_MIN(max_chunk, num - pos);
+    top_k.Add(keys.data() + pos, chunk);
+    pos += chunk;
+  }
+  std::vector<Key> actual(k + 1);
+  const size_t num_actual = top_k.TopK(actual.data());
+  HWY_ASSERT_EQ(HWY_MIN(k, num), num_actual);
+
+  VQSort(keys.data(), num, Order());
+  for (size_t i = 0; i < num_actual; ++i) {
+    // Compare only keys because the values of equal keys may differ.
+    if (!SameKey<Order>(actual[i], keys[i])) {
+      HWY_ABORT("TopK %s k=%zu of %zu: mismatch at %zu\n",
+                OrderString<Order>(), k, num, i);
+    }
+  }
+}
+
+template <typename Key>
+void TestTopKKey(std::mt19937_64& rng) {
+  for (size_t k : {size_t{0}, size_t{1}, size_t{5}, size_t{300},
+                   size_t{2000}}) {
+    for (size_t num : {size_t{0}, size_t{3}, size_t{1000}, size_t{50000}}) {
+      TestTopK<Key, SortAscending>(k, num, rng);
+      TestTopK<Key, SortDescending>(k, num, rng);
+    }
+  }
+}
+
+void TestAllTopK() {
+  std::mt19937_64 rng(12345);
+  TestTopKKey<uint16_t>(rng);
+  TestTopKKey<int32_t>(rng);
+  TestTopKKey<uint64_t>(rng);
+  TestTopKKey<float>(rng);
+#if HWY_HAVE_FLOAT64
+  if (hwy::HaveFloat64()) {
+    TestTopKKey<double>(rng);
+  }
+#endif
+  TestTopKKey<K32V32>(rng);
+}
+
+template <typename Key, class Order>
+void VerifyUnique(const char* caption, const std::vector<Key>& expected,
+                  const std::vector<size_t>& expected_counts,
+                  const std::vector<Key>& actual,
+                  const std::vector<size_t>& counts, size_t num_unique) {
+  HWY_ASSERT_EQ(expected.size(), num_unique);
+  for (size_t i = 0; i < num_unique; ++i) {
+    if (memcmp(&expected[i], &actual[i], sizeof(Key)) != 0 ||
+        expected_counts[i] != counts[i]) {
+      HWY_ABORT("%s %s %zu: mismatch at %zu, count %zu expected %zu\n",
+                caption, OrderString<Order>(), expected.size(), i, counts[i],
+                expected_counts[i]);
+    }
+  }
+}
+
+template <typename Key, class Order>
+void TestUnique(size_t num, Order order, std::mt19937_64& rng) {
+  std::vector<Key> keys = GenerateTiedKeys<Key>(num, rng);
+
+  // For key-value types, only the keys are compared.
+  const auto equal = [](const Key& a, const Key& b) HWY_ATTR {
+    return SameKey<Order>(a, b);
+  };
+  std::vector<Key> expected = keys;
+  VQSort(expected.data(), num, order);
+  std::vector<size_t> expected_counts;
+  for (size_t i = 0; i < num; ++i) {
+    if (i == 0 || !equal(expected[i - 1], expected[i])) {
+      expected_counts.push_back(0);
+    }
+    ++expected_counts.back();
+  }
+  std::vector<Key> sorted = expected;
+  expected.erase(std::unique(expected.begin(), expected.end(), equal),
+                 expected.end());
+
+  std::vector<size_t> counts(num);
+  const size_t num_unique = VQUniqueStatic(sorted.data(), num, counts.data());
+  VerifyUnique<Key, Order>("Unique", expected, expected_counts, sorted, counts,
+                           num_unique);
+
+  const size_t num_sort_unique =
+      VQSortUniqueStatic(keys.data(), num, order, counts.data());
+  VerifyUnique<Key, Order>("SortUnique", expected, expected_counts, keys,
+                           counts, num_sort_unique);
+}
+
+template <typename Key>
+void TestUniqueKey(std::mt19937_64& rng) {
+  // Keys are less than 1000, hence larger inputs have duplicates.
+  for (size_t num : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{100},
+                     size_t{1000}, size_t{5000}, size_t{50000}}) {
+    TestUnique<Key>(num, SortAscending(), rng);
+    TestUnique<Key>(num, SortDescending(), rng);
+  }
+}
+
+void TestAllUnique() {
+  std::mt19937_64 rng(12345);
+  TestUniqueKey<uint16_t>(rng);
+  TestUniqueKey<int32_t>(rng);
+  TestUniqueKey<uint64_t>(rng);
+  TestUniqueKey<float>(rng);
+#if HWY_HAVE_FLOAT64
+  if (hwy::HaveFloat64()) {
+    TestUniqueKey<double>(rng);
+  }
+#endif
+  TestUniqueKey<K32V32>(rng);
+#if HWY_TARGET != HWY_SCALAR
+  TestUniqueKey<uint128_t>(rng);
+  TestUniqueKey<K64V64>(rng);
+#endif
+}
+
+template <typename Key, class Order>
+void TestMultiSelect(size_t num, const std::vector<size_t>& ks, Order order,
+                     std::mt19937_64& rng) {
+  std::vector<Key> keys = GenerateTiedKeys<Key>(num, rng);
+  std::vector<Key> sorted = keys;
+  VQSort(sorted.data(), num, order);
+
+  VQMultiSelectStatic(keys.data(), num, ks.data(), ks.size(), order);
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const auto lanes = [](const Key& key) {
+    return reinterpret_cast<const LaneType*>(&key);
+  };
+  for (size_t i = 0; i < ks.size(); ++i) {
+    const size_t k = ks[i];
+    // Compare only keys because the values of equal keys may differ.
+    if (!SameKey<Order>(keys[k], sorted[k])) {
+      HWY_ABORT("MultiSelect %s num %zu: mismatch at k=%zu\n",
+                OrderString<Order>(), num, k);
+    }
+    // Keys before k are not after it, and keys after k are not before it.
+    const size_t begin = (i == 0) ? 0 : ks[i - 1];
+    const size_t end = (i + 1 == ks.size()) ? num : ks[i + 1];
+    for (size_t j = begin; j < end; ++j) {
+      const bool wrong_side =
+          j < k ? st.Compare1(lanes(keys[k]), lanes(keys[j]))
+                : st.Compare1(lanes(keys[j]), lanes(keys[k]));
+      if (wrong_side) {
+        HWY_ABORT("MultiSelect %s num %zu: %zu on wrong side of k=%zu\n",
+                  OrderString<Order>(), num, j, k);
+      }
+    }
+  }
+}
+
+template <typename Key>
+void TestMultiSelectKey(std::mt19937_64& rng) {
+  for (size_t num : {size_t{1}, size_t{2}, size_t{100}, size_t{1000},
+                     size_t{50000}}) {
+    // Percentiles, including duplicates and the first and last key.
+    std::vector<size_t> ks;
+    for (double q : {0.0, 0.5, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+      ks.push_back(HWY_MIN(static_cast<size_t>(q * static_cast<double>(num)),
+                           num - 1));
+    }
+    TestMultiSelect<Key>(num, ks, SortAscending(), rng);
+    TestMultiSelect<Key>(num, ks, SortDescending(), rng);
+
+    std::vector<size_t> all_ks(num);
+    std::iota(all_ks.begin(), all_ks.end(), size_t{0});
+    TestMultiSelect<Key>(num, all_ks, SortAscending(), rng);
+    TestMultiSelect<Key>(num, std::vector<size_t>(), SortAscending(), rng);
+  }
+}
+
+void TestAllMultiSelect() {
+  std::mt19937_64 rng(12345);
+  TestMultiSelectKey<uint16_t>(rng);
+  TestMultiSelectKey<int32_t>(rng);
+  TestMultiSelectKey<uint64_t>(rng);
+  TestMultiSelectKey<float>(rng);
+#if HWY_HAVE_FLOAT64
+  if (hwy::HaveFloat64()) {
+    TestMultiSelectKey<double>(rng);
+  }
+#endif
+  TestMultiSelectKey<K32V32>(rng);
+#if HWY_TARGET != HWY_SCALAR
+  TestMultiSelectKey<uint128_t>(rng);
+  TestMultiSelectKey<K64V64>(rng);
+#endif
+}
+
+template <typename Key, class Order>
+void TestSortExternal(size_t num_keys, size_t buf_keys, Order order,
+                      std::mt19937_64& rng) {
+  std::vector<Key> keys = GenerateTiedKeys<Key>(num_keys, rng);
+  FILE* in = tmpfile();
+  FILE* out = tmpfile();
+  HWY_ASSERT(in != nullptr && out != nullptr);
+  HWY_ASSERT(fwrite(keys.data(), sizeof(Key), num_keys, in) == num_keys);
+  rewind(in);
+
+  auto buf = hwy::AllocateAligned<Key>(buf_keys);
+  HWY_ASSERT(buf);
+  HWY_ASSERT(VQSortExternal(in, out, buf.get(), buf_keys, order));
+  VQSort(keys.data(), num_keys, order);
+
+  // One more than expected, to detect excess output.
+  std::vector<Key> actual(num_keys + 1);
+  rewind(out);
+  HWY_ASSERT(fread(actual.data(), sizeof(Key), num_keys + 1, out) == num_keys);
+  for (size_t i = 0; i < num_keys; ++i) {
+    if (memcmp(&actual[i], &keys[i], sizeof(Key)) != 0) {
+      HWY_ABORT("External %s %zu keys, buf %zu: mismatch at %zu\n",
+                OrderString<Order>(), num_keys, buf_keys, i);
+    }
+  }
+  fclose(in);
+  fclose(out);
+}
+
+template <typename Key>
+void TestSortExternalKey(std::mt19937_64& rng) {
+  // The minimum buffer size results in two-way merges and thus several passes.
+  const size_t buf_keys = (64 * 1024) / sizeof(Key);
+  for (size_t num_keys : {size_t{0}, size_t{1}, size_t{5000}, buf_keys,
+                          buf_keys + 1, 9 * buf_keys + 7}) {
+    TestSortExternal<Key>(num_keys, buf_keys, SortAscending(), rng);
+    TestSortExternal<Key>(num_keys, buf_keys, SortDescending(), rng);
+  }
+}
+
+// Invalid arguments or input are reported via the return value.
+void TestSortExternalErrors() {
+  const size_t buf_keys = (64 * 1024) / sizeof(uint32_t);
+  auto buf = hwy::AllocateAligned<uint32_t>(buf_keys);
+  HWY_ASSERT(buf);
+  FILE* in = tmpfile();
+  FILE* out = tmpfile();
+  HWY_ASSERT(in != nullptr && out != nullptr);
+  const uint32_t keys[3] = {3, 1, 2};
+  HWY_ASSERT(fwrite(keys, sizeof(keys), 1, in) == 1);
+
+  // Buffer below the 64 KiB minimum: input is not read.
+  rewind(in);
+  HWY_ASSERT(!VQSortExternal(in, out, buf.get(), buf_keys - 1,
+                             SortAscending()));
+  HWY_ASSERT(ftell(in) == 0);
+
+  // Whole keys are accepted.
+  HWY_ASSERT(VQSortExternal(in, out, buf.get(), buf_keys, SortAscending()));
+
+  // Input ending with a partial key.
+  const uint8_t partial = 0;
+  HWY_ASSERT(fseek(in, 0, SEEK_END) == 0);
+  HWY_ASSERT(fwrite(&partial, 1, 1, in) == 1);
+  rewind(in);
+  HWY_ASSERT(!VQSortExternal(in, out, buf.get(), buf_keys, SortAscending()));
+
+  fclose(in);
+  fclose(out);
+}
+
+// NaN are not supported by the merge, hence handled separately.
+template <class Order>
+void TestSortExternalNaN(Order order, std::mt19937_64& rng) {
+  const size_t num_keys = 200000;
+  const size_t num_nan = 200;
+  const size_t buf_keys = 16384;  // several runs and merge passes
+  std::vector<float> keys = GenerateTiedKeys<float>(num_keys, rng);
+  for (size_t i = 0; i < num_nan; ++i) {
+    keys[rng() % num_keys] = GetLane(NaN(ScalableTag<float>()));
+  }
+  const size_t actual_nan = static_cast<size_t>(
+      std::count_if(keys.begin(), keys.end(),
+                    [](float key) { return ScalarIsNaN(key); }));
+  FILE* in = tmpfile();
+  FILE* out = tmpfile();
+  HWY_ASSERT(in != nullptr && out != nullptr);
+  HWY_ASSERT(fwrite(keys.data(), sizeof(float), num_keys, in) == num_keys);
+  rewind(in);
+
+  auto buf = hwy::AllocateAligned<float>(buf_keys);
+  HWY_ASSERT(buf);
+  HWY_ASSERT(VQSortExternal(in, out, buf.get(), buf_keys, order));
+  VQSort(keys.data(), num_keys, order);  // NaN are last for both orders
+
+  std::vector<float> actual(num_keys + 1);
+  rewind(out);
+  HWY_ASSERT(fread(actual.data(), sizeof(float), num_keys + 1, out) ==
+             num_keys);
+  const size_t num_numbers = num_keys - actual_nan;
+  for (size_t i = 0; i < num_keys; ++i) {
+    const bool ok = i < num_numbers
+                        ? memcmp(&actual[i], &keys[i], sizeof(float)) == 0
+                        : ScalarIsNaN(actual[i]);
+    if (!ok) {
+      HWY_ABORT("External NaN %s: mismatch at %zu\n", OrderString<Order>(),
+                i);
+    }
+  }
+  fclose(in);
+  fclose(out);
+}
+
+void TestAllSortExternal() {
+  TestSortExternalErrors();
+
+  std::mt19937_64 rng(12345);
+  TestSortExternalKey<uint16_t>(rng);
+  TestSortExternalKey<int32_t>(rng);
+  TestSortExternalKey<float>(rng);
+  if (hwy::HaveFloat64()) {
+    TestSortExternalKey<double>(rng);
+  }
+  TestSortExternalKey<K32V32>(rng);
+#if HWY_TARGET != HWY_SCALAR
+  TestSortExternalKey<uint128_t>(rng);
+  TestSortExternalKey<K64V64>(rng);
+#endif
+  TestSortExternalNaN(SortAscending(), rng);
+  TestSortExternalNaN(SortDescending(), rng);
+
+  // Larger buffer: 16 runs exceed the fan-in of 13, hence two passes.
+  const size_t buf_keys = (1 << 20) / sizeof(uint64_t);
+  TestSortExternal<uint64_t>(16 * buf_keys, buf_keys, SortAscending(), rng);
+}
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -265,7 +996,20 @@ HWY_BEFORE_TEST(SortTest);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortIota);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllSort);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllSelect);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortPresorted);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortedTail);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllPartialSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortParallel);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortRadix);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllArgSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllMerge);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllStableSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortRecords);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortStrings);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllTopK);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllUnique);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllMultiSelect);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortExternal);
 HWY_AFTER_TEST();
 }  // namespace
 }  // namespace hwy
@@ -33,6 +33,7 @@
 #include "hwy/contrib/sort/algo-inl.h"
 #include "hwy/contrib/sort/result-inl.h"
 #include "hwy/contrib/sort/traits128-inl.h"
+#include "hwy/contrib/sort/vqradix-inl.h"
 #include "hwy/contrib/sort/vqsort-inl.h"  // BaseCase
 #include "hwy/print-inl.h"
 #include "hwy/tests/test_util-inl.h"
@@ -52,6 +53,51 @@ using detail::OrderDescending128;
 using detail::Traits128;
 #endif  // !HAVE_INTEL && HWY_TARGET != HWY_SCALAR
 
+// Radix sort converts keys to unsigned integers; verify special float values
+// including signed zero and NaN, which are moved to the back.
+struct TestRadixFloatSpecial {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T, D d) {
+    using TU = MakeUnsigned<T>;
+    // Flips the sign bit; unary minus is not available for all T.
+    const auto neg = [](T x) {
+      return BitCastScalar<T>(static_cast<TU>(BitCastScalar<TU>(x) ^
+                                              SignMask<T>()));
+    };
+    const T inf = GetLane(Inf(d));
+    const T nan = GetLane(NaN(d));
+    const T one = ConvertScalarTo<T>(1);
+    const T zero = ConvertScalarTo<T>(0);
+    const T max = hwy::HighestValue<T>();
+    // Ascending order, except for NaN.
+    const T expected[9] = {neg(inf), neg(max), neg(one), neg(zero), zero,
+                           one,      max,      inf,      nan};
+    // Scrambled, with NaN not at the end.
+    const size_t kPerm[9] = {5, 8, 1, 7, 3, 0, 6, 4, 2};
+    T keys[9];
+
+    for (size_t i = 0; i < 9; ++i) keys[i] = expected[kPerm[i]];
+    VQRadixSortStatic(keys, 9, SortAscending());
+    for (size_t i = 0; i < 8; ++i) {
+      HWY_ASSERT(BitCastScalar<TU>(keys[i]) ==
+                 BitCastScalar<TU>(expected[i]));
+    }
+    HWY_ASSERT(ScalarIsNaN(keys[8]));
+
+    for (size_t i = 0; i < 9; ++i) keys[i] = expected[kPerm[i]];
+    VQRadixSortStatic(keys, 9, SortDescending());
+    for (size_t i = 0; i < 8; ++i) {
+      HWY_ASSERT(BitCastScalar<TU>(keys[i]) ==
+                 BitCastScalar<TU>(expected[7 - i]));
+    }
+    HWY_ASSERT(ScalarIsNaN(keys[8]));
+  }
+};
+
+HWY_NOINLINE void TestAllRadixFloatSpecial() {
+  ForFloatTypesDynamic(ForGEVectors<128, TestRadixFloatSpecial>());
+}
+
 #if VQSORT_ENABLED || HWY_IDE
 
 // Verify the corner cases of LargerSortValue/SmallerSortValue, used to
@@ -558,6 +604,7 @@ HWY_EXPORT_AND_TEST_P(SortTest, TestAllMedian);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllBaseCase);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllPartition);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllGenerator);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllRadixFloatSpecial);
 HWY_AFTER_TEST();
 }  // namespace
 }  // namespace hwy
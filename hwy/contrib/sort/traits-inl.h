@@ -152,6 +152,71 @@ Vec<D> SmallerSortValue(D d, Vec<D> v) {
   return Sub(v, Set(d, TFromD<D>{1}));
 }
 
+// Order-preserving bijection between the bits of keys of type `T` and unsigned
+// integers, used by radix sort and argsort: comparing the results as unsigned
+// integers is equivalent to `OrderAscending<T>`, except that -0 < +0 and NaN
+// are ordered by their sign and payload. Uses only integer ops, hence also
+// works for f16/f64 on targets without native support for them.
+template <typename T, class DU, HWY_IF_UNSIGNED(T)>
+Vec<DU> OrderedBitsFromKeyBits(DU /* tag */, Vec<DU> bits) {
+  return bits;
+}
+template <typename T, class DU, HWY_IF_UNSIGNED(T)>
+Vec<DU> KeyBitsFromOrderedBits(DU /* tag */, Vec<DU> bits) {
+  return bits;
+}
+
+// Two's complement: flipping the sign bit maps LowestValue to zero.
+template <typename T, class DU, HWY_IF_SIGNED(T)>
+Vec<DU> OrderedBitsFromKeyBits(DU du, Vec<DU> bits) {
+  return Xor(bits, SignBit(du));
+}
+template <typename T, class DU, HWY_IF_SIGNED(T)>
+Vec<DU> KeyBitsFromOrderedBits(DU du, Vec<DU> bits) {
+  return Xor(bits, SignBit(du));
+}
+
+// Sign-magnitude: flip all bits of negative values so that larger magnitudes
+// become smaller, and only the sign bit of non-negative values.
+template <typename T, class DU, HWY_IF_FLOAT_OR_SPECIAL(T)>
+Vec<DU> OrderedBitsFromKeyBits(DU du, Vec<DU> bits) {
+  const RebindToSigned<DU> di;
+  const Vec<DU> neg = BitCast(du, BroadcastSignBit(BitCast(di, bits)));
+  return Xor(bits, Or(neg, SignBit(du)));
+}
+template <typename T, class DU, HWY_IF_FLOAT_OR_SPECIAL(T)>
+Vec<DU> KeyBitsFromOrderedBits(DU du, Vec<DU> bits) {
+  const RebindToSigned<DU> di;
+  // The sign bit is clear iff the key was negative.
+  const Vec<DU> neg = BitCast(du, BroadcastSignBit(BitCast(di, Not(bits))));
+  return Xor(bits, Or(neg, SignBit(du)));
+}
+
+// Returns unsigned integers whose order is the requested `Order`
+// (SortAscending or SortDescending) of the keys of type `T` whose bits are
+// given. As in VQSort, NaN are mapped to the largest integer, i.e. sorted to
+// the back regardless of the order.
+template <typename T, class Order, class DU, HWY_IF_FLOAT_OR_SPECIAL(T)>
+Vec<DU> SortableBitsFromKeyBits(DU du, Vec<DU> bits) {
+  const Vec<DU> exp_mask = Set(du, ExponentMask<T>());
+  const Mask<DU> is_nan = Gt(AndNot(SignBit(du), bits), exp_mask);
+  bits = OrderedBitsFromKeyBits<T>(du, bits);
+  if (!Order::IsAscending()) bits = Not(bits);
+  return IfThenElse(is_nan, Set(du, LimitsMax<TFromD<DU>>()), bits);
+}
+template <typename T, class Order, class DU, HWY_IF_NOT_FLOAT_NOR_SPECIAL(T)>
+Vec<DU> SortableBitsFromKeyBits(DU du, Vec<DU> bits) {
+  bits = OrderedBitsFromKeyBits<T>(du, bits);
+  return Order::IsAscending() ? bits : Not(bits);
+}
+// Inverse of SortableBitsFromKeyBits. NaN are returned as a NaN, not
+// necessarily with their original sign and payload.
+template <typename T, class Order, class DU>
+Vec<DU> KeyBitsFromSortableBits(DU du, Vec<DU> bits) {
+  return KeyBitsFromOrderedBits<T>(du,
+                                   Order::IsAscending() ? bits : Not(bits));
+}
+
 // Highway does not provide a lane type for 128-bit keys, so we use uint64_t
 // along with an abstraction layer for single-lane vs. lane-pair, which is
 // independent of the order.
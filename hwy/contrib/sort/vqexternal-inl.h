@@ -0,0 +1,290 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_VQEXTERNAL_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_VQEXTERNAL_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_VQEXTERNAL_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_VQEXTERNAL_TOGGLE
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"         // SortAscending
+#include "hwy/contrib/sort/vqmerge-inl.h"   // MergeStep
+#include "hwy/contrib/sort/vqsort-inl.h"    // VQSortStatic
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+// Runs and the output are read/written in chunks of at least this many bytes
+// to amortize the cost of I/O calls. This is also the minimum buffer size.
+constexpr size_t kExternalChunkBytes = 64 * 1024;
+
+// A sorted run in a temporary file.
+struct ExternalRun {
+  FILE* file;
+  uint64_t num_lanes;  // not yet read
+};
+
+// Returns the number of runs to merge at once given a buffer of `buf_lanes`.
+// Each run and the output receive a chunk of at least kExternalChunkBytes, and
+// each internal node of the merge tree its MergeBufLanes.
+template <typename T>
+size_t MaxExternalFanIn(size_t buf_lanes) {
+  constexpr size_t kChunk = kExternalChunkBytes / sizeof(T);
+  constexpr size_t kNode = MergeBufLanes<T>();
+  // (k + 1) * kChunk + (k - 1) * kNode <= buf_lanes.
+  const size_t k = (buf_lanes + kNode - HWY_MIN(buf_lanes, kChunk)) /
+                   (kChunk + kNode);
+  return HWY_MAX(k, size_t{2});
+}
+
+// Refills leaf `idx` of the merge tree from the corresponding run.
+template <typename T>
+struct RefillFromRuns {
+  void operator()(size_t idx, MergeNode<T>& leaf) const {
+    ExternalRun& run = runs[idx];
+    const size_t num =
+        static_cast<size_t>(HWY_MIN(run.num_lanes, uint64_t{chunk_lanes}));
+    if (fread(leaf.buf, sizeof(T), num, run.file) != num) {
+      *ok = false;
+      run.num_lanes = 0;
+      leaf.num = 0;
+      leaf.done = true;
+      return;
+    }
+    run.num_lanes -= num;
+    leaf.keys = leaf.buf;
+    leaf.num = num;
+    leaf.done = run.num_lanes == 0;
+  }
+
+  ExternalRun* runs;
+  size_t chunk_lanes;
+  bool* ok;
+};
+
+// Merges `num_runs` >= 2 runs, whose files must be positioned at their start,
+// and appends the result to `out`. `buf` is the only memory used for keys; it
+// must have room for a chunk per run, one for the output, plus the buffers of
+// the internal nodes (see MaxExternalFanIn). Returns false if I/O failed.
+template <class D, class Traits, typename T>
+bool MergeExternalRuns(D d, Traits st, ExternalRun* runs, size_t num_runs,
+                       FILE* out, T* HWY_RESTRICT buf, size_t buf_lanes) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  constexpr size_t kNode = MergeBufLanes<T>();
+  HWY_DASSERT(num_runs >= 2);
+  size_t chunk_lanes = (buf_lanes - (num_runs - 1) * kNode) / (num_runs + 1);
+  chunk_lanes -= chunk_lanes % kLPK;
+  HWY_DASSERT(chunk_lanes >= kNode);
+
+  std::vector<MergeNode<T>> nodes;
+  nodes.reserve(2 * num_runs - 1);
+  T* next_buf = buf;
+  for (size_t i = 0; i < num_runs; ++i) {
+    MergeNode<T> leaf = {nullptr, 0,        runs[i].num_lanes == 0,
+                         true,    next_buf, {0, 0}};
+    nodes.push_back(leaf);
+    next_buf += chunk_lanes;
+  }
+  T* HWY_RESTRICT out_buf = next_buf;
+  next_buf += chunk_lanes;
+  const size_t root = BuildMergeTree(nodes, 0, num_runs, next_buf);
+
+  bool ok = true;
+  const RefillFromRuns<T> refill = {runs, chunk_lanes, &ok};
+  size_t num_out = 0;
+  for (;;) {
+    const size_t num = MergeStep(d, st, nodes, root, out_buf + num_out, refill);
+    num_out += num;
+    // Flush if the next step might not fit.
+    if (num == 0 || num_out + kNode > chunk_lanes) {
+      if (fwrite(out_buf, sizeof(T), num_out, out) != num_out) return false;
+      num_out = 0;
+    }
+    if (num == 0) return ok;
+  }
+}
+
+// Copies a single run to `out` via `buf`.
+template <typename T>
+bool CopyExternalRun(ExternalRun& run, FILE* out, T* HWY_RESTRICT buf,
+                     size_t buf_lanes) {
+  while (run.num_lanes != 0) {
+    const size_t num =
+        static_cast<size_t>(HWY_MIN(run.num_lanes, uint64_t{buf_lanes}));
+    if (fread(buf, sizeof(T), num, run.file) != num) return false;
+    if (fwrite(buf, sizeof(T), num, out) != num) return false;
+    run.num_lanes -= num;
+  }
+  return true;
+}
+
+// Appends `num_nan` NaN to `out` via `buf`.
+template <class D, typename T>
+bool WriteExternalNaN(D d, uint64_t num_nan, FILE* out, T* HWY_RESTRICT buf,
+                      size_t buf_lanes) {
+  Fill(d, GetLane(NaN(d)),
+       static_cast<size_t>(HWY_MIN(num_nan, uint64_t{buf_lanes})), buf);
+  while (num_nan != 0) {
+    const size_t num =
+        static_cast<size_t>(HWY_MIN(num_nan, uint64_t{buf_lanes}));
+    if (fwrite(buf, sizeof(T), num, out) != num) return false;
+    num_nan -= num;
+  }
+  return true;
+}
+
+// Reads all keys from `in`, sorts runs of `buf_keys` keys with `sort` and
+// writes them to temporary files, then merges them into `out`, in multiple
+// passes if there are more runs than MaxExternalFanIn. Returns false if the
+// buffer is too small, the input ends with a partial key, or I/O failed.
+//
+// MergeStep does not support NaN. As in VQSort, they are replaced with a
+// sentinel that sorts last. The sentinels are then dropped from each run, and
+// the total number of NaN is appended to the output.
+template <typename Key, class Order, class Sort>
+bool SortExternal(FILE* in, FILE* out, Key* HWY_RESTRICT buf,
+                  const size_t buf_keys, Order, const Sort& sort) {
+  const MakeTraits<Key, Order> st;
+  using Traits = decltype(st);
+  using LaneType = typename Traits::LaneType;
+  constexpr size_t kLPK = st.LanesPerKey();
+  const MergeTag<LaneType, kLPK> d;
+  const SortTag<LaneType> d_nan;
+  if (buf_keys < kExternalChunkBytes / sizeof(Key)) return false;
+
+  LaneType* HWY_RESTRICT lanes = reinterpret_cast<LaneType*>(buf);
+  const size_t buf_lanes = buf_keys * kLPK;
+  std::vector<ExternalRun> runs;
+  uint64_t num_nan = 0;
+  bool ok = true;
+  for (;;) {
+    // Read bytes rather than keys because fread would otherwise silently
+    // consume a trailing partial key.
+    const size_t bytes = fread(buf, 1, buf_keys * sizeof(Key), in);
+    if (bytes % sizeof(Key) != 0) {
+      ok = false;
+      break;
+    }
+    const size_t num = bytes / sizeof(Key);
+    if (num == 0) break;
+    // Only float keys can be NaN, and those have one lane per key.
+    const size_t run_nan = CountAndReplaceNaN(d_nan, st, lanes, num * kLPK);
+    sort(buf, num);
+    // All keys fit into the buffer: no need for temporary files.
+    if (runs.empty() && num < buf_keys) {
+      if (run_nan != 0) {
+        Fill(d_nan, GetLane(NaN(d_nan)), run_nan, lanes + num - run_nan);
+      }
+      return fwrite(buf, sizeof(Key), num, out) == num && !ferror(in);
+    }
+    num_nan += run_nan;
+    const size_t num_sorted = num - run_nan;  // sentinels are last
+    FILE* file = tmpfile();
+    if (file == nullptr) {
+      ok = false;
+      break;
+    }
+    runs.push_back(ExternalRun{file, uint64_t{num_sorted} * kLPK});
+    if (fwrite(buf, sizeof(Key), num_sorted, file) != num_sorted) {
+      ok = false;
+      break;
+    }
+    if (num < buf_keys) break;
+  }
+  if (ferror(in)) ok = false;
+
+  const size_t max_fan_in = MaxExternalFanIn<LaneType>(buf_lanes);
+  // Each pass merges groups of up to `max_fan_in` runs into the next pass's
+  // runs. The last pass writes to `out`.
+  while (ok && !runs.empty()) {
+    const bool last = runs.size() <= max_fan_in;
+    std::vector<ExternalRun> merged;
+    for (size_t i = 0; ok && i < runs.size(); i += max_fan_in) {
+      const size_t num_runs = HWY_MIN(max_fan_in, runs.size() - i);
+      if (num_runs == 1 && !last) {  // Carry over to the next pass.
+        merged.push_back(runs[i]);
+        runs[i].file = nullptr;
+        continue;
+      }
+      FILE* dest = last ? out : tmpfile();
+      if (dest == nullptr) {
+        ok = false;
+        break;
+      }
+      uint64_t total_lanes = 0;
+      for (size_t r = i; r < i + num_runs; ++r) {
+        rewind(runs[r].file);
+        total_lanes += runs[r].num_lanes;
+      }
+      ok = (num_runs == 1)
+               ? CopyExternalRun(runs[i], dest, lanes, buf_lanes)
+               : MergeExternalRuns(d, st, runs.data() + i, num_runs, dest,
+                                   lanes, buf_lanes);
+      for (size_t r = i; r < i + num_runs; ++r) {
+        fclose(runs[r].file);
+        runs[r].file = nullptr;
+      }
+      if (!last) {
+        merged.push_back(ExternalRun{dest, total_lanes});
+      }
+    }
+    for (ExternalRun& run : runs) {
+      if (run.file != nullptr) fclose(run.file);
+    }
+    runs.swap(merged);
+    if (last) break;
+  }
+
+  for (ExternalRun& run : runs) {
+    if (run.file != nullptr) fclose(run.file);
+  }
+  if (ok && num_nan != 0) {
+    ok = WriteExternalNaN(d_nan, num_nan, out, lanes, buf_lanes);
+  }
+  return ok;
+}
+
+}  // namespace detail
+
+// Simpler interface matching VQSortExternal(), but without dynamic dispatch.
+// Supports the same key types as VQSortStatic.
+template <typename Key, class Order>
+bool VQSortExternalStatic(FILE* in, FILE* out, Key* HWY_RESTRICT buf,
+                          const size_t buf_keys, Order order) {
+  return detail::SortExternal(in, out, buf, buf_keys, order,
+                              [order](Key* keys, size_t num_keys) {
+                                VQSortStatic(keys, num_keys, order);
+                              });
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQEXTERNAL_TOGGLE
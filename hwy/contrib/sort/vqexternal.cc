@@ -0,0 +1,425 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/sort/vqexternal.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "hwy/contrib/sort/vqsort.h"
+
+#undef HWY_TARGET_INCLUDE
+// clang-format off
+// (avoid line break, which would prevent Copybara rules from matching)
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqexternal.cc"  //NOLINT
+// clang-format on
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqexternal-inl.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+// Runs are sorted via the dynamically dispatched VQSort because VQSortStatic
+// is expensive to compile for all key types and targets. Only the merge is
+// compiled here.
+template <class Order>
+struct SortRun {
+  template <typename Key>
+  void operator()(Key* HWY_RESTRICT keys, size_t num_keys) const {
+    VQSort(keys, num_keys, Order());
+  }
+};
+
+bool SortExternalU16Asc(FILE* in, FILE* out, uint16_t* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+}
+
+bool SortExternalU16Desc(FILE* in, FILE* out, uint16_t* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+}
+
+bool SortExternalU32Asc(FILE* in, FILE* out, uint32_t* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+}
+
+bool SortExternalU32Desc(FILE* in, FILE* out, uint32_t* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+}
+
+bool SortExternalU64Asc(FILE* in, FILE* out, uint64_t* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+}
+
+bool SortExternalU64Desc(FILE* in, FILE* out, uint64_t* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+}
+
+bool SortExternalI16Asc(FILE* in, FILE* out, int16_t* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+}
+
+bool SortExternalI16Desc(FILE* in, FILE* out, int16_t* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+}
+
+bool SortExternalI32Asc(FILE* in, FILE* out, int32_t* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+}
+
+bool SortExternalI32Desc(FILE* in, FILE* out, int32_t* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+}
+
+bool SortExternalI64Asc(FILE* in, FILE* out, int64_t* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+}
+
+bool SortExternalI64Desc(FILE* in, FILE* out, int64_t* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+}
+
+bool SortExternalF16Asc(FILE* in, FILE* out, float16_t* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+#if HWY_HAVE_FLOAT16
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+#else
+  (void)in;
+  (void)out;
+  (void)buf;
+  (void)buf_keys;
+  HWY_ASSERT(0);
+  return false;
+#endif
+}
+
+bool SortExternalF16Desc(FILE* in, FILE* out, float16_t* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+#if HWY_HAVE_FLOAT16
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+#else
+  (void)in;
+  (void)out;
+  (void)buf;
+  (void)buf_keys;
+  HWY_ASSERT(0);
+  return false;
+#endif
+}
+
+bool SortExternalF32Asc(FILE* in, FILE* out, float* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+}
+
+bool SortExternalF32Desc(FILE* in, FILE* out, float* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+}
+
+bool SortExternalF64Asc(FILE* in, FILE* out, double* HWY_RESTRICT buf,
+                        const size_t buf_keys) {
+#if HWY_HAVE_FLOAT64
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+#else
+  (void)in;
+  (void)out;
+  (void)buf;
+  (void)buf_keys;
+  HWY_ASSERT(0);
+  return false;
+#endif
+}
+
+bool SortExternalF64Desc(FILE* in, FILE* out, double* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+#if HWY_HAVE_FLOAT64
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+#else
+  (void)in;
+  (void)out;
+  (void)buf;
+  (void)buf_keys;
+  HWY_ASSERT(0);
+  return false;
+#endif
+}
+
+bool SortExternalKV64Asc(FILE* in, FILE* out, K32V32* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+}
+
+bool SortExternalKV64Desc(FILE* in, FILE* out, K32V32* HWY_RESTRICT buf,
+                          const size_t buf_keys) {
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+}
+
+bool SortExternalU128Asc(FILE* in, FILE* out, uint128_t* HWY_RESTRICT buf,
+                         const size_t buf_keys) {
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+#else
+  (void)in;
+  (void)out;
+  (void)buf;
+  (void)buf_keys;
+  HWY_ASSERT(0);
+  return false;
+#endif
+}
+
+bool SortExternalU128Desc(FILE* in, FILE* out, uint128_t* HWY_RESTRICT buf,
+                          const size_t buf_keys) {
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+#else
+  (void)in;
+  (void)out;
+  (void)buf;
+  (void)buf_keys;
+  HWY_ASSERT(0);
+  return false;
+#endif
+}
+
+bool SortExternalKV128Asc(FILE* in, FILE* out, K64V64* HWY_RESTRICT buf,
+                          const size_t buf_keys) {
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return detail::SortExternal(in, out, buf, buf_keys, SortAscending(),
+                              SortRun<SortAscending>());
+#else
+  (void)in;
+  (void)out;
+  (void)buf;
+  (void)buf_keys;
+  HWY_ASSERT(0);
+  return false;
+#endif
+}
+
+bool SortExternalKV128Desc(FILE* in, FILE* out, K64V64* HWY_RESTRICT buf,
+                           const size_t buf_keys) {
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return detail::SortExternal(in, out, buf, buf_keys, SortDescending(),
+                              SortRun<SortDescending>());
+#else
+  (void)in;
+  (void)out;
+  (void)buf;
+  (void)buf_keys;
+  HWY_ASSERT(0);
+  return false;
+#endif
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(SortExternalU16Asc);
+HWY_EXPORT(SortExternalU16Desc);
+HWY_EXPORT(SortExternalU32Asc);
+HWY_EXPORT(SortExternalU32Desc);
+HWY_EXPORT(SortExternalU64Asc);
+HWY_EXPORT(SortExternalU64Desc);
+HWY_EXPORT(SortExternalI16Asc);
+HWY_EXPORT(SortExternalI16Desc);
+HWY_EXPORT(SortExternalI32Asc);
+HWY_EXPORT(SortExternalI32Desc);
+HWY_EXPORT(SortExternalI64Asc);
+HWY_EXPORT(SortExternalI64Desc);
+HWY_EXPORT(SortExternalF16Asc);
+HWY_EXPORT(SortExternalF16Desc);
+HWY_EXPORT(SortExternalF32Asc);
+HWY_EXPORT(SortExternalF32Desc);
+HWY_EXPORT(SortExternalF64Asc);
+HWY_EXPORT(SortExternalF64Desc);
+HWY_EXPORT(SortExternalKV64Asc);
+HWY_EXPORT(SortExternalKV64Desc);
+HWY_EXPORT(SortExternalU128Asc);
+HWY_EXPORT(SortExternalU128Desc);
+HWY_EXPORT(SortExternalKV128Asc);
+HWY_EXPORT(SortExternalKV128Desc);
+}  // namespace
+
+bool VQSortExternal(FILE* in, FILE* out, uint16_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalU16Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, uint16_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalU16Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, uint32_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalU32Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, uint32_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalU32Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, uint64_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalU64Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, uint64_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalU64Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, int16_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalI16Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, int16_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalI16Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, int32_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalI32Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, int32_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalI32Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, int64_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalI64Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, int64_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalI64Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, float16_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalF16Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, float16_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalF16Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, float* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalF32Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, float* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalF32Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, double* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalF64Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, double* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalF64Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, K32V32* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalKV64Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, K32V32* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalKV64Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, uint128_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalU128Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, uint128_t* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalU128Desc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, K64V64* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortAscending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalKV128Asc)(in, out, buf, buf_keys);
+}
+
+bool VQSortExternal(FILE* in, FILE* out, K64V64* HWY_RESTRICT buf,
+                    const size_t buf_keys, SortDescending) {
+  return HWY_DYNAMIC_DISPATCH(SortExternalKV128Desc)(in, out, buf, buf_keys);
+}
+
+}  // namespace hwy
+#endif  // HWY_ONCE
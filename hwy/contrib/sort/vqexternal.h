@@ -0,0 +1,129 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Interface to external-memory sorting with dynamic dispatch, for inputs that
+// do not fit in memory. For static dispatch, call VQSortExternalStatic in
+// vqexternal-inl.h.
+//
+// Runs of keys that fit into a caller-provided buffer are sorted with VQSort
+// and written to temporary files, which are then merged with the tournament
+// tree of VQMergeK, streaming chunks of each run from its file. The buffer is
+// the only memory used for keys, hence its size is the memory budget.
+
+#ifndef HIGHWAY_HWY_CONTRIB_SORT_VQEXTERNAL_H_
+#define HIGHWAY_HWY_CONTRIB_SORT_VQEXTERNAL_H_
+
+// IWYU pragma: begin_exports
+#include <stddef.h>
+#include <stdio.h>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"  // SortAscending
+// IWYU pragma: end_exports
+
+namespace hwy {
+
+// Reads keys from the binary stream `in` until its end, and writes them to
+// `out` in the given order. Keys are stored in native byte order without any
+// header. `buf` must have space for `buf_keys` keys. Larger buffers result in
+// fewer runs and merge passes. Temporary files are created via tmpfile().
+// Returns false without reading `in` if `buf_keys` keys occupy less than
+// 64 KiB. Also returns false if the size of `in` is not a multiple of the key
+// size, or if any I/O failed; `out` may then contain partial results. Like
+// VQSort, this is not stable, and NaN are sorted to the end for both orders.
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          uint16_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          uint16_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          uint32_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          uint32_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          uint64_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          uint64_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          int16_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          int16_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          int32_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          int32_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          int64_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          int64_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          float16_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          float16_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          float* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          float* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          double* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          double* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          K32V32* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          K32V32* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+
+// 128-bit types: `buf_keys` is still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          uint128_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          uint128_t* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          K64V64* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortAscending);
+HWY_CONTRIB_DLLEXPORT bool VQSortExternal(FILE* in, FILE* out,
+                                          K64V64* HWY_RESTRICT buf,
+                                          size_t buf_keys, SortDescending);
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQEXTERNAL_H_
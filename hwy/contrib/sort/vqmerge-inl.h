@@ -0,0 +1,422 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_VQMERGE_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_VQMERGE_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_VQMERGE_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_VQMERGE_TOGGLE
+#endif
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"       // SortAscending
+#include "hwy/contrib/sort/vqsort-inl.h"  // MakeTraits
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+// The vector merge below requires the number of keys per vector to be a
+// compile-time constant, and a bitonic half-cleaner for each power of two less
+// than that. The traits provide these for up to 8 keys (SortPairsDistance4),
+// but only for up to 2 keys if they are 128-bit (no SwapAdjacentPairs).
+// Scalable vectors are capped to their minimum size of 128 bits.
+template <typename T, size_t kLPK>
+using MergeTag = CappedTag<T, HWY_HAVE_SCALABLE
+                                  ? HWY_MIN(16 / sizeof(T), kLPK == 2 ? 4 : 8)
+                                  : (kLPK == 2 ? 4 : 8)>;
+
+// Bitonic half-cleaners with distance 4, 2 and 1 keys: sorts the keys of a
+// vector whose keys are a bitonic sequence.
+template <class D, class Traits, class V>
+HWY_INLINE V BitonicCleanKeys(D /* tag */, Traits /* st */, V v,
+                              SizeTag<1> /* keys per vector */) {
+  return v;
+}
+template <class D, class Traits, class V>
+HWY_INLINE V BitonicCleanKeys(D d, Traits st, V v, SizeTag<2> /* keys */) {
+  return st.SortPairsDistance1(d, v);
+}
+template <class D, class Traits, class V>
+HWY_INLINE V BitonicCleanKeys(D d, Traits st, V v, SizeTag<4> /* keys */) {
+  return st.SortPairsDistance1(d, st.SortPairsDistance2(d, v));
+}
+template <class D, class Traits, class V>
+HWY_INLINE V BitonicCleanKeys(D d, Traits st, V v, SizeTag<8> /* keys */) {
+  return BitonicCleanKeys(d, st, st.SortPairsDistance4(d, v), SizeTag<4>());
+}
+
+// Bitonic merge network for two vectors, each with keys sorted according to
+// `st`. Afterwards, `a` holds the first and `b` the last half of their keys,
+// again sorted.
+template <class D, class Traits, class V = Vec<D>>
+HWY_INLINE void MergeVectors(D d, Traits st, V& a, V& b) {
+  constexpr size_t kKeys = MaxLanes(D()) / st.LanesPerKey();
+  // Reversing one of them turns their concatenation into a bitonic sequence.
+  b = st.ReverseKeys(d, b);
+  st.Sort2(d, a, b);
+  a = BitonicCleanKeys(d, st, a, SizeTag<kKeys>());
+  b = BitonicCleanKeys(d, st, b, SizeTag<kKeys>());
+}
+
+template <class Traits, typename T>
+HWY_INLINE void CopyKey(Traits st, const T* HWY_RESTRICT from,
+                        T* HWY_RESTRICT to) {
+  CopyBytes<st.LanesPerKey() * sizeof(T)>(from, to);
+}
+
+// Scalar merge for inputs shorter than a vector and remainders. All counts are
+// in lanes, not keys.
+template <class Traits, typename T>
+void MergeScalar(Traits st, const T* HWY_RESTRICT a, size_t num_a,
+                 const T* HWY_RESTRICT b, size_t num_b, T* HWY_RESTRICT out) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  while (num_a != 0 && num_b != 0) {
+    if (st.Compare1(b, a)) {
+      CopyKey(st, b, out);
+      b += kLPK;
+      num_b -= kLPK;
+    } else {
+      CopyKey(st, a, out);
+      a += kLPK;
+      num_a -= kLPK;
+    }
+    out += kLPK;
+  }
+  CopyBytes(a, out, num_a * sizeof(T));
+  CopyBytes(b, out + num_a, num_b * sizeof(T));
+}
+
+// As above, for three runs, which only happens at the end of MergeRuns.
+template <class Traits, typename T>
+void MergeScalar3(Traits st, const T* a, size_t num_a, const T* b, size_t num_b,
+                  const T* c, size_t num_c, T* HWY_RESTRICT out) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  while (num_a != 0 && num_b != 0 && num_c != 0) {
+    const T** first = &a;
+    size_t* num_first = &num_a;
+    if (st.Compare1(b, *first)) {
+      first = &b;
+      num_first = &num_b;
+    }
+    if (st.Compare1(c, *first)) {
+      first = &c;
+      num_first = &num_c;
+    }
+    CopyKey(st, *first, out);
+    *first += kLPK;
+    *num_first -= kLPK;
+    out += kLPK;
+  }
+  if (num_a == 0) return MergeScalar(st, b, num_b, c, num_c, out);
+  if (num_b == 0) return MergeScalar(st, a, num_a, c, num_c, out);
+  MergeScalar(st, a, num_a, b, num_b, out);
+}
+
+// Merges the runs a[0, num_a) and b[0, num_b), both sorted according to `st`,
+// into out[0, num_a + num_b), which must not overlap the inputs. Counts are in
+// lanes, not keys. `d` is typically MergeTag.
+//
+// Holds one vector of each run in registers. After merging them with the
+// bitonic network, stores the first half and replaces it with the next vector
+// of whichever run has the first next key, as in Inoue et al., "SIMD- and
+// Cache-Friendly Algorithm for Sorting an Array of Structures".
+template <class D, class Traits, typename T>
+void MergeRuns(D d, Traits st, const T* HWY_RESTRICT a, size_t num_a,
+               const T* HWY_RESTRICT b, size_t num_b, T* HWY_RESTRICT out) {
+  using V = Vec<D>;
+  constexpr size_t N = MaxLanes(D());
+  HWY_DASSERT(Lanes(d) == N);
+  if (num_a < N || num_b < N) return MergeScalar(st, a, num_a, b, num_b, out);
+
+  V va = LoadU(d, a);
+  V vb = LoadU(d, b);
+  a += N;
+  num_a -= N;
+  b += N;
+  num_b -= N;
+  // While both runs have a whole vector remaining, choose the next without
+  // branches because the comparison result is unpredictable.
+  while (num_a >= N && num_b >= N) {
+    MergeVectors(d, st, va, vb);
+    StoreU(va, d, out);
+    out += N;
+
+    // Continue with the run whose next key is first (or `a` if equal).
+    const size_t take_a = static_cast<size_t>(!st.Compare1(b, a));
+    const size_t advance_a = take_a * N;
+    const size_t advance_b = N - advance_a;
+    va = LoadU(d, take_a ? a : b);
+    a += advance_a;
+    num_a -= advance_a;
+    b += advance_b;
+    num_b -= advance_b;
+  }
+
+  for (;;) {
+    MergeVectors(d, st, va, vb);
+    StoreU(va, d, out);
+    out += N;
+
+    // As above, but stop if the chosen run has less than a whole vector.
+    if (num_b == 0 || (num_a != 0 && !st.Compare1(b, a))) {
+      if (num_a < N) break;
+      va = LoadU(d, a);
+      a += N;
+      num_a -= N;
+    } else {
+      if (num_b < N) break;
+      va = LoadU(d, b);
+      b += N;
+      num_b -= N;
+    }
+  }
+
+  // `vb` is sorted and not yet written, and may interleave with both runs.
+  HWY_ALIGN T last[N];
+  Store(vb, d, last);
+  MergeScalar3(st, last, N, a, num_a, b, num_b, out);
+}
+
+// ------------------------------ K-way merge
+
+// Node of a tournament tree of two-way merges. Leaves are the input runs. Each
+// internal node merges chunks of its two children into a buffer, from which its
+// parent then merges. The buffers are small enough to remain in cache, hence
+// each key is only read from and written to memory once, versus log2(k) times
+// for a series of two-way merges.
+template <typename T>
+struct MergeNode {
+  const T* keys;  // available lanes (in `buf` for internal nodes)
+  size_t num;     // number of available lanes
+  bool done;      // whether `keys` are the last keys of the subtree
+  bool leaf;
+  T* buf;         // nullptr for in-memory leaves
+  size_t children[2];
+};
+
+// Leaves of in-memory runs are always done, hence never refilled. Streaming
+// callers instead pass a functor that sets `keys`, `num` and `done` of a leaf.
+struct NoRefillLeaf {
+  template <typename T>
+  void operator()(size_t /*idx*/, MergeNode<T>& /*leaf*/) const {
+    HWY_DASSERT(false);
+  }
+};
+
+// Lanes per buffer of internal nodes. 8 KiB allows up to 64 runs to fit in a
+// typical L2 cache.
+template <typename T>
+constexpr size_t MergeBufLanes() {
+  return 8192 / sizeof(T);
+}
+
+// Returns the number of lanes in keys[0, num) before the first key that is
+// after `key`.
+template <class Traits, typename T>
+HWY_INLINE size_t UpperBoundLanes(Traits st, const T* HWY_RESTRICT keys,
+                                  size_t num, const T* HWY_RESTRICT key) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  size_t lo = 0;
+  size_t hi = num / kLPK;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (st.Compare1(key, keys + mid * kLPK)) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo * kLPK;
+}
+
+template <class D, class Traits, typename T, class RefillLeaf>
+void RefillMergeNode(D d, Traits st, std::vector<MergeNode<T>>& nodes,
+                     size_t idx, const RefillLeaf& refill_leaf);
+
+// Merges the next chunk of the two children of `nodes[idx]` into `out`, which
+// has space for `MergeBufLanes<T>()`. Returns the number of lanes written,
+// which is zero only if both children are done.
+template <class D, class Traits, typename T, class RefillLeaf>
+size_t MergeStep(D d, Traits st, std::vector<MergeNode<T>>& nodes, size_t idx,
+                 T* HWY_RESTRICT out, const RefillLeaf& refill_leaf) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  constexpr size_t kHalf = MergeBufLanes<T>() / 2;
+  const size_t idx_a = nodes[idx].children[0];
+  const size_t idx_b = nodes[idx].children[1];
+  if (nodes[idx_a].num == 0 && !nodes[idx_a].done) {
+    RefillMergeNode(d, st, nodes, idx_a, refill_leaf);
+  }
+  if (nodes[idx_b].num == 0 && !nodes[idx_b].done) {
+    RefillMergeNode(d, st, nodes, idx_b, refill_leaf);
+  }
+  MergeNode<T>& a = nodes[idx_a];
+  MergeNode<T>& b = nodes[idx_b];
+
+  // Any empty child is now done, so copy from the other.
+  if (a.num == 0 || b.num == 0) {
+    MergeNode<T>& from = (a.num == 0) ? b : a;
+    const size_t num = HWY_MIN(from.num, 2 * kHalf);
+    CopyBytes(from.keys, out, num * sizeof(T));
+    from.keys += num;
+    from.num -= num;
+    return num;
+  }
+
+  size_t num_a = HWY_MIN(a.num, kHalf);
+  size_t num_b = HWY_MIN(b.num, kHalf);
+  const bool last_a = a.done && num_a == a.num;
+  const bool last_b = b.done && num_b == b.num;
+  // Subsequent keys of a child may precede the last key of the other child's
+  // chunk. Hence only merge up to the first of the last keys of the chunks,
+  // unless those are the final keys of their child.
+  const T* end_a = a.keys + num_a - kLPK;
+  const T* end_b = b.keys + num_b - kLPK;
+  if (!last_a && (last_b || !st.Compare1(end_b, end_a))) {
+    num_b = UpperBoundLanes(st, b.keys, num_b, end_a);
+  } else if (!last_b) {
+    num_a = UpperBoundLanes(st, a.keys, num_a, end_b);
+  }
+
+  MergeRuns(d, st, a.keys, num_a, b.keys, num_b, out);
+  a.keys += num_a;
+  a.num -= num_a;
+  b.keys += num_b;
+  b.num -= num_b;
+  return num_a + num_b;
+}
+
+template <class D, class Traits, typename T, class RefillLeaf>
+void RefillMergeNode(D d, Traits st, std::vector<MergeNode<T>>& nodes,
+                     size_t idx, const RefillLeaf& refill_leaf) {
+  if (nodes[idx].leaf) {
+    refill_leaf(idx, nodes[idx]);
+    return;
+  }
+  const size_t num =
+      MergeStep(d, st, nodes, idx, nodes[idx].buf, refill_leaf);
+  MergeNode<T>& node = nodes[idx];
+  node.keys = node.buf;
+  node.num = num;
+  const MergeNode<T>& a = nodes[node.children[0]];
+  const MergeNode<T>& b = nodes[node.children[1]];
+  node.done = a.done && a.num == 0 && b.done && b.num == 0;
+}
+
+// Appends internal nodes for the subtree of leaves [first, first + num), and
+// returns the index of its root.
+template <typename T>
+size_t BuildMergeTree(std::vector<MergeNode<T>>& nodes, size_t first,
+                      size_t num, T*& bufs) {
+  if (num == 1) return first;
+  const size_t left = BuildMergeTree(nodes, first, num / 2, bufs);
+  const size_t right = BuildMergeTree(nodes, first + num / 2, num - num / 2,
+                                      bufs);
+  MergeNode<T> node = {nullptr, 0, false, false, bufs, {left, right}};
+  bufs += MergeBufLanes<T>();
+  nodes.push_back(node);
+  return nodes.size() - 1;
+}
+
+// Merges `num_runs` sorted runs, where `runs[i]` has `num_lanes[i]` lanes, into
+// `out`, which must not overlap them. Allocates a buffer per internal node.
+template <class D, class Traits, typename T>
+void MergeRunsK(D d, Traits st, const T* const* HWY_RESTRICT runs,
+                const size_t* HWY_RESTRICT num_lanes, size_t num_runs,
+                T* HWY_RESTRICT out) {
+  std::vector<MergeNode<T>> nodes;
+  nodes.reserve(2 * num_runs - 1);
+  for (size_t i = 0; i < num_runs; ++i) {
+    MergeNode<T> leaf = {runs[i], num_lanes[i], true, true, nullptr, {0, 0}};
+    nodes.push_back(leaf);
+  }
+  auto bufs = hwy::AllocateAligned<T>((num_runs - 1) * MergeBufLanes<T>());
+  HWY_ASSERT(bufs);
+  T* next_buf = bufs.get();
+  const size_t root = BuildMergeTree(nodes, 0, num_runs, next_buf);
+
+  // The root writes directly to `out`.
+  for (;;) {
+    const size_t num = MergeStep(d, st, nodes, root, out, NoRefillLeaf());
+    if (num == 0) break;
+    out += num;
+  }
+}
+
+}  // namespace detail
+
+// Simpler interface matching VQMerge(), but without dynamic dispatch. Supports
+// the same key types as VQSortStatic. `num_a` etc. are in units of keys. The
+// runs must be sorted according to Order (SortAscending or SortDescending)
+// and not contain NaN. Like VQSort, this is not stable.
+template <typename Key, class Order>
+void VQMergeStatic(const Key* HWY_RESTRICT a, const size_t num_a,
+                   const Key* HWY_RESTRICT b, const size_t num_b,
+                   Key* HWY_RESTRICT out, Order) {
+  const detail::MakeTraits<Key, Order> st;
+  using Traits = decltype(st);
+  using LaneType = typename Traits::LaneType;
+  constexpr size_t kLPK = st.LanesPerKey();
+  const detail::MergeTag<LaneType, kLPK> d;
+  detail::MergeRuns(d, st, reinterpret_cast<const LaneType*>(a), num_a * kLPK,
+                    reinterpret_cast<const LaneType*>(b), num_b * kLPK,
+                    reinterpret_cast<LaneType*>(out));
+}
+
+// Merges `num_runs` runs, where `runs[i]` has `num_keys[i]` keys.
+template <typename Key, class Order>
+void VQMergeKStatic(const Key* const* HWY_RESTRICT runs,
+                    const size_t* HWY_RESTRICT num_keys, const size_t num_runs,
+                    Key* HWY_RESTRICT out, Order order) {
+  if (num_runs == 0) return;
+  if (num_runs == 1) {
+    CopyBytes(runs[0], out, num_keys[0] * sizeof(Key));
+    return;
+  }
+  if (num_runs == 2) {
+    return VQMergeStatic(runs[0], num_keys[0], runs[1], num_keys[1], out,
+                         order);
+  }
+
+  const detail::MakeTraits<Key, Order> st;
+  using Traits = decltype(st);
+  using LaneType = typename Traits::LaneType;
+  constexpr size_t kLPK = st.LanesPerKey();
+  const detail::MergeTag<LaneType, kLPK> d;
+  std::vector<const LaneType*> lane_runs(num_runs);
+  std::vector<size_t> num_lanes(num_runs);
+  for (size_t i = 0; i < num_runs; ++i) {
+    lane_runs[i] = reinterpret_cast<const LaneType*>(runs[i]);
+    num_lanes[i] = num_keys[i] * kLPK;
+  }
+  detail::MergeRunsK(d, st, lane_runs.data(), num_lanes.data(), num_runs,
+                     reinterpret_cast<LaneType*>(out));
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQMERGE_TOGGLE
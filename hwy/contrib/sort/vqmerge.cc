@@ -0,0 +1,810 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/sort/vqmerge.h"
+
+#include <stddef.h>
+
+#undef HWY_TARGET_INCLUDE
+// clang-format off
+// (avoid line break, which would prevent Copybara rules from matching)
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqmerge.cc"  //NOLINT
+// clang-format on
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqmerge-inl.h"
+
+// All key types are in a single file because merging only requires a small
+// part of the sorting networks, and is hence quick to compile.
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+void MergeU16Asc(const uint16_t* HWY_RESTRICT a, const size_t num_a,
+                 const uint16_t* HWY_RESTRICT b, const size_t num_b,
+                 uint16_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeKU16Asc(const uint16_t* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  uint16_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+}
+
+void MergeU16Desc(const uint16_t* HWY_RESTRICT a, const size_t num_a,
+                  const uint16_t* HWY_RESTRICT b, const size_t num_b,
+                  uint16_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeKU16Desc(const uint16_t* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   uint16_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+}
+
+void MergeU32Asc(const uint32_t* HWY_RESTRICT a, const size_t num_a,
+                 const uint32_t* HWY_RESTRICT b, const size_t num_b,
+                 uint32_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeKU32Asc(const uint32_t* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  uint32_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+}
+
+void MergeU32Desc(const uint32_t* HWY_RESTRICT a, const size_t num_a,
+                  const uint32_t* HWY_RESTRICT b, const size_t num_b,
+                  uint32_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeKU32Desc(const uint32_t* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   uint32_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+}
+
+void MergeU64Asc(const uint64_t* HWY_RESTRICT a, const size_t num_a,
+                 const uint64_t* HWY_RESTRICT b, const size_t num_b,
+                 uint64_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeKU64Asc(const uint64_t* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  uint64_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+}
+
+void MergeU64Desc(const uint64_t* HWY_RESTRICT a, const size_t num_a,
+                  const uint64_t* HWY_RESTRICT b, const size_t num_b,
+                  uint64_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeKU64Desc(const uint64_t* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   uint64_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+}
+
+void MergeI16Asc(const int16_t* HWY_RESTRICT a, const size_t num_a,
+                 const int16_t* HWY_RESTRICT b, const size_t num_b,
+                 int16_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeKI16Asc(const int16_t* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  int16_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+}
+
+void MergeI16Desc(const int16_t* HWY_RESTRICT a, const size_t num_a,
+                  const int16_t* HWY_RESTRICT b, const size_t num_b,
+                  int16_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeKI16Desc(const int16_t* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   int16_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+}
+
+void MergeI32Asc(const int32_t* HWY_RESTRICT a, const size_t num_a,
+                 const int32_t* HWY_RESTRICT b, const size_t num_b,
+                 int32_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeKI32Asc(const int32_t* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  int32_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+}
+
+void MergeI32Desc(const int32_t* HWY_RESTRICT a, const size_t num_a,
+                  const int32_t* HWY_RESTRICT b, const size_t num_b,
+                  int32_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeKI32Desc(const int32_t* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   int32_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+}
+
+void MergeI64Asc(const int64_t* HWY_RESTRICT a, const size_t num_a,
+                 const int64_t* HWY_RESTRICT b, const size_t num_b,
+                 int64_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeKI64Asc(const int64_t* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  int64_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+}
+
+void MergeI64Desc(const int64_t* HWY_RESTRICT a, const size_t num_a,
+                  const int64_t* HWY_RESTRICT b, const size_t num_b,
+                  int64_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeKI64Desc(const int64_t* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   int64_t* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+}
+
+void MergeF16Asc(const float16_t* HWY_RESTRICT a, const size_t num_a,
+                 const float16_t* HWY_RESTRICT b, const size_t num_b,
+                 float16_t* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT16
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeKF16Asc(const float16_t* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  float16_t* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT16
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+#else
+  (void)runs;
+  (void)sizes;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeF16Desc(const float16_t* HWY_RESTRICT a, const size_t num_a,
+                  const float16_t* HWY_RESTRICT b, const size_t num_b,
+                  float16_t* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT16
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeKF16Desc(const float16_t* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   float16_t* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT16
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+#else
+  (void)runs;
+  (void)sizes;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeF32Asc(const float* HWY_RESTRICT a, const size_t num_a,
+                 const float* HWY_RESTRICT b, const size_t num_b,
+                 float* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeKF32Asc(const float* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  float* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+}
+
+void MergeF32Desc(const float* HWY_RESTRICT a, const size_t num_a,
+                  const float* HWY_RESTRICT b, const size_t num_b,
+                  float* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeKF32Desc(const float* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   float* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+}
+
+void MergeF64Asc(const double* HWY_RESTRICT a, const size_t num_a,
+                 const double* HWY_RESTRICT b, const size_t num_b,
+                 double* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT64
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeKF64Asc(const double* const* HWY_RESTRICT runs,
+                  const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                  double* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT64
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+#else
+  (void)runs;
+  (void)sizes;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeF64Desc(const double* HWY_RESTRICT a, const size_t num_a,
+                  const double* HWY_RESTRICT b, const size_t num_b,
+                  double* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT64
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeKF64Desc(const double* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   double* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT64
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+#else
+  (void)runs;
+  (void)sizes;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeKV64Asc(const K32V32* HWY_RESTRICT a, const size_t num_a,
+                  const K32V32* HWY_RESTRICT b, const size_t num_b,
+                  K32V32* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeKKV64Asc(const K32V32* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   K32V32* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+}
+
+void MergeKV64Desc(const K32V32* HWY_RESTRICT a, const size_t num_a,
+                   const K32V32* HWY_RESTRICT b, const size_t num_b,
+                   K32V32* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeKKV64Desc(const K32V32* const* HWY_RESTRICT runs,
+                    const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                    K32V32* HWY_RESTRICT out) {
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+}
+
+void MergeU128Asc(const uint128_t* HWY_RESTRICT a, const size_t num_a,
+                  const uint128_t* HWY_RESTRICT b, const size_t num_b,
+                  uint128_t* HWY_RESTRICT out) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+#endif
+}
+
+void MergeKU128Asc(const uint128_t* const* HWY_RESTRICT runs,
+                   const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                   uint128_t* HWY_RESTRICT out) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+#else
+  (void)runs;
+  (void)sizes;
+  (void)num_runs;
+  (void)out;
+#endif
+}
+
+void MergeU128Desc(const uint128_t* HWY_RESTRICT a, const size_t num_a,
+                   const uint128_t* HWY_RESTRICT b, const size_t num_b,
+                   uint128_t* HWY_RESTRICT out) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+#endif
+}
+
+void MergeKU128Desc(const uint128_t* const* HWY_RESTRICT runs,
+                    const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                    uint128_t* HWY_RESTRICT out) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+#else
+  (void)runs;
+  (void)sizes;
+  (void)num_runs;
+  (void)out;
+#endif
+}
+
+void MergeKV128Asc(const K64V64* HWY_RESTRICT a, const size_t num_a,
+                   const K64V64* HWY_RESTRICT b, const size_t num_b,
+                   K64V64* HWY_RESTRICT out) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+#endif
+}
+
+void MergeKKV128Asc(const K64V64* const* HWY_RESTRICT runs,
+                    const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                    K64V64* HWY_RESTRICT out) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortAscending());
+#else
+  (void)runs;
+  (void)sizes;
+  (void)num_runs;
+  (void)out;
+#endif
+}
+
+void MergeKV128Desc(const K64V64* HWY_RESTRICT a, const size_t num_a,
+                    const K64V64* HWY_RESTRICT b, const size_t num_b,
+                    K64V64* HWY_RESTRICT out) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+#endif
+}
+
+void MergeKKV128Desc(const K64V64* const* HWY_RESTRICT runs,
+                     const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+                     K64V64* HWY_RESTRICT out) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQMergeKStatic(runs, sizes, num_runs, out, SortDescending());
+#else
+  (void)runs;
+  (void)sizes;
+  (void)num_runs;
+  (void)out;
+#endif
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(MergeU16Asc);
+HWY_EXPORT(MergeKU16Asc);
+HWY_EXPORT(MergeU16Desc);
+HWY_EXPORT(MergeKU16Desc);
+HWY_EXPORT(MergeU32Asc);
+HWY_EXPORT(MergeKU32Asc);
+HWY_EXPORT(MergeU32Desc);
+HWY_EXPORT(MergeKU32Desc);
+HWY_EXPORT(MergeU64Asc);
+HWY_EXPORT(MergeKU64Asc);
+HWY_EXPORT(MergeU64Desc);
+HWY_EXPORT(MergeKU64Desc);
+HWY_EXPORT(MergeI16Asc);
+HWY_EXPORT(MergeKI16Asc);
+HWY_EXPORT(MergeI16Desc);
+HWY_EXPORT(MergeKI16Desc);
+HWY_EXPORT(MergeI32Asc);
+HWY_EXPORT(MergeKI32Asc);
+HWY_EXPORT(MergeI32Desc);
+HWY_EXPORT(MergeKI32Desc);
+HWY_EXPORT(MergeI64Asc);
+HWY_EXPORT(MergeKI64Asc);
+HWY_EXPORT(MergeI64Desc);
+HWY_EXPORT(MergeKI64Desc);
+HWY_EXPORT(MergeF16Asc);
+HWY_EXPORT(MergeKF16Asc);
+HWY_EXPORT(MergeF16Desc);
+HWY_EXPORT(MergeKF16Desc);
+HWY_EXPORT(MergeF32Asc);
+HWY_EXPORT(MergeKF32Asc);
+HWY_EXPORT(MergeF32Desc);
+HWY_EXPORT(MergeKF32Desc);
+HWY_EXPORT(MergeF64Asc);
+HWY_EXPORT(MergeKF64Asc);
+HWY_EXPORT(MergeF64Desc);
+HWY_EXPORT(MergeKF64Desc);
+HWY_EXPORT(MergeKV64Asc);
+HWY_EXPORT(MergeKKV64Asc);
+HWY_EXPORT(MergeKV64Desc);
+HWY_EXPORT(MergeKKV64Desc);
+HWY_EXPORT(MergeU128Asc);
+HWY_EXPORT(MergeKU128Asc);
+HWY_EXPORT(MergeU128Desc);
+HWY_EXPORT(MergeKU128Desc);
+HWY_EXPORT(MergeKV128Asc);
+HWY_EXPORT(MergeKKV128Asc);
+HWY_EXPORT(MergeKV128Desc);
+HWY_EXPORT(MergeKKV128Desc);
+}  // namespace
+
+void VQMerge(const uint16_t* HWY_RESTRICT a, const size_t na,
+             const uint16_t* HWY_RESTRICT b, const size_t nb,
+             uint16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeU16Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const uint16_t* HWY_RESTRICT a, const size_t na,
+             const uint16_t* HWY_RESTRICT b, const size_t nb,
+             uint16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeU16Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const uint32_t* HWY_RESTRICT a, const size_t na,
+             const uint32_t* HWY_RESTRICT b, const size_t nb,
+             uint32_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeU32Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const uint32_t* HWY_RESTRICT a, const size_t na,
+             const uint32_t* HWY_RESTRICT b, const size_t nb,
+             uint32_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeU32Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const uint64_t* HWY_RESTRICT a, const size_t na,
+             const uint64_t* HWY_RESTRICT b, const size_t nb,
+             uint64_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeU64Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const uint64_t* HWY_RESTRICT a, const size_t na,
+             const uint64_t* HWY_RESTRICT b, const size_t nb,
+             uint64_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeU64Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const int16_t* HWY_RESTRICT a, const size_t na,
+             const int16_t* HWY_RESTRICT b, const size_t nb,
+             int16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeI16Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const int16_t* HWY_RESTRICT a, const size_t na,
+             const int16_t* HWY_RESTRICT b, const size_t nb,
+             int16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeI16Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const int32_t* HWY_RESTRICT a, const size_t na,
+             const int32_t* HWY_RESTRICT b, const size_t nb,
+             int32_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeI32Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const int32_t* HWY_RESTRICT a, const size_t na,
+             const int32_t* HWY_RESTRICT b, const size_t nb,
+             int32_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeI32Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const int64_t* HWY_RESTRICT a, const size_t na,
+             const int64_t* HWY_RESTRICT b, const size_t nb,
+             int64_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeI64Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const int64_t* HWY_RESTRICT a, const size_t na,
+             const int64_t* HWY_RESTRICT b, const size_t nb,
+             int64_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeI64Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const float16_t* HWY_RESTRICT a, const size_t na,
+             const float16_t* HWY_RESTRICT b, const size_t nb,
+             float16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeF16Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const float16_t* HWY_RESTRICT a, const size_t na,
+             const float16_t* HWY_RESTRICT b, const size_t nb,
+             float16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeF16Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const float* HWY_RESTRICT a, const size_t na,
+             const float* HWY_RESTRICT b, const size_t nb,
+             float* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeF32Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const float* HWY_RESTRICT a, const size_t na,
+             const float* HWY_RESTRICT b, const size_t nb,
+             float* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeF32Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const double* HWY_RESTRICT a, const size_t na,
+             const double* HWY_RESTRICT b, const size_t nb,
+             double* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeF64Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const double* HWY_RESTRICT a, const size_t na,
+             const double* HWY_RESTRICT b, const size_t nb,
+             double* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeF64Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const K32V32* HWY_RESTRICT a, const size_t na,
+             const K32V32* HWY_RESTRICT b, const size_t nb,
+             K32V32* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKV64Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const K32V32* HWY_RESTRICT a, const size_t na,
+             const K32V32* HWY_RESTRICT b, const size_t nb,
+             K32V32* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKV64Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const uint128_t* HWY_RESTRICT a, const size_t na,
+             const uint128_t* HWY_RESTRICT b, const size_t nb,
+             uint128_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeU128Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const uint128_t* HWY_RESTRICT a, const size_t na,
+             const uint128_t* HWY_RESTRICT b, const size_t nb,
+             uint128_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeU128Desc)(a, na, b, nb, out);
+}
+
+void VQMerge(const K64V64* HWY_RESTRICT a, const size_t na,
+             const K64V64* HWY_RESTRICT b, const size_t nb,
+             K64V64* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKV128Asc)(a, na, b, nb, out);
+}
+
+void VQMerge(const K64V64* HWY_RESTRICT a, const size_t na,
+             const K64V64* HWY_RESTRICT b, const size_t nb,
+             K64V64* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKV128Desc)(a, na, b, nb, out);
+}
+
+void VQMergeK(const uint16_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              uint16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKU16Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const uint16_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              uint16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKU16Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const uint32_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              uint32_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKU32Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const uint32_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              uint32_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKU32Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const uint64_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              uint64_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKU64Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const uint64_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              uint64_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKU64Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const int16_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              int16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKI16Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const int16_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              int16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKI16Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const int32_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              int32_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKI32Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const int32_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              int32_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKI32Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const int64_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              int64_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKI64Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const int64_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              int64_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKI64Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const float16_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              float16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKF16Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const float16_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              float16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKF16Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const float* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              float* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKF32Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const float* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              float* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKF32Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const double* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              double* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKF64Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const double* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              double* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKF64Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const K32V32* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              K32V32* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKKV64Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const K32V32* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              K32V32* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKKV64Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const uint128_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              uint128_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKU128Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const uint128_t* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              uint128_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKU128Desc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const K64V64* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              K64V64* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKKV128Asc)(runs, sizes, num_runs, out);
+}
+
+void VQMergeK(const K64V64* const* HWY_RESTRICT runs,
+              const size_t* HWY_RESTRICT sizes, const size_t num_runs,
+              K64V64* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKKV128Desc)(runs, sizes, num_runs, out);
+}
+
+}  // namespace hwy
+#endif  // HWY_ONCE
@@ -0,0 +1,235 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Interface to vectorized merging of sorted runs with dynamic dispatch. For
+// static dispatch, call VQMergeStatic/VQMergeKStatic in vqmerge-inl.h.
+//
+// Merging is cheaper than sorting the concatenation of the runs: its cost is
+// proportional to the number of keys (times log2 of the number of runs for
+// VQMergeK, but with a small constant), and it only reads and writes each key
+// once.
+
+#ifndef HIGHWAY_HWY_CONTRIB_SORT_VQMERGE_H_
+#define HIGHWAY_HWY_CONTRIB_SORT_VQMERGE_H_
+
+// IWYU pragma: begin_exports
+#include <stddef.h>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"  // SortAscending
+// IWYU pragma: end_exports
+
+namespace hwy {
+
+// Merges the sorted runs a[0, na) and b[0, nb) into out[0, na + nb), which
+// must not overlap them. Both runs must be sorted in the given order, e.g. by
+// VQSort, and must not contain NaN. Like VQSort, this is not stable: the
+// values of K32V32/K64V64 with equal keys may be reordered. Does not allocate.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint16_t* HWY_RESTRICT a, size_t na,
+                                   const uint16_t* HWY_RESTRICT b, size_t nb,
+                                   uint16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint16_t* HWY_RESTRICT a, size_t na,
+                                   const uint16_t* HWY_RESTRICT b, size_t nb,
+                                   uint16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint32_t* HWY_RESTRICT a, size_t na,
+                                   const uint32_t* HWY_RESTRICT b, size_t nb,
+                                   uint32_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint32_t* HWY_RESTRICT a, size_t na,
+                                   const uint32_t* HWY_RESTRICT b, size_t nb,
+                                   uint32_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint64_t* HWY_RESTRICT a, size_t na,
+                                   const uint64_t* HWY_RESTRICT b, size_t nb,
+                                   uint64_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint64_t* HWY_RESTRICT a, size_t na,
+                                   const uint64_t* HWY_RESTRICT b, size_t nb,
+                                   uint64_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int16_t* HWY_RESTRICT a, size_t na,
+                                   const int16_t* HWY_RESTRICT b, size_t nb,
+                                   int16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int16_t* HWY_RESTRICT a, size_t na,
+                                   const int16_t* HWY_RESTRICT b, size_t nb,
+                                   int16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int32_t* HWY_RESTRICT a, size_t na,
+                                   const int32_t* HWY_RESTRICT b, size_t nb,
+                                   int32_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int32_t* HWY_RESTRICT a, size_t na,
+                                   const int32_t* HWY_RESTRICT b, size_t nb,
+                                   int32_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int64_t* HWY_RESTRICT a, size_t na,
+                                   const int64_t* HWY_RESTRICT b, size_t nb,
+                                   int64_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int64_t* HWY_RESTRICT a, size_t na,
+                                   const int64_t* HWY_RESTRICT b, size_t nb,
+                                   int64_t* HWY_RESTRICT out, SortDescending);
+
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float16_t* HWY_RESTRICT a, size_t na,
+                                   const float16_t* HWY_RESTRICT b, size_t nb,
+                                   float16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float16_t* HWY_RESTRICT a, size_t na,
+                                   const float16_t* HWY_RESTRICT b, size_t nb,
+                                   float16_t* HWY_RESTRICT out, SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float* HWY_RESTRICT a, size_t na,
+                                   const float* HWY_RESTRICT b, size_t nb,
+                                   float* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float* HWY_RESTRICT a, size_t na,
+                                   const float* HWY_RESTRICT b, size_t nb,
+                                   float* HWY_RESTRICT out, SortDescending);
+
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const double* HWY_RESTRICT a, size_t na,
+                                   const double* HWY_RESTRICT b, size_t nb,
+                                   double* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const double* HWY_RESTRICT a, size_t na,
+                                   const double* HWY_RESTRICT b, size_t nb,
+                                   double* HWY_RESTRICT out, SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K32V32* HWY_RESTRICT a, size_t na,
+                                   const K32V32* HWY_RESTRICT b, size_t nb,
+                                   K32V32* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K32V32* HWY_RESTRICT a, size_t na,
+                                   const K32V32* HWY_RESTRICT b, size_t nb,
+                                   K32V32* HWY_RESTRICT out, SortDescending);
+
+// 128-bit types: sizes are still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint128_t* HWY_RESTRICT a, size_t na,
+                                   const uint128_t* HWY_RESTRICT b, size_t nb,
+                                   uint128_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint128_t* HWY_RESTRICT a, size_t na,
+                                   const uint128_t* HWY_RESTRICT b, size_t nb,
+                                   uint128_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K64V64* HWY_RESTRICT a, size_t na,
+                                   const K64V64* HWY_RESTRICT b, size_t nb,
+                                   K64V64* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K64V64* HWY_RESTRICT a, size_t na,
+                                   const K64V64* HWY_RESTRICT b, size_t nb,
+                                   K64V64* HWY_RESTRICT out, SortDescending);
+
+// Merges `num_runs` sorted runs into `out`, which must not overlap them.
+// `runs[i]` points to the first of `sizes[i]` keys. The same requirements as
+// for VQMerge apply. Uses a tournament tree of two-way merges whose nodes
+// buffer their output in cache, hence each key is read and written once.
+// Allocates 8 KiB per run.
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const uint16_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, uint16_t* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const uint16_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, uint16_t* HWY_RESTRICT out,
+                                    SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const uint32_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, uint32_t* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const uint32_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, uint32_t* HWY_RESTRICT out,
+                                    SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const uint64_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, uint64_t* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const uint64_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, uint64_t* HWY_RESTRICT out,
+                                    SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const int16_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, int16_t* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const int16_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, int16_t* HWY_RESTRICT out,
+                                    SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const int32_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, int32_t* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const int32_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, int32_t* HWY_RESTRICT out,
+                                    SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const int64_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, int64_t* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const int64_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, int64_t* HWY_RESTRICT out,
+                                    SortDescending);
+
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const float16_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs,
+                                    float16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const float16_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs,
+                                    float16_t* HWY_RESTRICT out,
+                                    SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const float* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, float* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const float* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, float* HWY_RESTRICT out,
+                                    SortDescending);
+
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const double* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, double* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const double* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, double* HWY_RESTRICT out,
+                                    SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const K32V32* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, K32V32* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const K32V32* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, K32V32* HWY_RESTRICT out,
+                                    SortDescending);
+
+// 128-bit types: sizes are still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const uint128_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs,
+                                    uint128_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const uint128_t* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs,
+                                    uint128_t* HWY_RESTRICT out,
+                                    SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const K64V64* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, K64V64* HWY_RESTRICT out,
+                                    SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeK(const K64V64* const* HWY_RESTRICT runs,
+                                    const size_t* HWY_RESTRICT sizes,
+                                    size_t num_runs, K64V64* HWY_RESTRICT out,
+                                    SortDescending);
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQMERGE_H_
@@ -0,0 +1,431 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_VQRADIX_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_VQRADIX_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_VQRADIX_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_VQRADIX_TOGGLE
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/contrib/sort/order.h"       // SortAscending
+#include "hwy/contrib/sort/traits-inl.h"  // SortableBitsFromKeyBits
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+// LSD radix sort: a single pass converts keys to unsigned integers with the
+// same order (see SortableBitsFromKeyBits) and counts the occurrences of all
+// digits, then each digit is scattered into a second buffer. Digits are 8 bits
+// so that the histograms of all passes fit in L1, and so that the scatter has
+// few enough destinations for the store buffers to combine writes.
+constexpr size_t kRadixBits = 8;
+constexpr size_t kRadixBuckets = size_t{1} << kRadixBits;
+// Digits are extracted with SIMD into a stack buffer for this many items, which
+// is then consumed by the scalar histogram and scatter loops.
+constexpr size_t kRadixBlockItems = 256;
+
+// Applies `func(d, v)` to `num_lanes` lanes of `from` and stores to `to`, which
+// may be the same as `from`.
+template <class D, class Func>
+HWY_INLINE void RadixConvertLanes(D d, const TFromD<D>* from,
+                                  const size_t num_lanes, TFromD<D>* to,
+                                  const Func& func) {
+  const size_t N = Lanes(d);
+  size_t i = 0;
+  if (num_lanes >= N) {
+    for (; i <= num_lanes - N; i += N) {
+      StoreU(func(d, LoadU(d, from + i)), d, to + i);
+    }
+  }
+  const size_t remaining = num_lanes - i;
+  if (remaining != 0) {
+    StoreN(func(d, LoadN(d, from + i, remaining)), d, to + i, remaining);
+  }
+}
+
+// Writes the `kRadixBits` digit at `shift` of each of `num` keys to `digits`.
+template <class D>
+HWY_INLINE void RadixDigits(D d, const TFromD<D>* HWY_RESTRICT keys,
+                            const size_t num, const size_t shift,
+                            uint8_t* HWY_RESTRICT digits) {
+  using T = TFromD<D>;
+  const Rebind<uint8_t, D> d8;
+  const size_t N = Lanes(d);
+  const Vec<D> mask = Set(d, static_cast<T>(kRadixBuckets - 1));
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const Vec<D> v =
+          ShiftRightSame(LoadU(d, keys + i), static_cast<int>(shift));
+      StoreU(TruncateTo(d8, And(v, mask)), d8, digits + i);
+    }
+  }
+  const size_t remaining = num - i;
+  if (remaining != 0) {
+    const Vec<D> v = ShiftRightSame(LoadN(d, keys + i, remaining),
+                                    static_cast<int>(shift));
+    StoreN(TruncateTo(d8, And(v, mask)), d8, digits + i, remaining);
+  }
+}
+
+// Sets `min`/`max` to the extrema of `num` lanes. Used to detect digits that
+// are the same for all items in a block.
+template <class D>
+HWY_INLINE void RadixMinMax(D d, const TFromD<D>* HWY_RESTRICT lanes,
+                            const size_t num, uint64_t& min, uint64_t& max) {
+  using T = TFromD<D>;
+  const size_t N = Lanes(d);
+  T lane_min = LimitsMax<T>();
+  T lane_max = 0;
+  size_t i = 0;
+  if (num >= N) {
+    Vec<D> vmin = Set(d, lane_min);
+    Vec<D> vmax = Zero(d);
+    for (; i <= num - N; i += N) {
+      const Vec<D> v = LoadU(d, lanes + i);
+      vmin = Min(vmin, v);
+      vmax = Max(vmax, v);
+    }
+    lane_min = ReduceMin(d, vmin);
+    lane_max = ReduceMax(d, vmax);
+  }
+  for (; i < num; ++i) {
+    lane_min = HWY_MIN(lane_min, lanes[i]);
+    lane_max = HWY_MAX(lane_max, lanes[i]);
+  }
+  min = lane_min;
+  max = lane_max;
+}
+
+// Radix traits describe how items (keys, or key-value pairs) are stored as
+// unsigned lanes and which of their bits are the key. ToOrdered/FromOrdered
+// convert between keys and unsigned integers whose order is the requested sort
+// order, and Digits returns the digit of each item at a given bit offset.
+// MinMax returns the extrema of the most significant lane of the items, whose
+// bit 0 is at offset kTopShift.
+
+// For built-in key types: one lane per key, which is entirely key.
+template <typename Key, class Order>
+struct RadixTraitsLane {
+  using LaneType = MakeUnsigned<Key>;
+  static constexpr size_t kLanesPerItem = 1;
+  static constexpr size_t kFirstShift = 0;
+  static constexpr size_t kKeyBits = sizeof(Key) * 8;
+  static constexpr size_t kTopShift = 0;
+
+  template <class D>
+  void ToOrdered(D d, LaneType* items, size_t num) const {
+    RadixConvertLanes(d, items, num, items, [](D d, Vec<D> v) HWY_ATTR {
+      return SortableBitsFromKeyBits<Key, Order>(d, v);
+    });
+  }
+  template <class D>
+  void FromOrdered(D d, const LaneType* from, size_t num, LaneType* to) const {
+    RadixConvertLanes(d, from, num, to, [](D d, Vec<D> v) HWY_ATTR {
+      return KeyBitsFromSortableBits<Key, Order>(d, v);
+    });
+  }
+  template <class D>
+  void Digits(D d, const LaneType* HWY_RESTRICT items, size_t num,
+              size_t shift, uint8_t* HWY_RESTRICT digits) const {
+    RadixDigits(d, items, num, shift, digits);
+  }
+  template <class D>
+  void MinMax(D d, const LaneType* HWY_RESTRICT items, size_t num,
+              uint64_t& min, uint64_t& max) const {
+    RadixMinMax(d, items, num, min, max);
+  }
+};
+
+// K32V32: the key is the upper half of a u64 lane.
+template <class Order>
+struct RadixTraitsKV64 {
+  using LaneType = uint64_t;
+  static constexpr size_t kLanesPerItem = 1;
+  static constexpr size_t kFirstShift = 32;
+  static constexpr size_t kKeyBits = 32;
+  static constexpr size_t kTopShift = 0;
+
+  // Keys are unsigned, so only descending order requires flipping.
+  template <class D>
+  static HWY_INLINE Vec<D> FlipVec(D d, Vec<D> v) {
+    return Order::IsAscending() ? v : Xor(v, Set(d, 0xFFFFFFFF00000000ull));
+  }
+
+  template <class D>
+  void ToOrdered(D d, LaneType* items, size_t num) const {
+    if (Order::IsAscending()) return;
+    RadixConvertLanes(d, items, num, items, [](D d, Vec<D> v) HWY_ATTR {
+      return FlipVec(d, v);
+    });
+  }
+  template <class D>
+  void FromOrdered(D d, const LaneType* from, size_t num, LaneType* to) const {
+    if (!Order::IsAscending()) {
+      RadixConvertLanes(d, from, num, to, [](D d, Vec<D> v) HWY_ATTR {
+        return FlipVec(d, v);
+      });
+    } else if (from != to) {
+      CopyBytes(from, to, num * sizeof(LaneType));
+    }
+  }
+  template <class D>
+  void Digits(D d, const LaneType* HWY_RESTRICT items, size_t num,
+              size_t shift, uint8_t* HWY_RESTRICT digits) const {
+    RadixDigits(d, items, num, shift, digits);
+  }
+  template <class D>
+  void MinMax(D d, const LaneType* HWY_RESTRICT items, size_t num,
+              uint64_t& min, uint64_t& max) const {
+    RadixMinMax(d, items, num, min, max);
+  }
+};
+
+// uint128_t and K64V64: two u64 lanes per item, little-endian. For K64V64,
+// only the upper lane is key, hence kFirstShift is 64.
+template <class Order, size_t kFirstShiftArg>
+struct RadixTraits128 {
+  using LaneType = uint64_t;
+  static constexpr size_t kLanesPerItem = 2;
+  static constexpr size_t kFirstShift = kFirstShiftArg;
+  static constexpr size_t kKeyBits = 128 - kFirstShift;
+  static constexpr size_t kTopShift = 64;
+
+  // Keys are unsigned, so only descending order requires flipping. Operates on
+  // both lanes of items so that this also works for single-lane vectors.
+  template <class D>
+  HWY_INLINE void Flip(D d, const LaneType* from, size_t num,
+                       LaneType* to) const {
+    const Vec<D> flip_lo = Set(d, kFirstShift == 0 ? ~0ull : 0ull);
+    const Vec<D> flip_hi = Set(d, ~0ull);
+    const size_t N = Lanes(d);
+    size_t i = 0;
+    if (num >= N) {
+      for (; i <= num - N; i += N) {
+        Vec<D> lo, hi;
+        LoadInterleaved2(d, from + 2 * i, lo, hi);
+        StoreInterleaved2(Xor(lo, flip_lo), Xor(hi, flip_hi), d, to + 2 * i);
+      }
+    }
+    for (; i < num; ++i) {
+      to[2 * i + 0] = from[2 * i + 0] ^ (kFirstShift == 0 ? ~0ull : 0ull);
+      to[2 * i + 1] = ~from[2 * i + 1];
+    }
+  }
+
+  template <class D>
+  void ToOrdered(D d, LaneType* items, size_t num) const {
+    if (!Order::IsAscending()) Flip(d, items, num, items);
+  }
+  template <class D>
+  void FromOrdered(D d, const LaneType* from, size_t num, LaneType* to) const {
+    if (!Order::IsAscending()) {
+      Flip(d, from, num, to);
+    } else if (from != to) {
+      CopyBytes(from, to, num * 2 * sizeof(LaneType));
+    }
+  }
+
+  template <class D>
+  void Digits(D d, const LaneType* HWY_RESTRICT items, size_t num,
+              size_t shift, uint8_t* HWY_RESTRICT digits) const {
+    const Rebind<uint8_t, D> d8;
+    const size_t N = Lanes(d);
+    const bool is_hi = shift >= 64;
+    const int lane_shift = static_cast<int>(shift & 63);
+    const Vec<D> mask = Set(d, uint64_t{kRadixBuckets - 1});
+    size_t i = 0;
+    if (num >= N) {
+      for (; i <= num - N; i += N) {
+        Vec<D> lo, hi;
+        LoadInterleaved2(d, items + 2 * i, lo, hi);
+        const Vec<D> v = ShiftRightSame(is_hi ? hi : lo, lane_shift);
+        StoreU(TruncateTo(d8, And(v, mask)), d8, digits + i);
+      }
+    }
+    for (; i < num; ++i) {
+      digits[i] = static_cast<uint8_t>(items[2 * i + is_hi] >> lane_shift);
+    }
+  }
+
+  template <class D>
+  void MinMax(D d, const LaneType* HWY_RESTRICT items, size_t num,
+              uint64_t& min, uint64_t& max) const {
+    const size_t N = Lanes(d);
+    min = LimitsMax<uint64_t>();
+    max = 0;
+    size_t i = 0;
+    if (num >= N) {
+      Vec<D> vmin = Set(d, min);
+      Vec<D> vmax = Zero(d);
+      for (; i <= num - N; i += N) {
+        Vec<D> lo, hi;
+        LoadInterleaved2(d, items + 2 * i, lo, hi);
+        vmin = Min(vmin, hi);
+        vmax = Max(vmax, hi);
+      }
+      min = ReduceMin(d, vmin);
+      max = ReduceMax(d, vmax);
+    }
+    for (; i < num; ++i) {
+      min = HWY_MIN(min, items[2 * i + 1]);
+      max = HWY_MAX(max, items[2 * i + 1]);
+    }
+  }
+};
+
+template <typename Key, class Order>
+struct RadixTraitsForKey {
+  using type = RadixTraitsLane<Key, Order>;
+};
+template <class Order>
+struct RadixTraitsForKey<K32V32, Order> {
+  using type = RadixTraitsKV64<Order>;
+};
+template <class Order>
+struct RadixTraitsForKey<uint128_t, Order> {
+  using type = RadixTraits128<Order, 0>;
+};
+template <class Order>
+struct RadixTraitsForKey<K64V64, Order> {
+  using type = RadixTraits128<Order, 64>;
+};
+
+template <typename Key, class Order>
+using MakeRadixTraits = typename RadixTraitsForKey<Key, Order>::type;
+
+// Sorts `num` items in `items`, using `buf` (also `num` items) as the
+// destination of every other scatter.
+template <class D, class RT>
+HWY_NOINLINE void RadixSort(D d, RT rt, TFromD<D>* HWY_RESTRICT items,
+                            const size_t num, TFromD<D>* HWY_RESTRICT buf) {
+  using T = TFromD<D>;
+  constexpr size_t kLanes = RT::kLanesPerItem;
+  constexpr size_t kPasses = RT::kKeyBits / kRadixBits;
+
+  auto histograms = hwy::AllocateAligned<size_t>(kPasses * kRadixBuckets);
+  HWY_ASSERT(histograms);
+  ZeroBytes(histograms.get(), kPasses * kRadixBuckets * sizeof(size_t));
+  HWY_ALIGN uint8_t digits[kRadixBlockItems];
+
+  // Convert keys and count all digits in a single pass over memory.
+  for (size_t i = 0; i < num; i += kRadixBlockItems) {
+    const size_t count = HWY_MIN(kRadixBlockItems, num - i);
+    T* block = items + i * kLanes;
+    rt.ToOrdered(d, block, count);
+    uint64_t min, max;
+    rt.MinMax(d, block, count, min, max);
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+      const size_t shift = RT::kFirstShift + pass * kRadixBits;
+      size_t* HWY_RESTRICT histogram = histograms.get() + pass * kRadixBuckets;
+      // If min and max agree in this and all higher bits of the top lane, all
+      // items in the block have the same digit. This avoids a serial
+      // dependency between increments of the same counter, and is common for
+      // the upper digits of keys with a narrow range.
+      if (shift >= RT::kTopShift) {
+        const size_t top_shift = shift - RT::kTopShift;
+        if (((min ^ max) >> top_shift) == 0) {
+          histogram[(min >> top_shift) & (kRadixBuckets - 1)] += count;
+          continue;
+        }
+      }
+      rt.Digits(d, block, count, shift, digits);
+      for (size_t j = 0; j < count; ++j) {
+        ++histogram[digits[j]];
+      }
+    }
+  }
+
+  T* from = items;
+  T* to = buf;
+  for (size_t pass = 0; pass < kPasses; ++pass) {
+    const size_t shift = RT::kFirstShift + pass * kRadixBits;
+    size_t* HWY_RESTRICT histogram = histograms.get() + pass * kRadixBuckets;
+
+    // Skip the scatter if all items have the same digit, which is common for
+    // the upper digits of keys with a narrow range.
+    rt.Digits(d, from, 1, shift, digits);
+    if (histogram[digits[0]] == num) continue;
+
+    // Exclusive prefix sum: histogram[digit] is then the first output index.
+    size_t sum = 0;
+    for (size_t digit = 0; digit < kRadixBuckets; ++digit) {
+      const size_t count = histogram[digit];
+      histogram[digit] = sum;
+      sum += count;
+    }
+
+    for (size_t i = 0; i < num; i += kRadixBlockItems) {
+      const size_t count = HWY_MIN(kRadixBlockItems, num - i);
+      const T* HWY_RESTRICT block = from + i * kLanes;
+      rt.Digits(d, block, count, shift, digits);
+      for (size_t j = 0; j < count; ++j) {
+        T* HWY_RESTRICT dst = to + histogram[digits[j]]++ * kLanes;
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+          dst[lane] = block[j * kLanes + lane];
+        }
+      }
+    }
+
+    T* const tmp = from;
+    from = to;
+    to = tmp;
+  }
+
+  // Convert back to keys and, after an odd number of scatters, move to `items`.
+  rt.FromOrdered(d, from, num, items);
+}
+
+}  // namespace detail
+
+// Sorts keys[0, num_keys) with a vectorized LSD radix sort. Key is one of
+// uint16_t, uint32_t, uint64_t, int16_t, int32_t, int64_t, float16_t, float,
+// double, uint128_t, K64V64, K32V32. Unlike VQSortStatic, this does not
+// require HWY_HAVE_FLOAT16/64 because it only uses integer ops, but 128-bit
+// keys still require 128-bit vectors. Order is either SortAscending or
+// SortDescending. As with VQSort, NaN are moved to the back; -0 precedes +0
+// in ascending order. Allocates num_keys keys of temporary memory. The number
+// of passes over memory grows with sizeof(Key) but skips digits that are the
+// same for all keys, which makes this faster than VQSortStatic for large
+// arrays of integer keys with a narrow range.
+template <typename Key, class Order>
+void VQRadixSortStatic(Key* HWY_RESTRICT keys, const size_t num_keys, Order) {
+  if (num_keys < 2) return;
+  const detail::MakeRadixTraits<Key, Order> rt;
+  using LaneType = typename decltype(rt)::LaneType;
+  const ScalableTag<LaneType> d;
+  const size_t num_lanes = num_keys * rt.kLanesPerItem;
+  auto buf = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(buf);
+  detail::RadixSort(d, rt, reinterpret_cast<LaneType*>(keys), num_keys,
+                    buf.get());
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQRADIX_TOGGLE
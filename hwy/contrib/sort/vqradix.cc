@@ -0,0 +1,340 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/sort/vqradix.h"  // VQRadixSort
+
+#include <stddef.h>
+
+#include "hwy/contrib/sort/vqsort.h"  // VQSort
+#include "hwy/per_target.h"          // HaveFloat16
+
+#undef HWY_TARGET_INCLUDE
+// clang-format off
+// (avoid line break, which would prevent Copybara rules from matching)
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqradix.cc"  //NOLINT
+// clang-format on
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqradix-inl.h"
+
+// All key types are in a single file because radix sort is much smaller than
+// the sorting networks of VQSort, and hence quick to compile.
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+void RadixSortU16Asc(uint16_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortU16Desc(uint16_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortU32Asc(uint32_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortU32Desc(uint32_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortU64Asc(uint64_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortU64Desc(uint64_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortI16Asc(int16_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortI16Desc(int16_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortI32Asc(int32_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortI32Desc(int32_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortI64Asc(int64_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortI64Desc(int64_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortF16Asc(float16_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortF16Desc(float16_t* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortF32Asc(float* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortF32Desc(float* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortF64Asc(double* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortF64Desc(double* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortKV64Asc(K32V32* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortAscending());
+}
+
+void RadixSortKV64Desc(K32V32* HWY_RESTRICT keys, const size_t num) {
+  return VQRadixSortStatic(keys, num, SortDescending());
+}
+
+void RadixSortU128Asc(uint128_t* HWY_RESTRICT keys, const size_t num) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQRadixSortStatic(keys, num, SortAscending());
+#else
+  (void)keys;
+  (void)num;
+#endif
+}
+
+void RadixSortU128Desc(uint128_t* HWY_RESTRICT keys, const size_t num) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQRadixSortStatic(keys, num, SortDescending());
+#else
+  (void)keys;
+  (void)num;
+#endif
+}
+
+void RadixSortKV128Asc(K64V64* HWY_RESTRICT keys, const size_t num) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQRadixSortStatic(keys, num, SortAscending());
+#else
+  (void)keys;
+  (void)num;
+#endif
+}
+
+void RadixSortKV128Desc(K64V64* HWY_RESTRICT keys, const size_t num) {
+  // 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQRadixSortStatic(keys, num, SortDescending());
+#else
+  (void)keys;
+  (void)num;
+#endif
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(RadixSortU16Asc);
+HWY_EXPORT(RadixSortU16Desc);
+HWY_EXPORT(RadixSortU32Asc);
+HWY_EXPORT(RadixSortU32Desc);
+HWY_EXPORT(RadixSortU64Asc);
+HWY_EXPORT(RadixSortU64Desc);
+HWY_EXPORT(RadixSortI16Asc);
+HWY_EXPORT(RadixSortI16Desc);
+HWY_EXPORT(RadixSortI32Asc);
+HWY_EXPORT(RadixSortI32Desc);
+HWY_EXPORT(RadixSortI64Asc);
+HWY_EXPORT(RadixSortI64Desc);
+HWY_EXPORT(RadixSortF16Asc);
+HWY_EXPORT(RadixSortF16Desc);
+HWY_EXPORT(RadixSortF32Asc);
+HWY_EXPORT(RadixSortF32Desc);
+HWY_EXPORT(RadixSortF64Asc);
+HWY_EXPORT(RadixSortF64Desc);
+HWY_EXPORT(RadixSortKV64Asc);
+HWY_EXPORT(RadixSortKV64Desc);
+HWY_EXPORT(RadixSortU128Asc);
+HWY_EXPORT(RadixSortU128Desc);
+HWY_EXPORT(RadixSortKV128Asc);
+HWY_EXPORT(RadixSortKV128Desc);
+
+// Below this size, the histogram overhead outweighs the savings vs. VQSort.
+constexpr size_t kMinRadixKeys = 1024;
+
+}  // namespace
+
+void VQRadixSort(uint16_t* HWY_RESTRICT keys, const size_t n,
+                 SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortU16Asc)(keys, n);
+}
+
+void VQRadixSort(uint16_t* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortU16Desc)(keys, n);
+}
+
+void VQRadixSort(uint32_t* HWY_RESTRICT keys, const size_t n,
+                 SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortU32Asc)(keys, n);
+}
+
+void VQRadixSort(uint32_t* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortU32Desc)(keys, n);
+}
+
+void VQRadixSort(uint64_t* HWY_RESTRICT keys, const size_t n,
+                 SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortU64Asc)(keys, n);
+}
+
+void VQRadixSort(uint64_t* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortU64Desc)(keys, n);
+}
+
+void VQRadixSort(int16_t* HWY_RESTRICT keys, const size_t n,
+                 SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortI16Asc)(keys, n);
+}
+
+void VQRadixSort(int16_t* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortI16Desc)(keys, n);
+}
+
+void VQRadixSort(int32_t* HWY_RESTRICT keys, const size_t n,
+                 SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortI32Asc)(keys, n);
+}
+
+void VQRadixSort(int32_t* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortI32Desc)(keys, n);
+}
+
+void VQRadixSort(int64_t* HWY_RESTRICT keys, const size_t n,
+                 SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortI64Asc)(keys, n);
+}
+
+void VQRadixSort(int64_t* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortI64Desc)(keys, n);
+}
+
+void VQRadixSort(float16_t* HWY_RESTRICT keys, const size_t n,
+                 SortAscending tag) {
+  if (n < kMinRadixKeys && HaveFloat16()) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortF16Asc)(keys, n);
+}
+
+void VQRadixSort(float16_t* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys && HaveFloat16()) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortF16Desc)(keys, n);
+}
+
+void VQRadixSort(float* HWY_RESTRICT keys, const size_t n, SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortF32Asc)(keys, n);
+}
+
+void VQRadixSort(float* HWY_RESTRICT keys, const size_t n, SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortF32Desc)(keys, n);
+}
+
+void VQRadixSort(double* HWY_RESTRICT keys, const size_t n, SortAscending tag) {
+  if (n < kMinRadixKeys && HaveFloat64()) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortF64Asc)(keys, n);
+}
+
+void VQRadixSort(double* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys && HaveFloat64()) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortF64Desc)(keys, n);
+}
+
+void VQRadixSort(K32V32* HWY_RESTRICT keys, const size_t n, SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortKV64Asc)(keys, n);
+}
+
+void VQRadixSort(K32V32* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortKV64Desc)(keys, n);
+}
+
+void VQRadixSort(uint128_t* HWY_RESTRICT keys, const size_t n,
+                 SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortU128Asc)(keys, n);
+}
+
+void VQRadixSort(uint128_t* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortU128Desc)(keys, n);
+}
+
+void VQRadixSort(K64V64* HWY_RESTRICT keys, const size_t n, SortAscending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortKV128Asc)(keys, n);
+}
+
+void VQRadixSort(K64V64* HWY_RESTRICT keys, const size_t n,
+                 SortDescending tag) {
+  if (n < kMinRadixKeys) return VQSort(keys, n, tag);
+  HWY_DYNAMIC_DISPATCH(RadixSortKV128Desc)(keys, n);
+}
+
+}  // namespace hwy
+#endif  // HWY_ONCE
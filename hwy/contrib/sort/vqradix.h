@@ -0,0 +1,98 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Interface to vectorized LSD radix sort with dynamic dispatch. For static
+// dispatch, call VQRadixSortStatic in vqradix-inl.h.
+//
+// Radix sort is not comparison-based, so its cost is proportional to the
+// number of keys times the number of 8-bit digits in which keys differ. It is
+// typically faster than VQSort for large arrays of integer keys whose values
+// span a narrow range, but slower for small arrays or 64-bit keys with
+// uniformly distributed bits. Compare both with bench_sort on your data.
+
+#ifndef HIGHWAY_HWY_CONTRIB_SORT_VQRADIX_H_
+#define HIGHWAY_HWY_CONTRIB_SORT_VQRADIX_H_
+
+// IWYU pragma: begin_exports
+#include <stddef.h>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"  // SortAscending
+// IWYU pragma: end_exports
+
+namespace hwy {
+
+// Sorts keys[0, n) into the same order as VQSort, except that -0 precedes +0
+// in ascending order. Like VQSort, it is not stable and any NaN are moved to
+// the back. Allocates n keys of temporary memory; small inputs are instead
+// passed to VQSort.
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+
+// Unlike VQSort, these do not require hwy::HaveFloat16()/HaveFloat64() because
+// only integer operations are used.
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(float* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(float* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(double* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(double* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+
+// 128-bit types: `n` is still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                       SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQRadixSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                       SortDescending);
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQRADIX_H_
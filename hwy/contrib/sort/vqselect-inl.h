@@ -0,0 +1,158 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_VQSELECT_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_VQSELECT_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_VQSELECT_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_VQSELECT_TOGGLE
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"       // SortAscending
+#include "hwy/contrib/sort/vqsort-inl.h"  // PartitionStep
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+#if VQSORT_ENABLED || HWY_IDE
+
+// As Recurse<kSelect>, but for several order statistics `ks[0, num_ks)`, which
+// are ascending key indices relative to `keys - begin`; `begin` is in lanes.
+// Each partition step is shared by all k, and only subarrays containing at
+// least one k are visited, hence the cost is similar to a single Select for
+// a handful of k, rather than one Select per k.
+template <class D, class Traits, typename T>
+HWY_NOINLINE void RecurseMultiSelect(D d, Traits st, T* HWY_RESTRICT keys,
+                                     const size_t begin, const size_t num,
+                                     const size_t* HWY_RESTRICT ks,
+                                     const size_t num_ks, T* HWY_RESTRICT buf,
+                                     uint64_t* HWY_RESTRICT state,
+                                     const size_t remaining_levels) {
+  HWY_DASSERT(num != 0 && num_ks != 0);
+  constexpr size_t kLPK = st.LanesPerKey();
+  if (HWY_UNLIKELY(num <= Constants::BaseCaseNumLanes<kLPK>(Lanes(d)))) {
+    BaseCase(d, st, keys, num, buf);
+    return;
+  }
+
+  if (VQSORT_PRINT >= 1) {
+    fprintf(stderr, "\n\n=== MultiSelect depth=%zu len=%zu num_ks=%zu\n",
+            remaining_levels, num, num_ks);
+  }
+
+  size_t bound;
+  PivotResult result;
+  if (!PartitionStep(d, st, keys, num, buf, state, remaining_levels, bound,
+                     result)) {
+    return;
+  }
+
+  // The k are ascending, hence those in the left partition are a prefix.
+  size_t num_left = 0;
+  while (num_left < num_ks && ks[num_left] * kLPK < begin + bound) {
+    ++num_left;
+  }
+  if (HWY_LIKELY(result != PivotResult::kIsFirst) && num_left != 0) {
+    RecurseMultiSelect(d, st, keys, begin, bound, ks, num_left, buf, state,
+                       remaining_levels - 1);
+  }
+  if (HWY_LIKELY(result != PivotResult::kWasLast) && num_left != num_ks) {
+    RecurseMultiSelect(d, st, keys + bound, begin + bound, num - bound,
+                       ks + num_left, num_ks - num_left, buf, state,
+                       remaining_levels - 1);
+  }
+}
+
+#endif  // VQSORT_ENABLED
+
+// `num` is in lanes, `ks` in keys.
+template <class D, class Traits, typename T>
+void MultiSelect(D d, Traits st, T* HWY_RESTRICT keys, const size_t num,
+                 const size_t* HWY_RESTRICT ks, const size_t num_ks) {
+#if HWY_MAX_BYTES > 64
+  // sorting_networks-inl and traits assume no more than 512 bit vectors.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return MultiSelect(CappedTag<T, 64 / sizeof(T)>(), st, keys, num, ks,
+                       num_ks);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+  constexpr size_t kLPK = st.LanesPerKey();
+  for (size_t i = 0; i < num_ks; ++i) {
+    HWY_DASSERT(ks[i] * kLPK < num);
+    HWY_DASSERT(i == 0 || ks[i - 1] <= ks[i]);
+  }
+  if (num_ks == 0) return;
+
+  const size_t num_nan = CountAndReplaceNaN(d, st, keys, num);
+
+#if VQSORT_ENABLED || HWY_IDE
+  HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) / sizeof(T)];
+  if (!HandleSpecialCases(d, st, keys, num, buf)) {
+    uint64_t* HWY_RESTRICT state = hwy::detail::GetGeneratorStateStatic();
+    const size_t max_levels = 50;  // as in Select
+    RecurseMultiSelect(d, st, keys, 0, num, ks, num_ks, buf, state,
+                       max_levels);
+  }
+#else   // !VQSORT_ENABLED
+  (void)ks;
+  (void)kLPK;
+  if (VQSORT_PRINT >= 1) {
+    HWY_WARN("using slow HeapSort because vqsort disabled\n");
+  }
+  HeapSort(st, keys, num);
+#endif  // VQSORT_ENABLED
+
+  if (num_nan != 0) {
+    Fill(d, GetLane(NaN(d)), num_nan, keys + num - num_nan);
+  }
+}
+
+}  // namespace detail
+
+// Generalization of VQSelectStatic to several order statistics, e.g. the
+// p50, p99 and p999 of latencies. `ks[0, num_ks)` must be ascending (possibly
+// with duplicates) and less than `num_keys`. Afterwards, each `keys[ks[i]]` is
+// the key that would be there if `keys` were sorted according to Order, and
+// the keys between consecutive `ks` are partitioned accordingly. This is
+// faster than one VQSelectStatic per k because each partition step is shared.
+// Supports the same key types as VQSortStatic.
+template <typename Key, class Order>
+void VQMultiSelectStatic(Key* HWY_RESTRICT keys, const size_t num_keys,
+                         const size_t* HWY_RESTRICT ks, const size_t num_ks,
+                         Order) {
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  detail::MultiSelect(d, st, reinterpret_cast<LaneType*>(keys),
+                      num_keys * st.LanesPerKey(), ks, num_ks);
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQSELECT_TOGGLE
@@ -22,15 +22,20 @@
 // unconditional #include so we can use if(VQSORT_PRINT), which unlike #if does
 // not interfere with code-folding.
 #include <stdio.h>
-#include <time.h>  // clock
+#include <string.h>  // memmove
+#include <time.h>    // clock
+
+#include <algorithm>  // std::sort
+#include <vector>
 
 // IWYU pragma: begin_exports
 #include "hwy/base.h"
 #include "hwy/contrib/sort/order.h"  // SortAscending
 // IWYU pragma: end_exports
 
-#include "hwy/cache_control.h"  // Prefetch
-#include "hwy/print.h"          // unconditional, see above.
+#include "hwy/aligned_allocator.h"  // AllocateAligned
+#include "hwy/cache_control.h"      // Prefetch
+#include "hwy/print.h"              // unconditional, see above.
 
 // If 1, VQSortStatic can be called without including vqsort.h, and we avoid
 // any DLLEXPORT. This simplifies integration into other build systems, but
@@ -1758,36 +1763,28 @@ HWY_NOINLINE void PrintMinMax(D d, Traits st, const T* HWY_RESTRICT keys,
   }
 }
 
-template <RecurseMode mode, class D, class Traits, typename T>
-HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
-                          const size_t num, T* HWY_RESTRICT buf,
-                          uint64_t* HWY_RESTRICT state,
-                          const size_t remaining_levels, const size_t k = 0) {
-  HWY_DASSERT(num != 0);
-
-  const size_t N = Lanes(d);
-  constexpr size_t kLPK = st.LanesPerKey();
-  if (HWY_UNLIKELY(num <= Constants::BaseCaseNumLanes<kLPK>(N))) {
-    BaseCase(d, st, keys, num, buf);
-    return;
-  }
-
-  // Move after BaseCase so we skip printing for small subarrays.
-  if (VQSORT_PRINT >= 1) {
-    fprintf(stderr, "\n\n=== Recurse depth=%zu len=%zu k=%zu\n",
-            remaining_levels, num, k);
-    PrintMinMax(d, st, keys, num, buf);
-  }
-
+// Chooses a pivot for `keys[0, num)` and partitions them accordingly. Returns
+// false if no further recursion is required, either because all keys are equal,
+// or they were partitioned into two distinct values, or `remaining_levels` is
+// zero, in which case they are sorted via HeapSort. Otherwise, sets `bound` to
+// the index of the first key in the right partition, and `result` indicates
+// whether either partition is known to consist only of keys equal to the pivot.
+// Shared by `Recurse` and `SortParallel`.
+template <class D, class Traits, typename T>
+HWY_INLINE bool PartitionStep(D d, Traits st, T* HWY_RESTRICT keys,
+                              const size_t num, T* HWY_RESTRICT buf,
+                              uint64_t* HWY_RESTRICT state,
+                              const size_t remaining_levels, size_t& bound,
+                              PivotResult& result) {
   DrawSamples(d, st, keys, num, buf, state);
 
   Vec<D> pivot;
-  PivotResult result = PivotResult::kNormal;
+  result = PivotResult::kNormal;
   if (HWY_UNLIKELY(UnsortedSampleEqual(d, st, buf))) {
     pivot = st.SetKey(d, buf);
     size_t idx_second = 0;
     if (HWY_UNLIKELY(AllEqual(d, st, pivot, keys, num, &idx_second))) {
-      return;
+      return false;
     }
     HWY_DASSERT(idx_second % st.LanesPerKey() == 0);
     // Must capture the value before PartitionIfTwoKeys may overwrite it.
@@ -1801,7 +1798,7 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
     if (HWY_UNLIKELY(!st.IsKV() &&
                      PartitionIfTwoKeys(d, st, pivot, keys, num, idx_second,
                                         second, third, buf))) {
-      return;  // Done, skip recursion because each side has all-equal keys.
+      return false;  // Done: each side has all-equal keys, skip recursion.
     }
 
     // We can no longer start scanning from idx_second because
@@ -1818,7 +1815,7 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
     // but not interchangeable (their values may differ).
     if (HWY_UNLIKELY(!st.IsKV() &&
                      PartitionIfTwoSamples(d, st, keys, num, buf))) {
-      return;
+      return false;
     }
 
     pivot = ChoosePivotByRank(d, st, buf);
@@ -1831,10 +1828,10 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
       fprintf(stderr, "HeapSort reached, size=%zu\n", num);
     }
     HeapSort(st, keys, num);  // Slow but N*logN.
-    return;
+    return false;
   }
 
-  const size_t bound = Partition(d, st, keys, num, pivot, buf);
+  bound = Partition(d, st, keys, num, pivot, buf);
   if (VQSORT_PRINT >= 2) {
     fprintf(stderr, "bound %zu num %zu result %s\n", bound, num,
             PivotResultString(result));
@@ -1853,6 +1850,36 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
   // except in the rare case of the pivot matching the last-in-sort-order value,
   // which implies we anyway skip the right partition due to kWasLast.
   HWY_DASSERT(bound != num || result == PivotResult::kWasLast);
+  return true;
+}
+
+template <RecurseMode mode, class D, class Traits, typename T>
+HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
+                          const size_t num, T* HWY_RESTRICT buf,
+                          uint64_t* HWY_RESTRICT state,
+                          const size_t remaining_levels, const size_t k = 0) {
+  HWY_DASSERT(num != 0);
+
+  const size_t N = Lanes(d);
+  constexpr size_t kLPK = st.LanesPerKey();
+  if (HWY_UNLIKELY(num <= Constants::BaseCaseNumLanes<kLPK>(N))) {
+    BaseCase(d, st, keys, num, buf);
+    return;
+  }
+
+  // Move after BaseCase so we skip printing for small subarrays.
+  if (VQSORT_PRINT >= 1) {
+    fprintf(stderr, "\n\n=== Recurse depth=%zu len=%zu k=%zu\n",
+            remaining_levels, num, k);
+    PrintMinMax(d, st, keys, num, buf);
+  }
+
+  size_t bound;
+  PivotResult result;
+  if (!PartitionStep(d, st, keys, num, buf, state, remaining_levels, bound,
+                     result)) {
+    return;
+  }
 
   HWY_IF_CONSTEXPR(mode == RecurseMode::kSelect) {
     if (HWY_LIKELY(result != PivotResult::kIsFirst) && k < bound) {
@@ -1875,6 +1902,117 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
   }
 }
 
+// ------------------------------ Presorted input
+
+// Returns the number of lanes in the longest prefix of `keys` that is sorted
+// according to `st`, or if kReverse, in the opposite order. Equal keys are
+// sorted in either order. Exits at the first unsorted key, hence this is cheap
+// for random inputs. Requires num >= N + kLPK (see HandleSpecialCases).
+template <bool kReverse, class D, class Traits, typename T>
+HWY_INLINE size_t SortedPrefix(D d, Traits st, const T* HWY_RESTRICT keys,
+                               const size_t num) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t N = Lanes(d);
+  HWY_DASSERT(num >= N + kLPK);
+  // Compares each key with its successor. The last vector may overlap.
+  const size_t last = num - N - kLPK;
+  for (size_t i = 0;; i += N) {
+    i = HWY_MIN(i, last);
+    const Vec<D> v = LoadU(d, keys + i);
+    const Vec<D> next = LoadU(d, keys + i + kLPK);
+    const Mask<D> unsorted =
+        kReverse ? st.Compare(d, v, next) : st.Compare(d, next, v);
+    const intptr_t pos = FindFirstTrue(d, unsorted);
+    if (pos >= 0) return i + static_cast<size_t>(pos) + kLPK;
+    if (i == last) return num;
+  }
+}
+
+// Reverses the order of the keys, e.g. to sort descending input.
+template <class D, class Traits, typename T>
+HWY_INLINE void ReverseInPlace(D d, Traits st, T* HWY_RESTRICT keys,
+                               const size_t num) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t N = Lanes(d);
+  size_t begin = 0;
+  size_t end = num;
+  for (; end - begin >= 2 * N; begin += N, end -= N) {
+    const Vec<D> first = LoadU(d, keys + begin);
+    const Vec<D> last = LoadU(d, keys + end - N);
+    StoreU(st.ReverseKeys(d, last), d, keys + begin);
+    StoreU(st.ReverseKeys(d, first), d, keys + end - N);
+  }
+  HWY_ALIGN T tmp[2];
+  for (; end - begin >= 2 * kLPK; begin += kLPK, end -= kLPK) {
+    CopyBytes<kLPK * sizeof(T)>(keys + begin, tmp);
+    CopyBytes<kLPK * sizeof(T)>(keys + end - kLPK, keys + begin);
+    CopyBytes<kLPK * sizeof(T)>(tmp, keys + end - kLPK);
+  }
+}
+
+// Sorts keys[sorted, num), which must be at most the base case size, and
+// merges them into the already sorted keys[0, sorted). Inserting each of the
+// few keys at the position found by binary search requires only one (bulk)
+// move of each sorted key.
+template <class D, class Traits, typename T>
+HWY_NOINLINE void MergeSortedTail(D d, Traits st, T* HWY_RESTRICT keys,
+                                  const size_t num, const size_t sorted,
+                                  T* HWY_RESTRICT buf) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t num_tail = num - sorted;
+  BaseCase(d, st, keys + sorted, num_tail, buf);
+  CopyBytes(keys + sorted, buf, num_tail * sizeof(T));
+
+  size_t end = sorted;  // keys[0, end) have not yet moved.
+  for (size_t remaining = num_tail; remaining != 0; remaining -= kLPK) {
+    const T* HWY_RESTRICT key = buf + remaining - kLPK;
+    // Upper bound: index of the first key that `key` is before.
+    size_t lo = 0;
+    size_t hi = end / kLPK;
+    while (lo < hi) {
+      const size_t mid = (lo + hi) / 2;
+      if (st.Compare1(key, keys + mid * kLPK)) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    const size_t pos = lo * kLPK;
+    memmove(keys + pos + remaining, keys + pos, (end - pos) * sizeof(T));
+    CopyBytes<kLPK * sizeof(T)>(key, keys + pos + remaining - kLPK);
+    end = pos;
+  }
+}
+
+// Returns true if `keys` were already sorted, or could be sorted in O(num)
+// because they are in reverse order, or only a few trailing keys are unsorted.
+template <class D, class Traits, typename T>
+HWY_INLINE bool HandlePresorted(D d, Traits st, T* HWY_RESTRICT keys,
+                                const size_t num, const size_t base_case_num,
+                                T* HWY_RESTRICT buf) {
+  const size_t sorted = SortedPrefix<false>(d, st, keys, num);
+  if (sorted == num) {
+    if (VQSORT_PRINT >= 1) fprintf(stderr, "Already sorted\n");
+    return true;
+  }
+  if (num - sorted <= base_case_num) {
+    if (VQSORT_PRINT >= 1) {
+      fprintf(stderr, "Merging unsorted tail of %zu\n", num - sorted);
+    }
+    MergeSortedTail(d, st, keys, num, sorted, buf);
+    return true;
+  }
+  // Not sorted, and too many keys follow the sorted prefix to merge them. If
+  // all keys are in the opposite order (equal neighbors are allowed because
+  // this sort is not stable), reversing them sorts them.
+  if (SortedPrefix<true>(d, st, keys, num) == num) {
+    if (VQSORT_PRINT >= 1) fprintf(stderr, "Reversing\n");
+    ReverseInPlace(d, st, keys, num);
+    return true;
+  }
+  return false;
+}
+
 // Returns true if sorting is finished.
 template <class D, class Traits, typename T>
 HWY_INLINE bool HandleSpecialCases(D d, Traits st, T* HWY_RESTRICT keys,
@@ -1913,10 +2051,9 @@ HWY_INLINE bool HandleSpecialCases(D d, Traits st, T* HWY_RESTRICT keys,
     return true;
   }
 
-  // We could also check for already sorted/reverse/equal, but that's probably
-  // counterproductive if vqsort is used as a base case.
-
-  return false;  // not finished sorting
+  // Inputs are often sorted, reversed, or have a few keys appended to sorted
+  // keys. Checking is cheap because it stops at the first unsorted key.
+  return HandlePresorted(d, st, keys, num, base_case_num, buf);
 }
 
 #endif  // VQSORT_ENABLED
@@ -1952,6 +2089,126 @@ HWY_INLINE size_t CountAndReplaceNaN(D, Traits, T* HWY_RESTRICT, size_t) {
   return 0;
 }
 
+// ------------------------------ Parallel sort
+
+#if VQSORT_ENABLED || HWY_IDE
+
+// Below this size, `SortParallel` is single-threaded because the fork-join
+// overhead would outweigh any speedup.
+static constexpr size_t kMinParallelSortBytes = 256 * 1024;
+// Subarrays are partitioned until there are at least this many per worker, so
+// that workers finishing early can take over others' work.
+static constexpr size_t kParallelSubarraysPerWorker = 8;
+// Subarrays at most this size are no longer partitioned in parallel.
+static constexpr size_t kMinParallelSubarrayBytes = 32 * 1024;
+
+// Subarray, in units of lanes, which `SortParallel` has yet to partition or
+// sort. `remaining_levels` is the recursion budget passed to `Recurse`.
+struct ParallelRange {
+  size_t begin;
+  size_t num;
+  size_t remaining_levels;
+};
+
+// Same as `CountAndReplaceNaN`, but each worker handles a contiguous part.
+template <class D, class Traits, typename T, class Pool>
+size_t CountAndReplaceNaNParallel(D d, Traits st, T* HWY_RESTRICT keys,
+                                  size_t num, Pool& pool) {
+  if (!hwy::IsFloat<T>()) return 0;  // Skip the Run if nothing to do.
+
+  const size_t num_tasks = pool.NumWorkers();
+  const size_t lanes_per_task = hwy::DivCeil(num, num_tasks);
+  std::vector<size_t> num_nan(num_tasks, 0);
+  pool.Run(0, num_tasks, [&](uint64_t task, size_t /*worker*/) HWY_ATTR {
+    const size_t begin = static_cast<size_t>(task) * lanes_per_task;
+    if (begin >= num) return;
+    const size_t my_num = HWY_MIN(lanes_per_task, num - begin);
+    num_nan[task] = CountAndReplaceNaN(d, st, keys + begin, my_num);
+  });
+
+  size_t sum = 0;
+  for (size_t n : num_nan) sum += n;
+  return sum;
+}
+
+// Partitions `keys[0, num)` into subarrays, one level at a time, each of which
+// is partitioned by any worker. Then sorts the resulting subarrays via
+// `Recurse`, also in parallel. The first partition is single-threaded, but the
+// total critical path is still only about twice the cost of one Partition.
+template <class D, class Traits, typename T, class Pool>
+void PartitionAndSortParallel(D d, Traits st, T* HWY_RESTRICT keys,
+                              const size_t num, Pool& pool) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t num_workers = pool.NumWorkers();
+  // Subarrays larger than this are further partitioned.
+  const size_t max_lanes =
+      HWY_MAX(num / (num_workers * kParallelSubarraysPerWorker),
+              kMinParallelSubarrayBytes / sizeof(T));
+  HWY_DASSERT(max_lanes > Constants::BaseCaseNumLanes<kLPK>(Lanes(d)));
+
+  // Introspection: see `Sort`.
+  const size_t max_levels = 50;
+  std::vector<ParallelRange> to_sort;
+  std::vector<ParallelRange> to_partition;
+  (num > max_lanes ? to_partition : to_sort)
+      .push_back(ParallelRange{0, num, max_levels});
+
+  std::vector<ParallelRange> children;
+  while (!to_partition.empty()) {
+    // Two per partitioned subarray; empty if they do not require sorting.
+    children.assign(2 * to_partition.size(), ParallelRange{0, 0, 0});
+    pool.Run(
+        0, to_partition.size(), [&](uint64_t task, size_t /*worker*/) HWY_ATTR {
+          const ParallelRange& range = to_partition[task];
+          HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) /
+                          sizeof(T)];
+          uint64_t* HWY_RESTRICT state = hwy::detail::GetGeneratorStateStatic();
+          size_t bound;
+          PivotResult result;
+          if (!PartitionStep(d, st, keys + range.begin, range.num, buf, state,
+                             range.remaining_levels, bound, result)) {
+            return;  // Already finished.
+          }
+
+          const size_t levels = range.remaining_levels - 1;
+          if (HWY_LIKELY(result != PivotResult::kIsFirst)) {
+            children[2 * task] = ParallelRange{range.begin, bound, levels};
+          }
+          if (HWY_LIKELY(result != PivotResult::kWasLast)) {
+            children[2 * task + 1] =
+                ParallelRange{range.begin + bound, range.num - bound, levels};
+          }
+        });
+
+    to_partition.clear();
+    for (const ParallelRange& child : children) {
+      if (child.num == 0) continue;
+      (child.num > max_lanes ? to_partition : to_sort).push_back(child);
+    }
+  }
+
+  // Start with the largest subarrays to reduce imbalance at the end.
+  std::sort(to_sort.begin(), to_sort.end(),
+            [](const ParallelRange& a, const ParallelRange& b) {
+              return a.num > b.num;
+            });
+  if (VQSORT_PRINT >= 1) {
+    fprintf(stderr, "SortParallel: %zu subarrays, largest %zu lanes\n",
+            to_sort.size(), to_sort.empty() ? size_t{0} : to_sort[0].num);
+  }
+
+  pool.Run(0, to_sort.size(), [&](uint64_t task, size_t /*worker*/) HWY_ATTR {
+    const ParallelRange& range = to_sort[task];
+    HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) /
+                    sizeof(T)];
+    uint64_t* HWY_RESTRICT state = hwy::detail::GetGeneratorStateStatic();
+    Recurse<RecurseMode::kSort>(d, st, keys + range.begin, range.num, buf,
+                                state, range.remaining_levels);
+  });
+}
+
+#endif  // VQSORT_ENABLED
+
 }  // namespace detail
 
 // Old interface with user-specified buffer, retained for compatibility. Called
@@ -2126,6 +2383,50 @@ HWY_API void Select(D d, Traits st, T* HWY_RESTRICT keys, const size_t num,
   Select(d, st, keys, num, k, buf);
 }
 
+// Same as `Sort`, but uses all workers of `pool`, which is typically a
+// hwy::ThreadPool, or any class with `NumWorkers()` and `Run(begin, end,
+// closure)` that calls `closure(task, worker)` for each task. Partitions in
+// parallel until there are enough subarrays for each worker, which then sort
+// them independently. Unlike `Sort`, allocates O(NumWorkers()) memory. Falls
+// back to `Sort` if there is only one worker or `num` is too small to benefit.
+template <class D, class Traits, typename T, class Pool>
+void SortParallel(D d, Traits st, T* HWY_RESTRICT keys, const size_t num,
+                  Pool& pool) {
+  if (VQSORT_PRINT >= 1) {
+    fprintf(stderr,
+            "=============== SortParallel %s num=%zu, workers=%zu vec "
+            "bytes=%zu\n",
+            st.KeyString(), num, pool.NumWorkers(), sizeof(T) * Lanes(d));
+  }
+
+#if HWY_MAX_BYTES > 64
+  // sorting_networks-inl and traits assume no more than 512 bit vectors.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return SortParallel(CappedTag<T, 64 / sizeof(T)>(), st, keys, num, pool);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+  constexpr size_t kLPK = st.LanesPerKey();
+  HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) / sizeof(T)];
+
+#if VQSORT_ENABLED || HWY_IDE
+  if (pool.NumWorkers() > 1 &&
+      num * sizeof(T) >= detail::kMinParallelSortBytes) {
+    const size_t num_nan =
+        detail::CountAndReplaceNaNParallel(d, st, keys, num, pool);
+    if (!detail::HandleSpecialCases(d, st, keys, num, buf)) {
+      detail::PartitionAndSortParallel(d, st, keys, num, pool);
+    }
+    if (num_nan != 0) {
+      Fill(d, GetLane(NaN(d)), num_nan, keys + num - num_nan);
+    }
+    return;
+  }
+#endif  // VQSORT_ENABLED
+
+  Sort(d, st, keys, num, buf);
+}
+
 // Translates Key and Order (SortAscending or SortDescending) to SharedTraits.
 namespace detail {
 
@@ -2204,6 +2505,277 @@ void VQSelectStatic(Key* HWY_RESTRICT keys, const size_t num_keys,
          k_keys * st.LanesPerKey());
 }
 
+// Same as `VQSortStatic`, but uses all workers of `pool`, see `SortParallel`.
+template <typename Key, class Order, class Pool>
+void VQSortParallelStatic(Key* HWY_RESTRICT keys, const size_t num_keys, Order,
+                          Pool& pool) {
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  SortParallel(d, st, reinterpret_cast<LaneType*>(keys),
+               num_keys * st.LanesPerKey(), pool);
+}
+
+namespace detail {
+
+// Argsort packs the sortable bits of each key (see SortableBitsFromKeyBits)
+// together with its index into a single unsigned integer, sorts these with
+// VQSort and then extracts the indices. Because the index is the less
+// significant part, ties are broken by index, hence the argsort is stable.
+
+// Returns the sortable bits of `Lanes(d64)` keys, zero-extended to u64.
+template <typename Key, class Order, class D64, HWY_IF_T_SIZE(Key, 8)>
+HWY_INLINE Vec<D64> ArgSortBits(D64 d64, const Key* HWY_RESTRICT keys) {
+  using TU = MakeUnsigned<Key>;
+  const Vec<D64> bits = LoadU(d64, reinterpret_cast<const TU*>(keys));
+  return SortableBitsFromKeyBits<Key, Order>(d64, bits);
+}
+template <typename Key, class Order, class D64, HWY_IF_NOT_T_SIZE(Key, 8)>
+HWY_INLINE Vec<D64> ArgSortBits(D64 d64, const Key* HWY_RESTRICT keys) {
+  using TU = MakeUnsigned<Key>;
+  const Rebind<TU, D64> du;
+  const Vec<decltype(du)> bits =
+      LoadU(du, reinterpret_cast<const TU*>(keys));
+  return PromoteTo(d64, SortableBitsFromKeyBits<Key, Order>(du, bits));
+}
+
+template <class D64>
+HWY_INLINE void ArgSortStoreIndices(D64 d64, Vec<D64> v,
+                                    uint64_t* HWY_RESTRICT indices) {
+  StoreU(v, d64, indices);
+}
+template <class D64>
+HWY_INLINE void ArgSortStoreIndices(D64 /* tag */, Vec<D64> v,
+                                    uint32_t* HWY_RESTRICT indices) {
+  const Rebind<uint32_t, D64> d32;
+  StoreU(TruncateTo(d32, v), d32, indices);
+}
+
+// Each u64 holds the key bits in its upper `8 * sizeof(Key)` bits and the
+// index in the remaining lower bits, which must be enough for `num - 1`.
+template <typename Key, class Order, typename Index>
+void ArgSortPacked64(const Key* HWY_RESTRICT keys, const size_t num,
+                     Index* HWY_RESTRICT indices) {
+  constexpr int kIndexBits = 64 - static_cast<int>(sizeof(Key) * 8);
+  const ScalableTag<uint64_t> d64;
+  const CappedTag<uint64_t, 1> d1;
+  using V64 = Vec<decltype(d64)>;
+  const size_t N = Lanes(d64);
+
+  auto packed = hwy::AllocateAligned<uint64_t>(num);
+  HWY_ASSERT(packed);
+
+  V64 idx = Iota(d64, 0);
+  const V64 vN = Set(d64, static_cast<uint64_t>(N));
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const V64 bits = ArgSortBits<Key, Order>(d64, keys + i);
+      Store(Or(ShiftLeft<kIndexBits>(bits), idx), d64, packed.get() + i);
+      idx = Add(idx, vN);
+    }
+  }
+  for (; i < num; ++i) {
+    const Vec<decltype(d1)> bits = ArgSortBits<Key, Order>(d1, keys + i);
+    packed[i] = (GetLane(bits) << kIndexBits) | i;
+  }
+
+  VQSortStatic(packed.get(), num, SortAscending());
+
+  const V64 index_mask = Set(d64, (uint64_t{1} << kIndexBits) - 1);
+  i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const V64 v = And(Load(d64, packed.get() + i), index_mask);
+      ArgSortStoreIndices(d64, v, indices + i);
+    }
+  }
+  for (; i < num; ++i) {
+    indices[i] = static_cast<Index>(packed[i] & GetLane(index_mask));
+  }
+}
+
+// Sorts in ascending order of `hi`, then `lo`.
+HWY_INLINE void SortPacked128(uint128_t* HWY_RESTRICT packed, size_t num) {
+#if HWY_TARGET != HWY_SCALAR
+  VQSortStatic(packed, num, SortAscending());
+#else
+  // 128-bit keys require 128-bit SIMD.
+  std::sort(packed, packed + num, [](const uint128_t& a, const uint128_t& b) {
+    return a.hi != b.hi ? a.hi < b.hi : a.lo < b.lo;
+  });
+#endif
+}
+
+// Each 128-bit key holds the key bits in its upper half and the index in its
+// lower half. For 64-bit keys, or too many keys for ArgSortPacked64.
+template <typename Key, class Order, typename Index>
+void ArgSortPacked128(const Key* HWY_RESTRICT keys, const size_t num,
+                      Index* HWY_RESTRICT indices) {
+  const ScalableTag<uint64_t> d64;
+  const CappedTag<uint64_t, 1> d1;
+  using V64 = Vec<decltype(d64)>;
+  const size_t N = Lanes(d64);
+
+  auto packed = hwy::AllocateAligned<uint64_t>(2 * num);
+  HWY_ASSERT(packed);
+
+  V64 idx = Iota(d64, 0);
+  const V64 vN = Set(d64, static_cast<uint64_t>(N));
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const V64 bits = ArgSortBits<Key, Order>(d64, keys + i);
+      StoreInterleaved2(idx, bits, d64, packed.get() + 2 * i);
+      idx = Add(idx, vN);
+    }
+  }
+  for (; i < num; ++i) {
+    packed[2 * i + 0] = i;
+    packed[2 * i + 1] = GetLane(ArgSortBits<Key, Order>(d1, keys + i));
+  }
+
+  SortPacked128(reinterpret_cast<uint128_t*>(packed.get()), num);
+
+  i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      V64 lo, hi;
+      LoadInterleaved2(d64, packed.get() + 2 * i, lo, hi);
+      ArgSortStoreIndices(d64, lo, indices + i);
+    }
+  }
+  for (; i < num; ++i) {
+    indices[i] = static_cast<Index>(packed[2 * i]);
+  }
+}
+
+}  // namespace detail
+
+// Writes to `indices[0, num_keys)` a permutation of `[0, num_keys)` such that
+// `keys[indices[i]]` are sorted according to Order (SortAscending or
+// SortDescending). Does not modify `keys`. Unlike VQSort, this is stable:
+// equivalent keys remain in their original order. NaN are sorted to the back,
+// and -0 is ordered before +0 (after, if descending).
+// Key may be any 16-64 bit unsigned/signed/floating-point type; Index is
+// uint32_t or uint64_t and must be able to represent `num_keys - 1`. Allocates
+// 8 or 16 bytes per key for temporary storage, i.e. no less than K32V32 or
+// K64V64 for 32/64-bit keys.
+template <typename Key, typename Index, class Order>
+void VQArgSortStatic(const Key* HWY_RESTRICT keys, const size_t num_keys,
+                     Index* HWY_RESTRICT indices, Order) {
+  static_assert(IsSame<Index, uint32_t>() || IsSame<Index, uint64_t>(),
+                "Index must be uint32_t or uint64_t");
+  static_assert(sizeof(Key) >= 2 && sizeof(Key) <= 8, "Unsupported key type");
+  if (num_keys == 0) return;
+  HWY_ASSERT(static_cast<uint64_t>(num_keys - 1) <= LimitsMax<Index>());
+
+  // Use a single u64 per key if the index fits into the bits not required by
+  // the key, otherwise pairs of u64.
+  constexpr size_t kIndexBits = 64 - sizeof(Key) * 8;
+  if (sizeof(Key) <= 4 &&
+      (static_cast<uint64_t>(num_keys - 1) >> HWY_MIN(kIndexBits, 63)) == 0) {
+    detail::ArgSortPacked64<Key, Order>(keys, num_keys, indices);
+  } else {
+    detail::ArgSortPacked128<Key, Order>(keys, num_keys, indices);
+  }
+}
+
+namespace detail {
+
+// Stable sorting of key-value pairs also packs the (sortable) key and index
+// into a u128 and sorts these with VQSort. Inverting the key bits for
+// descending order ensures ties are still broken by ascending index.
+
+// For up to 2^32 K32V32, the upper half holds the key and index and the lower
+// half the value, hence the pairs are restored without a gather.
+template <class Order>
+void StableSortPacked32(K32V32* HWY_RESTRICT pairs, const size_t num) {
+  const ScalableTag<uint64_t> d64;
+  using V64 = Vec<decltype(d64)>;
+  const size_t N = Lanes(d64);
+  uint64_t* HWY_RESTRICT lanes = reinterpret_cast<uint64_t*>(pairs);
+
+  auto packed = hwy::AllocateAligned<uint64_t>(2 * num);
+  HWY_ASSERT(packed);
+
+  const uint64_t kLower = 0xFFFFFFFFu;
+  // Ascending: identity, descending: Not of the key bits.
+  const uint64_t kFlip = Order::IsAscending() ? 0 : ~kLower;
+  const V64 lower = Set(d64, kLower);
+  const V64 flip = Set(d64, kFlip);
+  V64 idx = Iota(d64, 0);
+  const V64 vN = Set(d64, static_cast<uint64_t>(N));
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const V64 v = LoadU(d64, lanes + i);
+      const V64 hi = Or(Xor(AndNot(lower, v), flip), idx);
+      StoreInterleaved2(And(v, lower), hi, d64, packed.get() + 2 * i);
+      idx = Add(idx, vN);
+    }
+  }
+  for (; i < num; ++i) {
+    packed[2 * i + 0] = lanes[i] & kLower;
+    packed[2 * i + 1] = ((lanes[i] & ~kLower) ^ kFlip) | i;
+  }
+
+  SortPacked128(reinterpret_cast<uint128_t*>(packed.get()), num);
+
+  i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      V64 lo, hi;
+      LoadInterleaved2(d64, packed.get() + 2 * i, lo, hi);
+      StoreU(Or(Xor(AndNot(lower, hi), flip), lo), d64, lanes + i);
+    }
+  }
+  for (; i < num; ++i) {
+    lanes[i] = ((packed[2 * i + 1] & ~kLower) ^ kFlip) | packed[2 * i];
+  }
+}
+
+// Otherwise, the upper half holds the key and the lower half the index, which
+// is used to gather the pairs from a copy.
+template <class Order, class KV>
+void StableSortGather(KV* HWY_RESTRICT pairs, const size_t num) {
+  auto packed = hwy::AllocateAligned<uint128_t>(num);
+  auto copy = hwy::AllocateAligned<KV>(num);
+  HWY_ASSERT(packed && copy);
+  CopyBytes(pairs, copy.get(), num * sizeof(KV));
+
+  const uint64_t flip = Order::IsAscending() ? 0 : ~uint64_t{0};
+  for (size_t i = 0; i < num; ++i) {
+    packed[i].lo = i;
+    packed[i].hi = static_cast<uint64_t>(pairs[i].key) ^ flip;
+  }
+  SortPacked128(packed.get(), num);
+  for (size_t i = 0; i < num; ++i) {
+    pairs[i] = copy[static_cast<size_t>(packed[i].lo)];
+  }
+}
+
+}  // namespace detail
+
+// Same as VQSortStatic for K32V32 or K64V64, but stable: pairs with equal
+// keys remain in their original order. Allocates 16 bytes per pair for K32V32,
+// otherwise 32.
+template <class Order>
+void VQStableSortStatic(K32V32* HWY_RESTRICT pairs, const size_t num, Order) {
+  if (num <= 1) return;
+  if (static_cast<uint64_t>(num - 1) <= 0xFFFFFFFFu) {
+    detail::StableSortPacked32<Order>(pairs, num);
+  } else {
+    detail::StableSortGather<Order>(pairs, num);
+  }
+}
+
+template <class Order>
+void VQStableSortStatic(K64V64* HWY_RESTRICT pairs, const size_t num, Order) {
+  if (num <= 1) return;
+  detail::StableSortGather<Order>(pairs, num);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
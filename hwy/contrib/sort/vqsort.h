@@ -222,6 +222,171 @@ HWY_CONTRIB_DLLEXPORT void VQSelect(K64V64* HWY_RESTRICT keys, size_t n,
 HWY_CONTRIB_DLLEXPORT void VQSelect(K64V64* HWY_RESTRICT keys, size_t n,
                                     size_t k, SortDescending);
 
+// Vectorized argsort: writes to `indices[0, n)` a permutation of [0, n) such
+// that `keys[indices[i]]` are sorted. Unlike VQSort, this is stable, i.e.
+// preserves the order of equivalent keys, and does not modify `keys`. NaN are
+// sorted to the back. `indices` must be able to represent `n - 1`. Allocates
+// 8 bytes per key if the key and index fit into 64 bits, otherwise 16 bytes.
+// Note that a 32-bit key plus 32-bit index thus moves as many bytes during the
+// sort as K32V32; the savings are the passes for packing and unpacking pairs.
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int16_t* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int16_t* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int16_t* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int16_t* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int32_t* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int32_t* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int32_t* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int32_t* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int64_t* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int64_t* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int64_t* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const int64_t* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float16_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float16_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const float* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const double* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const double* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const double* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgSort(const double* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+
+// Same as VQSort, but stable: pairs with equal keys remain in their original
+// order, e.g. events with the same timestamp. Allocates 16 bytes per pair for
+// K32V32, otherwise 32.
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+
+// Key types for VQSortRecords.
+enum class RecordKey { kU32, kI32, kF32, kU64, kI64, kF64 };
+
+// Sorts `n` records of `record_bytes` each, e.g. structs, by the key of the
+// given type at byte offset `key_offset` within each record. Unlike VQSort on
+// key-value pairs, this does not require the caller to extract keys and
+// indices and gather the records. The keys are argsorted with VQArgSort, hence
+// this is stable. Records are then permuted in blocks, with the sources of the
+// next block prefetched. Allocates `record_bytes` plus at most 32 bytes per
+// record. Any `record_bytes` is allowed, but 16, 24, 32 and 48 are fastest.
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes,
+                                         size_t key_offset, RecordKey key,
+                                         SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes,
+                                         size_t key_offset, RecordKey key,
+                                         SortDescending);
+
+// Reference to a byte string for VQSortStrings, e.g. from std::string_view.
+// Need not be null-terminated.
+struct StringKey {
+  const char* data;
+  size_t size;
+};
+
+// Sorts `n` strings in lexicographic order of their unsigned bytes, which
+// matches std::string comparison and memcmp. Only the references are moved.
+// This is a most-significant-digit radix sort: each pass sorts 8-byte prefixes
+// via VQSort of 128-bit keys, and groups of strings with a common prefix are
+// either sorted in a further pass or, if small, by vectorized comparison of
+// the remaining bytes. Not stable. Allocates 32 bytes per string.
+HWY_CONTRIB_DLLEXPORT void VQSortStrings(StringKey* HWY_RESTRICT strings,
+                                         size_t n, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortStrings(StringKey* HWY_RESTRICT strings,
+                                         size_t n, SortDescending);
+
 // User-level caching is no longer required, so this class is no longer
 // beneficial. We recommend using the simpler VQSort() interface instead, and
 // retain this class only for compatibility. It now just calls VQSort.
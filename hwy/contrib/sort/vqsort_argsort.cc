@@ -0,0 +1,446 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include "hwy/contrib/sort/vqsort.h"  // VQArgSort
+
+#undef HWY_TARGET_INCLUDE
+// clang-format off
+// (avoid line break, which would prevent Copybara rules from matching)
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_argsort.cc"  //NOLINT
+// clang-format on
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqsort-inl.h"
+
+// All key types are in a single file because they share the two
+// instantiations of VQSort (u64 and u128) used for the packed keys.
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+void ArgSortU16Idx32Asc(const uint16_t* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortU16Idx32Desc(const uint16_t* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortU16Idx64Asc(const uint16_t* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortU16Idx64Desc(const uint16_t* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortU32Idx32Asc(const uint32_t* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortU32Idx32Desc(const uint32_t* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortU32Idx64Asc(const uint32_t* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortU32Idx64Desc(const uint32_t* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortU64Idx32Asc(const uint64_t* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortU64Idx32Desc(const uint64_t* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortU64Idx64Asc(const uint64_t* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortU64Idx64Desc(const uint64_t* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortI16Idx32Asc(const int16_t* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortI16Idx32Desc(const int16_t* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortI16Idx64Asc(const int16_t* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortI16Idx64Desc(const int16_t* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortI32Idx32Asc(const int32_t* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortI32Idx32Desc(const int32_t* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortI32Idx64Asc(const int32_t* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortI32Idx64Desc(const int32_t* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortI64Idx32Asc(const int64_t* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortI64Idx32Desc(const int64_t* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortI64Idx64Asc(const int64_t* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortI64Idx64Desc(const int64_t* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortF16Idx32Asc(const float16_t* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortF16Idx32Desc(const float16_t* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortF16Idx64Asc(const float16_t* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortF16Idx64Desc(const float16_t* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortF32Idx32Asc(const float* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortF32Idx32Desc(const float* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortF32Idx64Asc(const float* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortF32Idx64Desc(const float* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortF64Idx32Asc(const double* HWY_RESTRICT keys, const size_t num,
+                        uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortF64Idx32Desc(const double* HWY_RESTRICT keys, const size_t num,
+                         uint32_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+void ArgSortF64Idx64Asc(const double* HWY_RESTRICT keys, const size_t num,
+                        uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortAscending());
+}
+
+void ArgSortF64Idx64Desc(const double* HWY_RESTRICT keys, const size_t num,
+                         uint64_t* HWY_RESTRICT indices) {
+  VQArgSortStatic(keys, num, indices, SortDescending());
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(ArgSortU16Idx32Asc);
+HWY_EXPORT(ArgSortU16Idx32Desc);
+HWY_EXPORT(ArgSortU16Idx64Asc);
+HWY_EXPORT(ArgSortU16Idx64Desc);
+HWY_EXPORT(ArgSortU32Idx32Asc);
+HWY_EXPORT(ArgSortU32Idx32Desc);
+HWY_EXPORT(ArgSortU32Idx64Asc);
+HWY_EXPORT(ArgSortU32Idx64Desc);
+HWY_EXPORT(ArgSortU64Idx32Asc);
+HWY_EXPORT(ArgSortU64Idx32Desc);
+HWY_EXPORT(ArgSortU64Idx64Asc);
+HWY_EXPORT(ArgSortU64Idx64Desc);
+HWY_EXPORT(ArgSortI16Idx32Asc);
+HWY_EXPORT(ArgSortI16Idx32Desc);
+HWY_EXPORT(ArgSortI16Idx64Asc);
+HWY_EXPORT(ArgSortI16Idx64Desc);
+HWY_EXPORT(ArgSortI32Idx32Asc);
+HWY_EXPORT(ArgSortI32Idx32Desc);
+HWY_EXPORT(ArgSortI32Idx64Asc);
+HWY_EXPORT(ArgSortI32Idx64Desc);
+HWY_EXPORT(ArgSortI64Idx32Asc);
+HWY_EXPORT(ArgSortI64Idx32Desc);
+HWY_EXPORT(ArgSortI64Idx64Asc);
+HWY_EXPORT(ArgSortI64Idx64Desc);
+HWY_EXPORT(ArgSortF16Idx32Asc);
+HWY_EXPORT(ArgSortF16Idx32Desc);
+HWY_EXPORT(ArgSortF16Idx64Asc);
+HWY_EXPORT(ArgSortF16Idx64Desc);
+HWY_EXPORT(ArgSortF32Idx32Asc);
+HWY_EXPORT(ArgSortF32Idx32Desc);
+HWY_EXPORT(ArgSortF32Idx64Asc);
+HWY_EXPORT(ArgSortF32Idx64Desc);
+HWY_EXPORT(ArgSortF64Idx32Asc);
+HWY_EXPORT(ArgSortF64Idx32Desc);
+HWY_EXPORT(ArgSortF64Idx64Asc);
+HWY_EXPORT(ArgSortF64Idx64Desc);
+}  // namespace
+
+void VQArgSort(const uint16_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU16Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const uint16_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU16Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const uint16_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU16Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const uint16_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU16Idx64Desc)(keys, n, indices);
+}
+
+void VQArgSort(const uint32_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU32Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const uint32_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU32Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const uint32_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU32Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const uint32_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU32Idx64Desc)(keys, n, indices);
+}
+
+void VQArgSort(const uint64_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU64Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const uint64_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU64Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const uint64_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU64Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const uint64_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortU64Idx64Desc)(keys, n, indices);
+}
+
+void VQArgSort(const int16_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI16Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const int16_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI16Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const int16_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI16Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const int16_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI16Idx64Desc)(keys, n, indices);
+}
+
+void VQArgSort(const int32_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI32Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const int32_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI32Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const int32_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI32Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const int32_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI32Idx64Desc)(keys, n, indices);
+}
+
+void VQArgSort(const int64_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI64Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const int64_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI64Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const int64_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI64Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const int64_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortI64Idx64Desc)(keys, n, indices);
+}
+
+void VQArgSort(const float16_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF16Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const float16_t* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF16Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const float16_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF16Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const float16_t* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF16Idx64Desc)(keys, n, indices);
+}
+
+void VQArgSort(const float* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF32Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const float* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF32Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const float* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF32Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const float* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF32Idx64Desc)(keys, n, indices);
+}
+
+void VQArgSort(const double* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF64Idx32Asc)(keys, n, indices);
+}
+
+void VQArgSort(const double* HWY_RESTRICT keys, const size_t n,
+               uint32_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF64Idx32Desc)(keys, n, indices);
+}
+
+void VQArgSort(const double* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF64Idx64Asc)(keys, n, indices);
+}
+
+void VQArgSort(const double* HWY_RESTRICT keys, const size_t n,
+               uint64_t* HWY_RESTRICT indices, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(ArgSortF64Idx64Desc)(keys, n, indices);
+}
+
+}  // namespace hwy
+#endif  // HWY_ONCE
@@ -0,0 +1,369 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/sort/vqsort_parallel.h"  // VQSortParallel
+
+#undef HWY_TARGET_INCLUDE
+// clang-format off
+// (avoid line break, which would prevent Copybara rules from matching)
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_parallel.cc"  //NOLINT
+// clang-format on
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqsort-inl.h"
+
+// All key types are in a single file because the parallel driver is small
+// compared to the sorting itself, which is mostly shared with the single-thread
+// VQSort in the same binary.
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+void SortParallelU16Asc(uint16_t* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+}
+
+void SortParallelU16Desc(uint16_t* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+}
+
+void SortParallelU32Asc(uint32_t* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+}
+
+void SortParallelU32Desc(uint32_t* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+}
+
+void SortParallelU64Asc(uint64_t* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+}
+
+void SortParallelU64Desc(uint64_t* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+}
+
+void SortParallelI16Asc(int16_t* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+}
+
+void SortParallelI16Desc(int16_t* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+}
+
+void SortParallelI32Asc(int32_t* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+}
+
+void SortParallelI32Desc(int32_t* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+}
+
+void SortParallelI64Asc(int64_t* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+}
+
+void SortParallelI64Desc(int64_t* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+}
+
+void SortParallelF16Asc(float16_t* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+#if HWY_HAVE_FLOAT16
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortParallelF16Desc(float16_t* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+#if HWY_HAVE_FLOAT16
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortParallelF32Asc(float* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+}
+
+void SortParallelF32Desc(float* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+}
+
+void SortParallelF64Asc(double* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+#if HWY_HAVE_FLOAT64
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortParallelF64Desc(double* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+#if HWY_HAVE_FLOAT64
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortParallelKV64Asc(K32V32* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+}
+
+void SortParallelKV64Desc(K32V32* HWY_RESTRICT keys, const size_t num,
+                          ThreadPool& pool) {
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+}
+
+void SortParallel128Asc(uint128_t* HWY_RESTRICT keys, const size_t num,
+                        ThreadPool& pool) {
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+#endif
+}
+
+void SortParallel128Desc(uint128_t* HWY_RESTRICT keys, const size_t num,
+                         ThreadPool& pool) {
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+#endif
+}
+
+void SortParallelKV128Asc(K64V64* HWY_RESTRICT keys, const size_t num,
+                          ThreadPool& pool) {
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQSortParallelStatic(keys, num, SortAscending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+#endif
+}
+
+void SortParallelKV128Desc(K64V64* HWY_RESTRICT keys, const size_t num,
+                           ThreadPool& pool) {
+// 128-bit keys require 128-bit SIMD.
+#if HWY_TARGET != HWY_SCALAR
+  return VQSortParallelStatic(keys, num, SortDescending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+#endif
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(SortParallelU16Asc);
+HWY_EXPORT(SortParallelU16Desc);
+HWY_EXPORT(SortParallelU32Asc);
+HWY_EXPORT(SortParallelU32Desc);
+HWY_EXPORT(SortParallelU64Asc);
+HWY_EXPORT(SortParallelU64Desc);
+HWY_EXPORT(SortParallelI16Asc);
+HWY_EXPORT(SortParallelI16Desc);
+HWY_EXPORT(SortParallelI32Asc);
+HWY_EXPORT(SortParallelI32Desc);
+HWY_EXPORT(SortParallelI64Asc);
+HWY_EXPORT(SortParallelI64Desc);
+HWY_EXPORT(SortParallelF16Asc);
+HWY_EXPORT(SortParallelF16Desc);
+HWY_EXPORT(SortParallelF32Asc);
+HWY_EXPORT(SortParallelF32Desc);
+HWY_EXPORT(SortParallelF64Asc);
+HWY_EXPORT(SortParallelF64Desc);
+HWY_EXPORT(SortParallelKV64Asc);
+HWY_EXPORT(SortParallelKV64Desc);
+HWY_EXPORT(SortParallel128Asc);
+HWY_EXPORT(SortParallel128Desc);
+HWY_EXPORT(SortParallelKV128Asc);
+HWY_EXPORT(SortParallelKV128Desc);
+}  // namespace
+
+void VQSortParallel(uint16_t* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelU16Asc)(keys, n, pool);
+}
+
+void VQSortParallel(uint16_t* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelU16Desc)(keys, n, pool);
+}
+
+void VQSortParallel(uint32_t* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelU32Asc)(keys, n, pool);
+}
+
+void VQSortParallel(uint32_t* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelU32Desc)(keys, n, pool);
+}
+
+void VQSortParallel(uint64_t* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelU64Asc)(keys, n, pool);
+}
+
+void VQSortParallel(uint64_t* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelU64Desc)(keys, n, pool);
+}
+
+void VQSortParallel(int16_t* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelI16Asc)(keys, n, pool);
+}
+
+void VQSortParallel(int16_t* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelI16Desc)(keys, n, pool);
+}
+
+void VQSortParallel(int32_t* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelI32Asc)(keys, n, pool);
+}
+
+void VQSortParallel(int32_t* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelI32Desc)(keys, n, pool);
+}
+
+void VQSortParallel(int64_t* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelI64Asc)(keys, n, pool);
+}
+
+void VQSortParallel(int64_t* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelI64Desc)(keys, n, pool);
+}
+
+void VQSortParallel(float16_t* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelF16Asc)(keys, n, pool);
+}
+
+void VQSortParallel(float16_t* HWY_RESTRICT keys, const size_t n,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelF16Desc)(keys, n, pool);
+}
+
+void VQSortParallel(float* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelF32Asc)(keys, n, pool);
+}
+
+void VQSortParallel(float* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelF32Desc)(keys, n, pool);
+}
+
+void VQSortParallel(double* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelF64Asc)(keys, n, pool);
+}
+
+void VQSortParallel(double* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelF64Desc)(keys, n, pool);
+}
+
+void VQSortParallel(K32V32* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelKV64Asc)(keys, n, pool);
+}
+
+void VQSortParallel(K32V32* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelKV64Desc)(keys, n, pool);
+}
+
+void VQSortParallel(uint128_t* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallel128Asc)(keys, n, pool);
+}
+
+void VQSortParallel(uint128_t* HWY_RESTRICT keys, const size_t n,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallel128Desc)(keys, n, pool);
+}
+
+void VQSortParallel(K64V64* HWY_RESTRICT keys, const size_t n, SortAscending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelKV128Asc)(keys, n, pool);
+}
+
+void VQSortParallel(K64V64* HWY_RESTRICT keys, const size_t n, SortDescending,
+                    ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(SortParallelKV128Desc)(keys, n, pool);
+}
+
+}  // namespace hwy
+#endif  // HWY_ONCE
@@ -0,0 +1,105 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Interface to multi-threaded vectorized quicksort with dynamic dispatch. This
+// is a separate header and library from vqsort.h because ThreadPool depends on
+// vqsort (via auto_tune.h). For static dispatch, call VQSortParallelStatic in
+// vqsort-inl.h.
+//
+// Parallelization is only worthwhile for large arrays, at least several MiB;
+// smaller inputs are sorted on the calling thread as if by VQSort.
+
+#ifndef HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_H_
+#define HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_H_
+
+// IWYU pragma: begin_exports
+#include <stddef.h>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"  // SortAscending
+#include "hwy/contrib/sort/vqsort.h"  // VQSort
+#include "hwy/contrib/thread_pool/thread_pool.h"
+// IWYU pragma: end_exports
+
+namespace hwy {
+
+// Same result as VQSort, but uses all workers of `pool`: partitions in parallel
+// until there are enough subarrays for each worker, which then sort them
+// independently. Must not be called concurrently with another `pool.Run`.
+// Allocates O(pool.NumWorkers()) memory. Any NaN are moved to the back.
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(uint16_t* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(uint16_t* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(uint32_t* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(uint32_t* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(uint64_t* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(uint64_t* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(int16_t* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(int16_t* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(int32_t* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(int32_t* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(int64_t* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(int64_t* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(float16_t* HWY_RESTRICT keys,
+                                          size_t n, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(float16_t* HWY_RESTRICT keys,
+                                          size_t n, SortDescending,
+                                          ThreadPool& pool);
+
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(float* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(float* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(double* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(double* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(K32V32* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(K32V32* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+
+// 128-bit types: `n` is still in units of the 128-bit keys.
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(uint128_t* HWY_RESTRICT keys,
+                                          size_t n, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(uint128_t* HWY_RESTRICT keys,
+                                          size_t n, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(K64V64* HWY_RESTRICT keys, size_t n,
+                                          SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortParallel(K64V64* HWY_RESTRICT keys, size_t n,
+                                          SortDescending, ThreadPool& pool);
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_H_
@@ -0,0 +1,156 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/cache_control.h"        // Prefetch
+#include "hwy/contrib/sort/vqsort.h"  // VQArgSort
+
+// Not per-target: the argsort is dispatched, and extracting keys and
+// permuting records are limited by memory rather than compute.
+
+namespace hwy {
+namespace {
+
+// Records are gathered in blocks of this many; the sources of the next block
+// are prefetched while copying the current one.
+constexpr size_t kRecordBlock = 16;
+
+// Copies `records[indices[i]]` to `out[i]`. kBytes is the record size if
+// known at compile time, which allows inlining the copies, otherwise 0.
+template <size_t kBytes, typename Index>
+void GatherRecords(const uint8_t* HWY_RESTRICT records, const size_t num,
+                   const size_t record_bytes,
+                   const Index* HWY_RESTRICT indices,
+                   uint8_t* HWY_RESTRICT out) {
+  const size_t bytes = kBytes == 0 ? record_bytes : kBytes;
+  for (size_t i = 0; i < HWY_MIN(num, kRecordBlock); ++i) {
+    Prefetch(records + static_cast<size_t>(indices[i]) * bytes);
+  }
+  for (size_t begin = 0; begin < num; begin += kRecordBlock) {
+    const size_t end = HWY_MIN(begin + kRecordBlock, num);
+    const size_t end_next = HWY_MIN(end + kRecordBlock, num);
+    for (size_t i = end; i < end_next; ++i) {
+      Prefetch(records + static_cast<size_t>(indices[i]) * bytes);
+    }
+    for (size_t i = begin; i < end; ++i) {
+      const uint8_t* from = records + static_cast<size_t>(indices[i]) * bytes;
+      if (kBytes == 0) {
+        CopyBytes(from, out + i * bytes, bytes);
+      } else {
+        CopyBytes<kBytes>(from, out + i * bytes);
+      }
+    }
+  }
+}
+
+template <typename Key, typename Index, class Order>
+void SortRecords(uint8_t* HWY_RESTRICT records, const size_t num,
+                 const size_t record_bytes, const size_t key_offset, Order) {
+  // Extract the keys so that the argsort can load them as vectors.
+  auto keys = hwy::AllocateAligned<Key>(num);
+  auto indices = hwy::AllocateAligned<Index>(num);
+  auto sorted = hwy::AllocateAligned<uint8_t>(num * record_bytes);
+  HWY_ASSERT(keys && indices && sorted);
+  for (size_t i = 0; i < num; ++i) {
+    CopyBytes<sizeof(Key)>(records + i * record_bytes + key_offset, &keys[i]);
+  }
+
+  VQArgSort(keys.get(), num, indices.get(), Order());
+
+  switch (record_bytes) {
+    case 16:
+      GatherRecords<16>(records, num, record_bytes, indices.get(),
+                        sorted.get());
+      break;
+    case 24:
+      GatherRecords<24>(records, num, record_bytes, indices.get(),
+                        sorted.get());
+      break;
+    case 32:
+      GatherRecords<32>(records, num, record_bytes, indices.get(),
+                        sorted.get());
+      break;
+    case 48:
+      GatherRecords<48>(records, num, record_bytes, indices.get(),
+                        sorted.get());
+      break;
+    default:
+      GatherRecords<0>(records, num, record_bytes, indices.get(),
+                       sorted.get());
+      break;
+  }
+  CopyBytes(sorted.get(), records, num * record_bytes);
+}
+
+template <typename Key, class Order>
+void SortRecordsIndex(void* HWY_RESTRICT records, const size_t num,
+                      const size_t record_bytes, const size_t key_offset,
+                      Order order) {
+  if (num <= 1) return;
+  HWY_ASSERT(key_offset + sizeof(Key) <= record_bytes);
+  uint8_t* bytes = static_cast<uint8_t*>(records);
+  if (static_cast<uint64_t>(num - 1) <= LimitsMax<uint32_t>()) {
+    SortRecords<Key, uint32_t>(bytes, num, record_bytes, key_offset, order);
+  } else {
+    SortRecords<Key, uint64_t>(bytes, num, record_bytes, key_offset, order);
+  }
+}
+
+template <class Order>
+void SortRecordsKey(void* HWY_RESTRICT records, const size_t num,
+                    const size_t record_bytes, const size_t key_offset,
+                    const RecordKey key, Order order) {
+  switch (key) {
+    case RecordKey::kU32:
+      return SortRecordsIndex<uint32_t>(records, num, record_bytes, key_offset,
+                                        order);
+    case RecordKey::kI32:
+      return SortRecordsIndex<int32_t>(records, num, record_bytes, key_offset,
+                                       order);
+    case RecordKey::kF32:
+      return SortRecordsIndex<float>(records, num, record_bytes, key_offset,
+                                     order);
+    case RecordKey::kU64:
+      return SortRecordsIndex<uint64_t>(records, num, record_bytes, key_offset,
+                                        order);
+    case RecordKey::kI64:
+      return SortRecordsIndex<int64_t>(records, num, record_bytes, key_offset,
+                                       order);
+    case RecordKey::kF64:
+      return SortRecordsIndex<double>(records, num, record_bytes, key_offset,
+                                      order);
+  }
+  HWY_ABORT("Invalid RecordKey %d\n", static_cast<int>(key));
+}
+
+}  // namespace
+
+void VQSortRecords(void* HWY_RESTRICT records, const size_t n,
+                   const size_t record_bytes, const size_t key_offset,
+                   const RecordKey key, SortAscending) {
+  SortRecordsKey(records, n, record_bytes, key_offset, key, SortAscending());
+}
+
+void VQSortRecords(void* HWY_RESTRICT records, const size_t n,
+                   const size_t record_bytes, const size_t key_offset,
+                   const RecordKey key, SortDescending) {
+  SortRecordsKey(records, n, record_bytes, key_offset, key, SortDescending());
+}
+
+}  // namespace hwy
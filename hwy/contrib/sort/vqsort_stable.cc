@@ -0,0 +1,86 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include "hwy/contrib/sort/vqsort.h"  // VQStableSort
+
+#undef HWY_TARGET_INCLUDE
+// clang-format off
+// (avoid line break, which would prevent Copybara rules from matching)
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_stable.cc"  //NOLINT
+// clang-format on
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqsort-inl.h"
+
+// Both key-value types are in a single file because they share the only
+// instantiation of VQSort (u128 ascending) used for the packed keys.
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+void StableSortKV64Asc(K32V32* HWY_RESTRICT keys, const size_t num) {
+  VQStableSortStatic(keys, num, SortAscending());
+}
+
+void StableSortKV64Desc(K32V32* HWY_RESTRICT keys, const size_t num) {
+  VQStableSortStatic(keys, num, SortDescending());
+}
+
+void StableSortKV128Asc(K64V64* HWY_RESTRICT keys, const size_t num) {
+  VQStableSortStatic(keys, num, SortAscending());
+}
+
+void StableSortKV128Desc(K64V64* HWY_RESTRICT keys, const size_t num) {
+  VQStableSortStatic(keys, num, SortDescending());
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(StableSortKV64Asc);
+HWY_EXPORT(StableSortKV64Desc);
+HWY_EXPORT(StableSortKV128Asc);
+HWY_EXPORT(StableSortKV128Desc);
+}  // namespace
+
+void VQStableSort(K32V32* HWY_RESTRICT keys, const size_t n, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(StableSortKV64Asc)(keys, n);
+}
+
+void VQStableSort(K32V32* HWY_RESTRICT keys, const size_t n, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(StableSortKV64Desc)(keys, n);
+}
+
+void VQStableSort(K64V64* HWY_RESTRICT keys, const size_t n, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(StableSortKV128Asc)(keys, n);
+}
+
+void VQStableSort(K64V64* HWY_RESTRICT keys, const size_t n, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(StableSortKV128Desc)(keys, n);
+}
+
+}  // namespace hwy
+#endif  // HWY_ONCE
@@ -0,0 +1,223 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>  // std::sort
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort.h"  // VQSortStrings
+
+#undef HWY_TARGET_INCLUDE
+// clang-format off
+// (avoid line break, which would prevent Copybara rules from matching)
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_strings.cc"  //NOLINT
+// clang-format on
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/sort/vqsort-inl.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+// Groups of at most this many strings with a common prefix are sorted by
+// comparing their remaining bytes, rather than another radix pass.
+constexpr size_t kSmallStrings = 32;
+
+// Bits [56, 64) of the lower half of a packed key hold the number of bytes
+// remaining in the current digit, or kContinues if there are more than 8.
+// The lower bits are the index of the string within its group.
+constexpr uint64_t kContinues = 9;
+constexpr int kLengthShift = 56;
+
+// Returns negative, zero or positive if `a` is less than, equal to or greater
+// than `b`, comparing unsigned bytes starting at `from`, which must not exceed
+// the size of either. Same as memcmp for equal sizes, but vectorized.
+int CompareSuffix(const StringKey& a, const StringKey& b, const size_t from) {
+  const ScalableTag<uint8_t> d;
+  const size_t N = Lanes(d);
+  const uint8_t* HWY_RESTRICT pa =
+      reinterpret_cast<const uint8_t*>(a.data) + from;
+  const uint8_t* HWY_RESTRICT pb =
+      reinterpret_cast<const uint8_t*>(b.data) + from;
+  const size_t num = HWY_MIN(a.size, b.size) - from;
+
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const auto ne = Ne(LoadU(d, pa + i), LoadU(d, pb + i));
+      if (HWY_UNLIKELY(!AllFalse(d, ne))) {
+        const size_t pos = i + FindKnownFirstTrue(d, ne);
+        return pa[pos] < pb[pos] ? -1 : 1;
+      }
+    }
+  }
+  const size_t remaining = num - i;
+  if (remaining != 0) {
+    // Both are zero-padded, hence only valid bytes can differ.
+    const auto ne =
+        Ne(LoadN(d, pa + i, remaining), LoadN(d, pb + i, remaining));
+    const intptr_t pos = FindFirstTrue(d, ne);
+    if (pos >= 0) {
+      const size_t upos = i + static_cast<size_t>(pos);
+      return pa[upos] < pb[upos] ? -1 : 1;
+    }
+  }
+  // One is a prefix of the other: the shorter is first.
+  if (a.size == b.size) return 0;
+  return a.size < b.size ? -1 : 1;
+}
+
+// Writes packed keys for `strings`: `hi` is the big-endian digit, i.e. the
+// 8 bytes starting at `depth`, zero-padded. Strings that end within the digit
+// are before longer strings with the same digit, because the digit of the
+// latter includes the zero bytes that we padded. The length in `lo` orders
+// them, and also indicates whether they continue after the digit.
+void PackStrings(const StringKey* HWY_RESTRICT strings, const size_t num,
+                 const size_t depth, uint64_t* HWY_RESTRICT packed) {
+  for (size_t i = 0; i < num; ++i) {
+    const size_t remaining = strings[i].size - depth;
+    const size_t bytes = HWY_MIN(remaining, size_t{8});
+    uint64_t digit = 0;
+    CopyBytes(strings[i].data + depth, &digit, bytes);
+    const uint64_t length = remaining > 8 ? kContinues : remaining;
+    packed[2 * i + 0] = (length << kLengthShift) | i;
+    packed[2 * i + 1] = digit;
+  }
+
+#if HWY_IS_LITTLE_ENDIAN
+  // Byte-swap the digits so that they compare like the bytes.
+  const ScalableTag<uint64_t> d64;
+  const CappedTag<uint64_t, 1> d1;
+  const size_t N = Lanes(d64);
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      Vec<decltype(d64)> lo, hi;
+      LoadInterleaved2(d64, packed + 2 * i, lo, hi);
+      StoreInterleaved2(lo, ReverseLaneBytes(hi), d64, packed + 2 * i);
+    }
+  }
+  for (; i < num; ++i) {
+    StoreU(ReverseLaneBytes(LoadU(d1, packed + 2 * i + 1)), d1,
+           packed + 2 * i + 1);
+  }
+#endif
+}
+
+// Sorts the group of `num` strings whose first `depth` bytes are equal.
+void SortSmall(StringKey* HWY_RESTRICT strings, const size_t num,
+               const size_t depth) {
+  std::sort(strings, strings + num,
+            [depth](const StringKey& a, const StringKey& b) {
+              return CompareSuffix(a, b, depth) < 0;
+            });
+}
+
+// Most-significant-digit radix sort with 8-byte digits, each pass of which is
+// a VQSort of 128-bit keys. Uses an explicit stack because long common
+// prefixes would otherwise cause deep recursion.
+void SortStrings(StringKey* HWY_RESTRICT strings, const size_t num) {
+  if (num <= kSmallStrings) return SortSmall(strings, num, 0);
+
+  auto packed = hwy::AllocateAligned<uint64_t>(2 * num);
+  auto copy = hwy::AllocateAligned<StringKey>(num);
+  HWY_ASSERT(packed && copy);
+
+  struct Group {
+    size_t begin;
+    size_t num;
+    size_t depth;
+  };
+  std::vector<Group> groups = {Group{0, num, 0}};
+  while (!groups.empty()) {
+    const Group group = groups.back();
+    groups.pop_back();
+    StringKey* HWY_RESTRICT keys = strings + group.begin;
+    if (group.num <= kSmallStrings) {
+      SortSmall(keys, group.num, group.depth);
+      continue;
+    }
+
+    // Sections of the scratch buffers are only used by this group.
+    uint64_t* HWY_RESTRICT lanes = packed.get() + 2 * group.begin;
+    StringKey* HWY_RESTRICT tmp = copy.get() + group.begin;
+    PackStrings(keys, group.num, group.depth, lanes);
+    detail::SortPacked128(reinterpret_cast<uint128_t*>(lanes), group.num);
+
+    constexpr uint64_t kIndexMask = (uint64_t{1} << kLengthShift) - 1;
+    for (size_t i = 0; i < group.num; ++i) {
+      tmp[i] = keys[lanes[2 * i] & kIndexMask];
+    }
+    CopyBytes(tmp, keys, group.num * sizeof(StringKey));
+
+    // Strings with equal digits that continue require another pass.
+    const size_t depth = group.depth + 8;
+    for (size_t i = 0; i < group.num;) {
+      size_t end = i + 1;
+      if ((lanes[2 * i] >> kLengthShift) == kContinues) {
+        while (end < group.num && lanes[2 * end + 1] == lanes[2 * i + 1] &&
+               (lanes[2 * end] >> kLengthShift) == kContinues) {
+          ++end;
+        }
+        if (end - i > 1) {
+          groups.push_back(Group{group.begin + i, end - i, depth});
+        }
+      }
+      i = end;
+    }
+  }
+}
+
+void SortStringsAsc(StringKey* HWY_RESTRICT strings, const size_t num) {
+  SortStrings(strings, num);
+}
+
+void SortStringsDesc(StringKey* HWY_RESTRICT strings, const size_t num) {
+  SortStrings(strings, num);
+  std::reverse(strings, strings + num);
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(SortStringsAsc);
+HWY_EXPORT(SortStringsDesc);
+}  // namespace
+
+void VQSortStrings(StringKey* HWY_RESTRICT strings, const size_t n,
+                   SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SortStringsAsc)(strings, n);
+}
+
+void VQSortStrings(StringKey* HWY_RESTRICT strings, const size_t n,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortStringsDesc)(strings, n);
+}
+
+}  // namespace hwy
+#endif  // HWY_ONCE
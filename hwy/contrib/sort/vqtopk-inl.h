@@ -0,0 +1,159 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_VQTOPK_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_VQTOPK_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_VQTOPK_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_VQTOPK_TOGGLE
+#endif
+
+#include <stddef.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"       // SortDescending
+#include "hwy/contrib/sort/vqsort-inl.h"  // VQSelectStatic
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Maintains the first `k` keys according to Order (by default, the k largest)
+// of a stream of keys that arrive in chunks, using O(k) memory. Once `k` keys
+// have been seen, only keys before the current k-th key are appended to a
+// buffer, which is a vectorized filter via Compress. When the buffer is full,
+// VQSelect moves the first k keys to its front and updates the threshold.
+// Hence the cost is O(n) for n keys, and typically far less than sorting.
+//
+// Key may be any 16-64 bit unsigned/signed/floating-point type (but float16/64
+// only #if HWY_HAVE_FLOAT16/64), or K32V32. Keys must not be NaN. As with
+// VQSelect, which of several equal keys are retained is unspecified.
+template <typename Key, class Order = SortDescending>
+class StreamingTopK {
+  using Traits = detail::MakeTraits<Key, Order>;
+  using T = typename Traits::LaneType;
+  using D = SortTag<T>;
+  static_assert(sizeof(Key) == sizeof(T), "128-bit keys are not supported");
+
+  // Minimum number of keys appended between VQSelect calls, which amortizes
+  // their cost for small `k`.
+  static constexpr size_t kMinBatch = 256;
+
+ public:
+  explicit StreamingTopK(size_t k)
+      : k_(k),
+        // After Reduce, there must be space for at least one vector.
+        capacity_(k + HWY_MAX(HWY_MAX(k, kMinBatch), Lanes(D()))),
+        buf_(hwy::AllocateAligned<T>(capacity_)) {
+    HWY_ASSERT(buf_);
+  }
+
+  // Discards all keys seen so far.
+  void Reset() {
+    num_ = 0;
+    have_threshold_ = false;
+  }
+
+  size_t K() const { return k_; }
+
+  // Considers `num` keys, which need not be sorted.
+  void Add(const Key* HWY_RESTRICT keys, size_t num) {
+    if (k_ == 0) return;
+    const T* HWY_RESTRICT lanes = reinterpret_cast<const T*>(keys);
+    const D d;
+    const size_t N = Lanes(d);
+
+    // Until the first Reduce, there is no threshold: append all keys.
+    while (!have_threshold_ && num != 0) {
+      const size_t copy = HWY_MIN(num, capacity_ - num_);
+      CopyBytes(lanes, buf_.get() + num_, copy * sizeof(T));
+      num_ += copy;
+      lanes += copy;
+      num -= copy;
+      if (num_ == capacity_) Reduce();
+    }
+    if (num == 0) return;
+
+    // CompressStore may write a whole vector, hence we maintain the invariant
+    // that there is space for one.
+    const Traits st;
+    Vec<D> threshold = Set(d, buf_[k_ - 1]);
+    size_t i = 0;
+    if (num >= N) {
+      for (; i <= num - N; i += N) {
+        const Vec<D> v = LoadU(d, lanes + i);
+        num_ += CompressStore(v, st.Compare(d, v, threshold), d,
+                              buf_.get() + num_);
+        if (HWY_UNLIKELY(num_ + N > capacity_)) {
+          Reduce();
+          threshold = Set(d, buf_[k_ - 1]);
+        }
+      }
+    }
+    const size_t remaining = num - i;
+    if (remaining != 0) {
+      const Vec<D> v = LoadN(d, lanes + i, remaining);
+      const Mask<D> before =
+          And(FirstN(d, remaining), st.Compare(d, v, threshold));
+      num_ += CompressStore(v, before, d, buf_.get() + num_);
+      if (num_ + N > capacity_) Reduce();
+    }
+  }
+
+  // Writes the first min(k, number of keys seen) keys to `out` in sorted
+  // order, and returns how many. Further keys may be added afterwards.
+  size_t TopK(Key* HWY_RESTRICT out) {
+    const size_t num = HWY_MIN(k_, num_);
+    if (num == 0) return 0;
+    Key* keys = reinterpret_cast<Key*>(buf_.get());
+    // Partial sort requires k < num, otherwise the scalar fallback reads past
+    // the valid keys.
+    if (num_ <= k_) {
+      VQSortStatic(keys, num_, Order());
+    } else {
+      VQPartialSortStatic(keys, num_, num, Order());
+    }
+    num_ = num;
+    CopyBytes(buf_.get(), out, num * sizeof(Key));
+    return num;
+  }
+
+ private:
+  // Moves the first k keys to the front of the buffer, discards the others,
+  // and sets the threshold to the k-th key.
+  void Reduce() {
+    HWY_DASSERT(num_ >= k_);
+    VQSelectStatic(reinterpret_cast<Key*>(buf_.get()), num_, k_ - 1, Order());
+    num_ = k_;
+    have_threshold_ = true;
+  }
+
+  size_t k_;
+  size_t capacity_;  // in keys
+  AlignedFreeUniquePtr<T[]> buf_;
+  size_t num_ = 0;  // valid keys in `buf_`
+  bool have_threshold_ = false;
+};
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQTOPK_TOGGLE
@@ -0,0 +1,257 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_VQUNIQUE_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_VQUNIQUE_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_VQUNIQUE_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_VQUNIQUE_TOGGLE
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/base.h"
+#include "hwy/contrib/sort/order.h"       // SortAscending
+#include "hwy/contrib/sort/vqsort-inl.h"  // MakeTraits
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+// Progress of an in-place pass that removes duplicates from consecutive
+// ranges of sorted keys. Unique keys are written to the front of `keys`; all
+// keys before the range currently being processed have been consumed.
+template <typename T>
+struct UniqueState {
+  T* HWY_RESTRICT keys;
+  size_t* HWY_RESTRICT counts;  // optional
+  size_t num_lanes = 0;         // written to `keys`
+  size_t num_runs = 0;          // only updated if `counts`
+  size_t run_begin = 0;         // lane index of the first key of the last run
+};
+
+// Called for each key that differs from its predecessor, in ascending order of
+// `pos`, which is a lane index. Only required if `counts`.
+template <size_t kLPK, typename T>
+HWY_INLINE void BeginRun(UniqueState<T>& s, const size_t pos) {
+  if (HWY_LIKELY(s.num_runs != 0)) {
+    s.counts[s.num_runs - 1] = (pos - s.run_begin) / kLPK;
+  }
+  s.run_begin = pos;
+  ++s.num_runs;
+}
+
+// Calls BeginRun for each key whose lanes are set in `begins`. The set bits
+// are usually sparse, hence we only visit those.
+template <size_t kLPK, class D, typename T>
+HWY_INLINE void BeginRuns(D d, const Mask<D> begins, const size_t pos,
+                          UniqueState<T>& s) {
+  uint8_t bits[HWY_MAX(size_t{8}, (HWY_MAX_LANES_D(D) + 7) / 8)];
+  const size_t num_bytes = StoreMaskBits(d, begins, bits);
+  for (size_t i = 0; i < num_bytes; ++i) {
+    // For 128-bit keys, both lanes are set; only visit the first.
+    uint32_t byte = bits[i] & (kLPK == 1 ? 0xFFu : 0x55u);
+    while (byte != 0) {
+      BeginRun<kLPK>(s, pos + i * 8 + Num0BitsBelowLS1Bit_Nonzero32(byte));
+      byte &= byte - 1;
+    }
+  }
+}
+
+// Appends the unique keys of the sorted `s.keys[begin, begin + num)` to those
+// already written, which must be all keys of `s.keys[0, begin)`. `begin` and
+// `num` are in lanes. Keys equal to their predecessor are discarded by a
+// vector comparison with the keys shifted by one, then CompressStore. This
+// writes a whole vector, but never past the keys that were already loaded.
+template <class D, class Traits, typename T>
+void AppendUnique(D d, Traits st, const size_t begin, const size_t num,
+                  UniqueState<T>& s) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t N = Lanes(d);
+  T* HWY_RESTRICT keys = s.keys;
+  const size_t end = begin + num;
+  size_t i = begin;
+  if (HWY_UNLIKELY(s.num_lanes == 0)) {
+    if (num == 0) return;
+    HWY_DASSERT(begin == 0);
+    if (s.counts) BeginRun<kLPK>(s, 0);
+    s.num_lanes = kLPK;
+    i = kLPK;
+  }
+
+  // The previous key, which is also the last that was written. Overwritten by
+  // CompressStore, hence we keep a copy.
+  HWY_ALIGN T prev_key[kLPK];
+  CopyBytes(keys + s.num_lanes - kLPK, prev_key, sizeof(prev_key));
+
+  if (N >= kLPK && end - i >= N) {
+    for (; i <= end - N; i += N) {
+      const Vec<D> v = LoadU(d, keys + i);
+      const Vec<D> shifted =
+          (kLPK == 1) ? Slide1Up(d, v) : SlideUpLanes(d, v, kLPK);
+      const Vec<D> first = (kLPK == 1) ? Set(d, prev_key[0])
+                                       : LoadN(d, prev_key, kLPK);
+      const Vec<D> prev = IfThenElse(FirstN(d, kLPK), first, shifted);
+      const Mask<D> begins = st.NotEqualKeys(d, v, prev);
+      if (s.counts) BeginRuns<kLPK>(d, begins, i, s);
+      CopyBytes(keys + i + N - kLPK, prev_key, sizeof(prev_key));
+      s.num_lanes += CompressStore(v, begins, d, keys + s.num_lanes);
+    }
+  }
+
+  for (; i < end; i += kLPK) {
+    if (st.Equal1(keys + i, prev_key)) continue;
+    if (s.counts) BeginRun<kLPK>(s, i);
+    CopyBytes(keys + i, prev_key, sizeof(prev_key));
+    CopyBytes(prev_key, keys + s.num_lanes, sizeof(prev_key));
+    s.num_lanes += kLPK;
+  }
+}
+
+// Returns the number of unique keys after the last call to AppendUnique.
+// `num` is the total number of lanes passed to AppendUnique.
+template <size_t kLPK, typename T>
+size_t FinishUnique(UniqueState<T>& s, const size_t num) {
+  if (s.counts && s.num_runs != 0) {
+    s.counts[s.num_runs - 1] = (num - s.run_begin) / kLPK;
+  }
+  return s.num_lanes / kLPK;
+}
+
+#if VQSORT_ENABLED || HWY_IDE
+
+// As Recurse<kSort>, but removes duplicates from each subarray once it is
+// sorted, which is in ascending order of their position. Hence each key is
+// deduplicated while still in cache, instead of in another pass over memory.
+template <class D, class Traits, typename T>
+HWY_NOINLINE void RecurseUnique(D d, Traits st, const size_t begin,
+                                const size_t num, T* HWY_RESTRICT buf,
+                                uint64_t* HWY_RESTRICT state,
+                                const size_t remaining_levels,
+                                UniqueState<T>& s) {
+  HWY_DASSERT(num != 0);
+  T* HWY_RESTRICT keys = s.keys + begin;
+  constexpr size_t kLPK = st.LanesPerKey();
+  if (HWY_UNLIKELY(num <= Constants::BaseCaseNumLanes<kLPK>(Lanes(d)))) {
+    BaseCase(d, st, keys, num, buf);
+    return AppendUnique(d, st, begin, num, s);
+  }
+
+  size_t bound;
+  PivotResult result;
+  if (!PartitionStep(d, st, keys, num, buf, state, remaining_levels, bound,
+                     result)) {
+    return AppendUnique(d, st, begin, num, s);
+  }
+
+  // Partitions known to consist of keys equal to the pivot are already sorted.
+  if (HWY_LIKELY(result != PivotResult::kIsFirst)) {
+    RecurseUnique(d, st, begin, bound, buf, state, remaining_levels - 1, s);
+  } else {
+    AppendUnique(d, st, begin, bound, s);
+  }
+  if (HWY_LIKELY(result != PivotResult::kWasLast)) {
+    RecurseUnique(d, st, begin + bound, num - bound, buf, state,
+                  remaining_levels - 1, s);
+  } else {
+    AppendUnique(d, st, begin + bound, num - bound, s);
+  }
+}
+
+#endif  // VQSORT_ENABLED
+
+template <class D, class Traits, typename T>
+size_t SortUnique(D d, Traits st, T* HWY_RESTRICT keys, const size_t num,
+                  size_t* HWY_RESTRICT counts) {
+#if HWY_MAX_BYTES > 64
+  // sorting_networks-inl and traits assume no more than 512 bit vectors.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return SortUnique(CappedTag<T, 64 / sizeof(T)>(), st, keys, num, counts);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+  constexpr size_t kLPK = st.LanesPerKey();
+  UniqueState<T> s;
+  s.keys = keys;
+  s.counts = counts;
+  if (num == 0) return 0;
+
+#if VQSORT_ENABLED || HWY_IDE
+  HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) / sizeof(T)];
+  if (detail::HandleSpecialCases(d, st, keys, num, buf)) {
+    AppendUnique(d, st, 0, num, s);
+  } else {
+    uint64_t* HWY_RESTRICT state = hwy::detail::GetGeneratorStateStatic();
+    const size_t max_levels = 50;  // as in Sort
+    RecurseUnique(d, st, 0, num, buf, state, max_levels, s);
+  }
+#else   // !VQSORT_ENABLED
+  HeapSort(st, keys, num);
+  AppendUnique(d, st, 0, num, s);
+#endif  // VQSORT_ENABLED
+  return FinishUnique<kLPK>(s, num);
+}
+
+}  // namespace detail
+
+// Removes consecutive duplicates from `keys[0, num_keys)`, which are typically
+// sorted, like std::unique. The first key of each group of equal keys is moved
+// to the front, in their original order. Returns the number of such keys.
+// Supports the same key types as VQSortStatic; for K32V32 and K64V64, only
+// the keys are compared. Floating-point keys compare as equal if they are ==.
+//
+// If `counts` is non-null, it must have space for `num_keys` entries. Then
+// `counts[i]` is set to the number of keys in the group of the i-th unique
+// key, which is a group-by count.
+template <typename Key>
+size_t VQUniqueStatic(Key* HWY_RESTRICT keys, const size_t num_keys,
+                      size_t* HWY_RESTRICT counts = nullptr) {
+  const detail::MakeTraits<Key, SortAscending> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  constexpr size_t kLPK = st.LanesPerKey();
+  detail::UniqueState<LaneType> s;
+  s.keys = reinterpret_cast<LaneType*>(keys);
+  s.counts = counts;
+  detail::AppendUnique(d, st, 0, num_keys * kLPK, s);
+  return detail::FinishUnique<kLPK>(s, num_keys * kLPK);
+}
+
+// Equivalent to VQSortStatic followed by VQUniqueStatic, but faster because
+// duplicates are removed from each subarray right after it is sorted, while it
+// is still in cache. Keys must not be NaN. For K32V32 and K64V64, which of
+// several keys with equal key (but different value) is retained is
+// unspecified, as is the order of equal keys in VQSort.
+template <typename Key, class Order>
+size_t VQSortUniqueStatic(Key* HWY_RESTRICT keys, const size_t num_keys, Order,
+                          size_t* HWY_RESTRICT counts = nullptr) {
+  const detail::MakeTraits<Key, Order> st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  return detail::SortUnique(d, st, reinterpret_cast<LaneType*>(keys),
+                            num_keys * st.LanesPerKey(), counts);
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQUNIQUE_TOGGLE
@@ -0,0 +1,194 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>  // std::sort
+#include <atomic>
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort_parallel.h"
+#include "hwy/contrib/thread_pool/hierarchical_pool.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/contrib/thread_pool/topology.h"
+#include "hwy/tests/hwy_gtest.h"
+#include "hwy/tests/test_util-inl.h"  // AdjustedReps
+#include "hwy/timer.h"
+// Static dispatch only, the pool is the subject of this benchmark.
+#include "hwy/contrib/matvec/matvec-inl.h"
+
+namespace hwy {
+namespace {
+
+// MatVec dimensions for BenchPinning: 8 MiB, more than most L2 caches.
+constexpr size_t kRows = 1024;
+constexpr size_t kCols = 2048;
+
+}  // namespace
+}  // namespace hwy
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+void CallMatVec(const float* HWY_RESTRICT mat, const float* HWY_RESTRICT vec,
+                float* HWY_RESTRICT out, ThreadPool& pool) {
+  MatVec<kRows, kCols>(mat, vec, out, pool);
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+namespace hwy {
+namespace {
+
+// Measures the fork-join latency of `pool.Run` with one trivial task per
+// worker, and prints the median and minimum in microseconds.
+template <class Pool>
+void BenchForkJoin(const char* caption, Pool& pool, PoolWaitMode mode) {
+  pool.SetWaitMode(mode);
+  const size_t num_workers = pool.NumWorkers();
+  const size_t reps = AdjustedReps(2000);
+  std::atomic<uint64_t> sum{0};
+  std::vector<double> elapsed;
+  elapsed.reserve(reps);
+  for (size_t rep = 0; rep < reps; ++rep) {
+    const Timestamp t0;
+    pool.Run(0, num_workers, [&sum](uint64_t task, size_t /*worker*/) {
+      sum.fetch_add(task, std::memory_order_relaxed);
+    });
+    elapsed.push_back(SecondsSince(t0));
+  }
+  HWY_ASSERT(sum.load() == reps * (num_workers * (num_workers - 1) / 2));
+
+  std::sort(elapsed.begin(), elapsed.end());
+  fprintf(stderr, "%-12s %s %3zu workers: median %7.2f us, min %7.2f us\n",
+          caption, mode == PoolWaitMode::kSpin ? "spin " : "block",
+          num_workers, elapsed[elapsed.size() / 2] * 1E6, elapsed[0] * 1E6);
+}
+
+TEST(BenchPool, BenchAllForkJoin) {
+  if (!HaveThreadingSupport()) return;
+
+  const Topology topology;
+  // Construct the flat pool first because the hierarchical one pins the
+  // main thread.
+  ThreadPool flat(ThreadPool::MaxThreads());
+  HierarchicalPool hierarchical(topology);
+  fprintf(stderr, "HierarchicalPool: %zu packages, %zu clusters\n",
+          hierarchical.NumPackages(), hierarchical.NumClusters());
+
+  for (PoolWaitMode mode : {PoolWaitMode::kSpin, PoolWaitMode::kBlock}) {
+    BenchForkJoin("ThreadPool", flat, mode);
+    BenchForkJoin("Hierarchical", hierarchical, mode);
+  }
+}
+
+const char* PinningName(PoolPinning pinning) {
+  switch (pinning) {
+    case PoolPinning::kNone:
+      return "none";
+    case PoolPinning::kCompact:
+      return "compact";
+    case PoolPinning::kScatterCores:
+      return "scatter";
+    case PoolPinning::kPerCluster:
+      return "cluster";
+    case PoolPinning::kPerNode:
+      return "node";
+  }
+  return "?";
+}
+
+// Returns the median of `elapsed`, which is reordered.
+double Median(std::vector<double>& elapsed) {
+  std::sort(elapsed.begin(), elapsed.end());
+  return elapsed[elapsed.size() / 2];
+}
+
+// Measures memory-bound MatVec and compute-bound VQSortParallel with all
+// threads pinned according to each policy.
+TEST(BenchPool, BenchPinning) {
+  if (!HaveThreadingSupport()) return;
+
+  const Topology topology;
+  LogicalProcessorSet original;
+  const bool have_affinity = GetThreadAffinity(original);
+
+  AlignedFreeUniquePtr<float[]> mat = AllocateAligned<float>(kRows * kCols);
+  AlignedFreeUniquePtr<float[]> vec = AllocateAligned<float>(kCols);
+  AlignedFreeUniquePtr<float[]> out = AllocateAligned<float>(kRows);
+  const size_t num_keys = size_t{1} << 21;
+  AlignedFreeUniquePtr<uint64_t[]> keys = AllocateAligned<uint64_t>(num_keys);
+  HWY_ASSERT(mat && vec && out && keys);
+  for (size_t i = 0; i < kRows * kCols; ++i) {
+    mat[i] = static_cast<float>(i % 17) * 0.25f;
+  }
+  for (size_t i = 0; i < kCols; ++i) vec[i] = static_cast<float>(i % 5);
+
+  const PoolPinning policies[] = {
+      PoolPinning::kNone, PoolPinning::kCompact, PoolPinning::kScatterCores,
+      PoolPinning::kPerCluster, PoolPinning::kPerNode};
+  for (PoolPinning pinning : policies) {
+    // Pinning the main thread restricts the LPs available to the next pool.
+    if (have_affinity) HWY_ASSERT(SetThreadAffinity(original));
+    ThreadPool pool(ThreadPool::MaxThreads(), topology, pinning);
+
+    std::vector<double> elapsed;
+    for (size_t rep = 0; rep < AdjustedReps(50); ++rep) {
+      const Timestamp t0;
+      HWY_STATIC_DISPATCH(CallMatVec)(mat.get(), vec.get(), out.get(), pool);
+      elapsed.push_back(SecondsSince(t0));
+    }
+    const double matvec = Median(elapsed);
+
+    elapsed.clear();
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (size_t rep = 0; rep < AdjustedReps(5); ++rep) {
+      for (size_t i = 0; i < num_keys; ++i) {  // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        keys[i] = state;
+      }
+      const Timestamp t0;
+      VQSortParallel(keys.get(), num_keys, SortAscending(), pool);
+      elapsed.push_back(SecondsSince(t0));
+      HWY_ASSERT(keys[0] <= keys[num_keys / 2]);
+    }
+    const double sort = Median(elapsed);
+
+    fprintf(stderr,
+            "Pinning %-8s %3zu workers: MatVec %7.2f us, VQSortParallel "
+            "%7.2f ms\n",
+            PinningName(pinning), pool.NumWorkers(), matvec * 1E6,
+            sort * 1E3);
+  }
+
+  if (have_affinity) HWY_ASSERT(SetThreadAffinity(original));
+}
+
+}  // namespace
+}  // namespace hwy
+
+HWY_TEST_MAIN();
@@ -0,0 +1,247 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HIGHWAY_HWY_CONTRIB_THREAD_POOL_HIERARCHICAL_POOL_H_
+#define HIGHWAY_HWY_CONTRIB_THREAD_POOL_HIERARCHICAL_POOL_H_
+
+// Thread pool whose workers are grouped by package and cluster.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>  // std::move
+#include <vector>
+
+#include "hwy/aligned_allocator.h"  // MakeUniqueAligned
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/contrib/thread_pool/topology.h"
+
+namespace hwy {
+
+// Nested `ThreadPool`: one for the packages (sockets, or NUMA nodes if a
+// package has several), one per package for its clusters, and one per cluster
+// for its logical processors (LPs). `Run` splits tasks across clusters in
+// proportion to their number of LPs, and each cluster then runs its contiguous
+// share. Thus each barrier only involves threads that
+// share a package or cluster, and only one thread per package communicates
+// across packages. The flat `ThreadPool` is preferable if its threads already
+// share a cluster, because each level adds some fork-join latency.
+//
+// Each thread is pinned to one LP, which is required for the above to be
+// effective. This includes the thread that calls the ctor and `Run`, which is
+// the main thread of all pools and is pinned to the first LP. If the LPs are
+// not in use by another pool, they are leased from `pool::Arbiter` so that
+// pools constructed with `PoolLease::kExclusive` do not also use them.
+class HierarchicalPool {
+ public:
+  // LPs of each cluster of each package.
+  using ClusterLPs = std::vector<size_t>;
+  using PackageLPs = std::vector<ClusterLPs>;
+
+  // Returns the LPs available to this process, grouped by package and cluster.
+  // Packages with clusters on several NUMA nodes are split into one entry per
+  // node. Falls back to a single package and cluster if `topology` is unknown.
+  static std::vector<PackageLPs> AvailableLPs(const Topology& topology) {
+    LogicalProcessorSet enabled;
+    const bool have_affinity = GetThreadAffinity(enabled);
+
+    std::vector<PackageLPs> packages;
+    for (const Topology::Package& package : topology.packages) {
+      const size_t first_package = packages.size();
+      std::vector<size_t> nodes;  // of each entry starting at `first_package`
+      for (const Topology::Cluster& cluster : package.clusters) {
+        ClusterLPs lps;
+        cluster.lps.Foreach([&](size_t lp) {
+          if (!have_affinity || enabled.Get(lp)) lps.push_back(lp);
+        });
+        if (lps.empty()) continue;
+        const size_t node =
+            lps[0] < topology.lps.size() ? topology.lps[lps[0]].node : 0;
+        size_t idx = 0;
+        while (idx < nodes.size() && nodes[idx] != node) ++idx;
+        if (idx == nodes.size()) {
+          nodes.push_back(node);
+          packages.push_back(PackageLPs());
+        }
+        packages[first_package + idx].push_back(lps);
+      }
+    }
+
+    if (packages.empty()) {
+      ClusterLPs lps;
+      if (have_affinity) {
+        enabled.Foreach([&](size_t lp) { lps.push_back(lp); });
+      } else {
+        for (size_t lp = 0; lp <= ThreadPool::MaxThreads(); ++lp) {
+          lps.push_back(lp);
+        }
+      }
+      packages.push_back(PackageLPs(1, lps));
+    }
+    return packages;
+  }
+
+  explicit HierarchicalPool(const Topology& topology)
+      : HierarchicalPool(AvailableLPs(topology), /*pin=*/true) {}
+
+  // Creates one worker per LP in `packages`, which must be non-empty. If
+  // `pin`, each is pinned to its LP. Clusters with more than
+  // `pool::kMaxThreads + 1` LPs are truncated. Also used by tests.
+  HierarchicalPool(const std::vector<PackageLPs>& packages, bool pin) {
+    HWY_ASSERT(!packages.empty());
+    packages_pool_ = MakeUniqueAligned<ThreadPool>(packages.size() - 1);
+    for (const PackageLPs& package : packages) {
+      HWY_ASSERT(!package.empty());
+      cluster_begin_.push_back(clusters_.size());
+      clusters_pools_.push_back(
+          MakeUniqueAligned<ThreadPool>(package.size() - 1));
+      for (const ClusterLPs& lps : package) {
+        HWY_ASSERT(!lps.empty());
+        const size_t num_workers = HWY_MIN(lps.size(), pool::kMaxThreads + 1);
+        Cluster cluster;
+        cluster.worker_begin = num_workers_;
+        cluster.lps.assign(lps.begin(),
+                           lps.begin() + static_cast<ptrdiff_t>(num_workers));
+        cluster.pool = MakeUniqueAligned<ThreadPool>(num_workers - 1);
+        clusters_.push_back(std::move(cluster));
+        num_workers_ += num_workers;
+      }
+    }
+    cluster_begin_.push_back(clusters_.size());
+    div_workers_ = Divisor64(num_workers_);
+
+    if (pin) {
+      // Each cluster pool's worker 0 is the thread that calls its `Run`, which
+      // is deterministic because all levels have one task per worker.
+      ForeachCluster([this](size_t idx_cluster) {
+        const Cluster& cluster = clusters_[idx_cluster];
+        cluster.pool->Run(0, cluster.pool->NumWorkers(),
+                          [&cluster](uint64_t task, size_t worker) {
+                            HWY_DASSERT(task == worker);
+                            (void)task;
+                            if (!PinThreadToLogicalProcessor(
+                                    cluster.lps[worker])) {
+                              HWY_WARN("Pinning to LP %zu failed.",
+                                       cluster.lps[worker]);
+                            }
+                          });
+      });
+
+      std::vector<size_t> all_lps;
+      for (const Cluster& cluster : clusters_) {
+        all_lps.insert(all_lps.end(), cluster.lps.begin(), cluster.lps.end());
+      }
+      leased_lps_ = pool::Arbiter::Get().Lease(all_lps, all_lps.size());
+      if (leased_lps_.size() != all_lps.size()) {  // Shared with another pool.
+        pool::Arbiter::Get().Release(leased_lps_);
+        leased_lps_.clear();
+      }
+    }
+  }
+
+  ~HierarchicalPool() {
+    // Release only after the threads have exited.
+    clusters_.clear();
+    clusters_pools_.clear();
+    packages_pool_.reset();
+    if (!leased_lps_.empty()) pool::Arbiter::Get().Release(leased_lps_);
+  }
+
+  HierarchicalPool(const HierarchicalPool&) = delete;
+  HierarchicalPool& operator=(const HierarchicalPool&) = delete;
+
+  size_t NumPackages() const { return cluster_begin_.size() - 1; }
+  size_t NumClusters() const { return clusters_.size(); }
+  // Total number of workers, one per LP; the `worker` argument of `Run` is
+  // less than this.
+  size_t NumWorkers() const { return num_workers_; }
+
+  // Applies `mode` to all pools, see `ThreadPool::SetWaitMode`.
+  void SetWaitMode(PoolWaitMode mode) {
+    ForeachPool([mode](ThreadPool& pool) { pool.SetWaitMode(mode); });
+  }
+
+  // parallel-for: Runs `closure(task, worker)` for every `task` in
+  // `[begin, end)`, where `worker < NumWorkers()` identifies the thread. The
+  // tasks are split into one contiguous range per cluster, and workers only
+  // steal tasks from others in the same cluster. Not thread-safe.
+  template <class Closure>
+  void Run(uint64_t begin, uint64_t end, const Closure& closure) {
+    HWY_DASSERT(begin <= end);
+    const uint64_t num_tasks = end - begin;
+    ForeachCluster([&](size_t idx_cluster) {
+      const Cluster& cluster = clusters_[idx_cluster];
+      const size_t worker_begin = cluster.worker_begin;
+      const size_t worker_end = worker_begin + cluster.pool->NumWorkers();
+      const uint64_t cluster_begin = begin + Share(num_tasks, worker_begin);
+      const uint64_t cluster_end = begin + Share(num_tasks, worker_end);
+      cluster.pool->Run(cluster_begin, cluster_end,
+                        [&closure, worker_begin](uint64_t task, size_t worker) {
+                          closure(task, worker_begin + worker);
+                        });
+    });
+  }
+
+ private:
+  struct Cluster {
+    size_t worker_begin;  // index of the first worker in this cluster
+    std::vector<size_t> lps;
+    AlignedUniquePtr<ThreadPool> pool;
+  };
+
+  // Returns floor(num_tasks * workers / num_workers_) without overflow, i.e.
+  // the first task of the worker with index `workers`.
+  uint64_t Share(uint64_t num_tasks, size_t workers) const {
+    return div_workers_.Divide(num_tasks) * workers +
+           div_workers_.Divide(div_workers_.Remainder(num_tasks) * workers);
+  }
+
+  // Calls `func(pool)` for each of the nested pools, on the calling thread.
+  template <class Func>
+  void ForeachPool(const Func& func) {
+    func(*packages_pool_);
+    for (AlignedUniquePtr<ThreadPool>& pool : clusters_pools_) func(*pool);
+    for (Cluster& cluster : clusters_) func(*cluster.pool);
+  }
+
+  // Calls `func(idx_cluster)` for each cluster, on the thread that is the
+  // main thread of that cluster's pool.
+  template <class Func>
+  void ForeachCluster(const Func& func) {
+    packages_pool_->Run(
+        0, NumPackages(), [&](uint64_t package, size_t /*worker*/) {
+          const size_t first = cluster_begin_[package];
+          const size_t num = cluster_begin_[package + 1] - first;
+          clusters_pools_[package]->Run(
+              0, num, [&](uint64_t cluster, size_t /*worker*/) {
+                func(first + static_cast<size_t>(cluster));
+              });
+        });
+  }
+
+  AlignedUniquePtr<ThreadPool> packages_pool_;
+  std::vector<AlignedUniquePtr<ThreadPool>> clusters_pools_;  // per package
+  // Index of the first cluster of each package, plus one past the last.
+  std::vector<size_t> cluster_begin_;
+  std::vector<Cluster> clusters_;
+  size_t num_workers_ = 0;
+  Divisor64 div_workers_{1};
+  std::vector<size_t> leased_lps_;  // empty unless all LPs could be leased
+};
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_HIERARCHICAL_POOL_H_
@@ -0,0 +1,105 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_THREAD_POOL_PARALLEL_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_THREAD_POOL_PARALLEL_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_THREAD_POOL_PARALLEL_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_THREAD_POOL_PARALLEL_INL_H_
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/contrib/thread_pool/parallel.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// As `ParallelReduce`, but with vector accumulators: returns the combination
+// of `map(item)`, which returns `Vec<D>`, for every `item` in `[begin, end)`,
+// or `init` if the range is empty. `combine(V, V)` must be associative, and
+// `init` its identity. The same blocks and tree order as `ParallelReduce` make
+// the result deterministic for a given `pool.NumWorkers()`.
+//
+// Vectors are not passed through the target-independent `ThreadPool`, but
+// stored to per-block slots, hence this also supports scalable vectors. As
+// usual for lambdas called from per-target code, `map` and `combine` must be
+// annotated with `HWY_ATTR`.
+template <class D, class Map, class Combine, class V = VFromD<D>>
+HWY_INLINE V ParallelReduceVectors(D d, ThreadPool& pool, uint64_t begin,
+                                   uint64_t end, V init, const Map& map,
+                                   const Combine& combine) {
+  using T = TFromD<D>;
+  HWY_DASSERT(begin <= end);
+  if (HWY_UNLIKELY(begin >= end)) return init;
+  const uint64_t num_items = end - begin;
+  const size_t num_blocks =
+      static_cast<size_t>(HWY_MIN(uint64_t{pool.NumWorkers()}, num_items));
+  if (HWY_UNLIKELY(num_blocks == 1)) {
+    V acc = init;
+    for (uint64_t item = begin; item < end; ++item) {
+      acc = combine(acc, map(item));
+    }
+    return acc;
+  }
+
+  // One slot for `init`, then one per block, each padded to avoid false
+  // sharing.
+  const size_t N = Lanes(d);
+  const size_t stride = RoundUpTo(N * sizeof(T), HWY_ALIGNMENT) / sizeof(T);
+  AlignedFreeUniquePtr<T[]> slots =
+      AllocateAligned<T>((1 + num_blocks) * stride);
+  HWY_ASSERT(slots);
+  T* HWY_RESTRICT init_lanes = slots.get();
+  T* HWY_RESTRICT block_lanes = slots.get() + stride;
+  Store(init, d, init_lanes);
+
+  // At most one task per worker, hence no stealing and only one slot access.
+  pool.Run(0, num_blocks, [&](uint64_t block, size_t /*worker*/) HWY_ATTR {
+    const uint64_t block_begin =
+        begin + pool::BlockBegin(num_items, num_blocks, block);
+    const uint64_t block_end =
+        begin + pool::BlockBegin(num_items, num_blocks, block + 1);
+    V acc = Load(d, init_lanes);
+    for (uint64_t item = block_begin; item < block_end; ++item) {
+      acc = combine(acc, map(item));
+    }
+    Store(acc, d, block_lanes + block * stride);
+  });
+
+  // Pairwise tree: the order only depends on `num_blocks`.
+  for (size_t step = 1; step < num_blocks; step *= 2) {
+    for (size_t i = 0; i + step < num_blocks; i += 2 * step) {
+      Store(combine(Load(d, block_lanes + i * stride),
+                    Load(d, block_lanes + (i + step) * stride)),
+            d, block_lanes + i * stride);
+    }
+  }
+  return Load(d, block_lanes);
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_PARALLEL_INL_H_
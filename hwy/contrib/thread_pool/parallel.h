@@ -0,0 +1,264 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HIGHWAY_HWY_CONTRIB_THREAD_POOL_PARALLEL_H_
+#define HIGHWAY_HWY_CONTRIB_THREAD_POOL_PARALLEL_H_
+
+// Parallel loops and reductions over ranges of items, built on
+// `ThreadPool::Run`.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include "hwy/aligned_allocator.h"  // HWY_ALIGNMENT
+#include "hwy/auto_tune.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/timer.h"
+
+namespace hwy {
+
+// How `ParallelFor` assigns items to workers. `ThreadPool::Run` itself calls
+// the closure once per task, with an atomic increment per task; these
+// policies instead pass a range of `grain` or more items to each call.
+enum class ParallelSchedule : uint8_t {
+  // One contiguous block per worker and no atomics. Lowest overhead, but only
+  // suitable if items have similar cost.
+  kStatic,
+  // Blocks of `grain` items, load-balanced by the work stealing of `Run`.
+  kChunked,
+  // Each worker repeatedly takes the next `remaining / (2 * NumWorkers())`
+  // items, but at least `grain`. Fewer atomics than `kChunked` for large
+  // ranges, while still balancing load towards the end.
+  kGuided,
+};
+
+namespace pool {
+
+// Calls `func(item, worker)` for each item in `[begin, end)`.
+template <class Func>
+HWY_INLINE void RunItems(uint64_t begin, uint64_t end, size_t worker,
+                         const Func& func) {
+  for (uint64_t item = begin; item < end; ++item) {
+    func(item, worker);
+  }
+}
+
+// Returns the first item of `block` when splitting `num_items` into
+// `num_blocks`, with one more item in each of the first blocks.
+static inline uint64_t BlockBegin(uint64_t num_items, uint64_t num_blocks,
+                                  uint64_t block) {
+  const uint64_t min_items = num_items / num_blocks;
+  const uint64_t remainder = num_items % num_blocks;
+  return block * min_items + HWY_MIN(block, remainder);
+}
+
+}  // namespace pool
+
+// Calls `func(item, worker)` for every `item` in `[begin, end)`, where
+// `worker < pool.NumWorkers()`, with items assigned to workers according to
+// `schedule`. `grain` is the minimum number of consecutive items per
+// assignment, and should be large enough to amortize the overhead of an
+// atomic operation. Like `ThreadPool::Run`, this is not thread-safe.
+template <class Func>
+void ParallelFor(ThreadPool& pool, uint64_t begin, uint64_t end,
+                 ParallelSchedule schedule, uint64_t grain, const Func& func) {
+  HWY_DASSERT(begin <= end);
+  if (HWY_UNLIKELY(begin >= end)) return;
+  const uint64_t num_items = end - begin;
+  grain = HWY_MAX(grain, uint64_t{1});
+  const uint64_t num_workers = pool.NumWorkers();
+  // Not worth waking workers.
+  if (HWY_UNLIKELY(num_workers == 1 || num_items <= grain)) {
+    return pool::RunItems(begin, end, /*worker=*/0, func);
+  }
+
+  switch (schedule) {
+    case ParallelSchedule::kStatic: {
+      const uint64_t num_blocks =
+          HWY_MIN(num_workers, DivCeil(num_items, grain));
+      pool.Run(0, num_blocks, [&](uint64_t block, size_t worker) {
+        pool::RunItems(begin + pool::BlockBegin(num_items, num_blocks, block),
+                       begin + pool::BlockBegin(num_items, num_blocks,
+                                                block + 1),
+                       worker, func);
+      });
+      return;
+    }
+
+    case ParallelSchedule::kChunked: {
+      const uint64_t num_chunks = DivCeil(num_items, grain);
+      pool.Run(0, num_chunks, [&](uint64_t chunk, size_t worker) {
+        const uint64_t first = begin + chunk * grain;
+        pool::RunItems(first, HWY_MIN(first + grain, end), worker, func);
+      });
+      return;
+    }
+
+    case ParallelSchedule::kGuided: {
+      std::atomic<uint64_t> next{begin};
+      pool.Run(0, num_workers, [&](uint64_t /*task*/, size_t worker) {
+        uint64_t first = next.load(std::memory_order_relaxed);
+        while (first < end) {
+          const uint64_t size =
+              HWY_MAX(grain, (end - first) / (2 * num_workers));
+          const uint64_t last = HWY_MIN(first + size, end);
+          // On failure, `first` is updated to the current value.
+          if (next.compare_exchange_weak(first, last,
+                                         std::memory_order_relaxed)) {
+            pool::RunItems(first, last, worker, func);
+            first = next.load(std::memory_order_relaxed);
+          }
+        }
+      });
+      return;
+    }
+  }
+}
+
+// Chooses the chunk size for `ParallelFor` with `kChunked` by auto-tuning
+// over calls. The candidates are `grain` times powers of two, up to one chunk
+// per worker. Each call site with differing items, or pool, should have its
+// own instance, typically `static`. Not thread-safe.
+class ParallelForTuner {
+  using AutoTuneT = AutoTune<uint64_t, 4>;
+
+ public:
+  explicit ParallelForTuner(uint64_t grain = 1)
+      : grain_(HWY_MAX(grain, uint64_t{1})) {}
+
+  // Returns the chunk size to use for the next call, which must be followed by
+  // `NotifyCost`.
+  uint64_t NextChunk(uint64_t num_items, size_t num_workers) {
+    if (HWY_LIKELY(auto_tune_.Best())) return *auto_tune_.Best();
+    if (HWY_UNLIKELY(!auto_tune_.HasCandidates())) {
+      std::vector<uint64_t> candidates;
+      const uint64_t max_chunk =
+          HWY_MAX(grain_, num_items / HWY_MAX(num_workers, size_t{1}));
+      for (uint64_t chunk = grain_; chunk <= max_chunk; chunk *= 2) {
+        candidates.push_back(chunk);
+      }
+      auto_tune_.SetCandidates(candidates);
+    }
+    return auto_tune_.NextConfig();
+  }
+
+  // `ticks` is the elapsed time of the call with `num_items`.
+  void NotifyCost(uint64_t ticks, uint64_t num_items) {
+    if (auto_tune_.Best()) return;
+    // Normalize to 1024 items, because the number may differ between calls.
+    auto_tune_.NotifyCost(ticks * 1024 / HWY_MAX(num_items, uint64_t{1}));
+  }
+
+  // Returns the chosen chunk size, or zero if still tuning.
+  uint64_t Best() const {
+    return auto_tune_.Best() ? *auto_tune_.Best() : 0;
+  }
+
+ private:
+  uint64_t grain_;
+  AutoTuneT auto_tune_;
+};
+
+// As above, with `kChunked` and the chunk size chosen by `tuner`.
+template <class Func>
+void ParallelFor(ThreadPool& pool, uint64_t begin, uint64_t end,
+                 ParallelForTuner& tuner, const Func& func) {
+  HWY_DASSERT(begin <= end);
+  const uint64_t num_items = end - begin;
+  if (HWY_LIKELY(tuner.Best() != 0)) {
+    return ParallelFor(pool, begin, end, ParallelSchedule::kChunked,
+                       tuner.Best(), func);
+  }
+
+  const uint64_t chunk = tuner.NextChunk(num_items, pool.NumWorkers());
+  const uint64_t t0 = timer::Start();
+  ParallelFor(pool, begin, end, ParallelSchedule::kChunked, chunk, func);
+  tuner.NotifyCost(timer::Stop() - t0, num_items);
+}
+
+namespace pool {
+
+// Partial result of one block, padded to avoid false sharing.
+template <typename T>
+struct alignas(HWY_ALIGNMENT) ReduceSlot {
+  explicit ReduceSlot(const T& init) : value(init) {}
+  T value;
+};
+
+// Returns `init` combined with `map(item)` for each item in `[begin, end)`,
+// in ascending order.
+template <typename T, class Map, class Combine>
+HWY_INLINE T ReduceItems(uint64_t begin, uint64_t end, T init, const Map& map,
+                         const Combine& combine) {
+  T acc = init;
+  for (uint64_t item = begin; item < end; ++item) {
+    acc = combine(acc, map(item));
+  }
+  return acc;
+}
+
+}  // namespace pool
+
+// Returns the combination of `map(item)` for every `item` in `[begin, end)`,
+// or `init` if the range is empty. `init` must be the identity of `combine`,
+// e.g. zero for sums, because it is the initial value of every partial result.
+// `combine(T, T)` must be associative, but need not be commutative.
+//
+// The range is split into one contiguous block per worker, each reduced into
+// its own `HWY_ALIGNMENT`-padded slot, and the slots are then combined in a
+// fixed tree order. Thus the result, including rounding of floating-point
+// sums, is deterministic for a given `pool.NumWorkers()`. `T` must not be a
+// SIMD vector because this code is not compiled per target; for those, see
+// `ParallelReduceVectors` in parallel-inl.h. Like `ThreadPool::Run`, this is
+// not thread-safe.
+template <typename T, class Map, class Combine>
+T ParallelReduce(ThreadPool& pool, uint64_t begin, uint64_t end, T init,
+                 const Map& map, const Combine& combine) {
+  HWY_DASSERT(begin <= end);
+  if (HWY_UNLIKELY(begin >= end)) return init;
+  const uint64_t num_items = end - begin;
+  const size_t num_blocks =
+      static_cast<size_t>(HWY_MIN(uint64_t{pool.NumWorkers()}, num_items));
+  if (HWY_UNLIKELY(num_blocks == 1)) {
+    return pool::ReduceItems(begin, end, init, map, combine);
+  }
+
+  AlignedUniquePtr<pool::ReduceSlot<T>[]> slots =
+      MakeUniqueAlignedArray<pool::ReduceSlot<T>>(num_blocks, init);
+  HWY_ASSERT(slots);
+  // At most one task per worker, hence no stealing and only one slot access.
+  pool.Run(0, num_blocks, [&](uint64_t block, size_t /*worker*/) {
+    slots[block].value = pool::ReduceItems(
+        begin + pool::BlockBegin(num_items, num_blocks, block),
+        begin + pool::BlockBegin(num_items, num_blocks, block + 1), init, map,
+        combine);
+  });
+
+  // Pairwise tree: the order only depends on `num_blocks`.
+  for (size_t step = 1; step < num_blocks; step *= 2) {
+    for (size_t i = 0; i + step < num_blocks; i += 2 * step) {
+      slots[i].value = combine(slots[i].value, slots[i + step].value);
+    }
+  }
+  return slots[0].value;
+}
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_PARALLEL_H_
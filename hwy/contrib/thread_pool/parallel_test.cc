@@ -0,0 +1,250 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/thread_pool/parallel.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>  // std::fill
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/thread_pool/parallel_test.cc"  // NOLINT
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+// Must come after foreach_target.h
+#include "hwy/contrib/thread_pool/parallel-inl.h"
+#include "hwy/highway.h"
+#include "hwy/tests/hwy_gtest.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+// Sums `num` floats, a multiple of the vector length, with vector
+// accumulators.
+float SumVectors(ThreadPool& pool, const float* HWY_RESTRICT in, size_t num) {
+  const ScalableTag<float> d;
+  using V = Vec<decltype(d)>;
+  const size_t N = Lanes(d);
+  const V sum = ParallelReduceVectors(
+      d, pool, 0, num / N, Zero(d),
+      [&](uint64_t item) HWY_ATTR { return LoadU(d, in + item * N); },
+      [](V a, V b) HWY_ATTR { return Add(a, b); });
+  return ReduceSum(d, sum);
+}
+
+// Compares with a serial sum of vectors, for each target.
+void TestAllParallelReduceVectors() {
+  if (!HaveThreadingSupport()) return;
+
+  const ScalableTag<int32_t> d;
+  using V = Vec<decltype(d)>;
+  const size_t N = Lanes(d);
+  const size_t num_items = 1000;
+  AlignedFreeUniquePtr<int32_t[]> in = AllocateAligned<int32_t>(num_items * N);
+  HWY_ASSERT(in);
+  for (size_t i = 0; i < num_items * N; ++i) {
+    in[i] = static_cast<int32_t>(i);
+  }
+  const auto load = [&](uint64_t item)
+                        HWY_ATTR { return Load(d, in.get() + item * N); };
+  const auto add = [](V a, V b) HWY_ATTR { return Add(a, b); };
+
+  for (size_t num_threads = 0; num_threads <= 5; ++num_threads) {
+    ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads(), num_threads));
+    for (uint64_t size : {uint64_t{0}, uint64_t{1}, uint64_t{7}, num_items}) {
+      V expected = Zero(d);
+      for (uint64_t item = 0; item < size; ++item) {
+        expected = Add(expected, load(item));
+      }
+      const V actual =
+          ParallelReduceVectors(d, pool, 0, size, Zero(d), load, add);
+      HWY_ASSERT(AllTrue(d, Eq(expected, actual)));
+    }
+  }
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+
+HWY_EXPORT(SumVectors);
+
+// Verifies each item in `[begin, end)` is visited exactly once, by a valid
+// worker.
+void CheckParallelFor(ThreadPool& pool, ParallelSchedule schedule,
+                      uint64_t begin, uint64_t end, uint64_t grain) {
+  const size_t num_items = static_cast<size_t>(end - begin);
+  std::unique_ptr<std::atomic<uint32_t>[]> visits(
+      new std::atomic<uint32_t>[num_items + 1]);
+  for (size_t i = 0; i < num_items + 1; ++i) visits[i].store(0);
+
+  ParallelFor(pool, begin, end, schedule, grain,
+              [&](uint64_t item, size_t worker) {
+                HWY_ASSERT(begin <= item && item < end);
+                HWY_ASSERT(worker < pool.NumWorkers());
+                visits[item - begin].fetch_add(1, std::memory_order_relaxed);
+              });
+
+  for (size_t i = 0; i < num_items; ++i) {
+    const uint32_t count = visits[i].load();
+    if (count != 1) {
+      HWY_ABORT("schedule %d, [%zu, %zu) grain %zu: item %zu visited %u\n",
+                static_cast<int>(schedule), static_cast<size_t>(begin),
+                static_cast<size_t>(end), static_cast<size_t>(grain), i,
+                count);
+    }
+  }
+  HWY_ASSERT(visits[num_items].load() == 0);
+}
+
+TEST(ParallelTest, TestParallelFor) {
+  if (!HaveThreadingSupport()) return;
+
+  const ParallelSchedule schedules[] = {ParallelSchedule::kStatic,
+                                        ParallelSchedule::kChunked,
+                                        ParallelSchedule::kGuided};
+  const uint64_t sizes[] = {0, 1, 2, 3, 7, 64, 1000, 12345};
+  const uint64_t grains[] = {0, 1, 3, 16, 5000};
+  for (size_t num_threads = 0; num_threads <= 5; ++num_threads) {
+    ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads(), num_threads));
+    for (ParallelSchedule schedule : schedules) {
+      for (uint64_t size : sizes) {
+        for (uint64_t grain : grains) {
+          CheckParallelFor(pool, schedule, 0, size, grain);
+          CheckParallelFor(pool, schedule, 1000, 1000 + size, grain);
+        }
+      }
+    }
+  }
+}
+
+TEST(ParallelTest, TestParallelForTuner) {
+  if (!HaveThreadingSupport()) return;
+
+  ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads(), size_t{3}));
+  ParallelForTuner tuner(/*grain=*/4);
+  HWY_ASSERT(tuner.Best() == 0);
+
+  const uint64_t num_items = 4096;
+  std::vector<uint32_t> visits(num_items);
+  size_t calls = 0;
+  for (; calls < 1000 && tuner.Best() == 0; ++calls) {
+    std::fill(visits.begin(), visits.end(), 0u);
+    ParallelFor(pool, 0, num_items, tuner, [&](uint64_t item, size_t worker) {
+      HWY_ASSERT(worker < pool.NumWorkers());
+      ++visits[item];  // Each item is only visited by one worker.
+    });
+    for (uint32_t count : visits) HWY_ASSERT(count == 1);
+  }
+  // Converged, and the result is one of the candidates.
+  const uint64_t best = tuner.Best();
+  HWY_ASSERT(best != 0);
+  HWY_ASSERT(best % 4 == 0 && ((best / 4) & (best / 4 - 1)) == 0);
+  HWY_ASSERT(best <= num_items);
+
+  // Subsequent calls use the best chunk size and do not change it.
+  ParallelFor(pool, 0, num_items, tuner,
+              [&](uint64_t item, size_t /*worker*/) { ++visits[item]; });
+  HWY_ASSERT(tuner.Best() == best);
+  for (uint32_t count : visits) HWY_ASSERT(count == 2);
+}
+
+TEST(ParallelTest, TestParallelReduce) {
+  if (!HaveThreadingSupport()) return;
+
+  const auto add = [](uint64_t a, uint64_t b) { return a + b; };
+  const auto identity = [](uint64_t item) { return item; };
+  const uint64_t sizes[] = {0, 1, 2, 3, 7, 64, 1000, 12345};
+  for (size_t num_threads = 0; num_threads <= 5; ++num_threads) {
+    ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads(), num_threads));
+    for (uint64_t size : sizes) {
+      // Sum of [begin, begin + size).
+      const uint64_t begin = 10;
+      const uint64_t expected = size * begin + size * (size - 1) / 2;
+      HWY_ASSERT(ParallelReduce(pool, begin, begin + size, uint64_t{0},
+                                identity, add) == expected);
+    }
+
+    // Non-commutative: concatenation of digits must preserve the order.
+    const uint64_t digits = ParallelReduce(
+        pool, 1, 10, uint64_t{0}, identity,
+        [](uint64_t a, uint64_t b) {
+          uint64_t pow10 = 1;
+          for (uint64_t x = b; x != 0; x /= 10) pow10 *= 10;
+          return a * pow10 + b;
+        });
+    HWY_ASSERT(digits == 123456789);
+  }
+}
+
+// Floating-point sums are bitwise identical across calls with the same pool.
+TEST(ParallelTest, TestParallelReduceDeterministic) {
+  if (!HaveThreadingSupport()) return;
+
+  const size_t num = 4096;
+  AlignedFreeUniquePtr<float[]> in = AllocateAligned<float>(num);
+  HWY_ASSERT(in);
+  for (size_t i = 0; i < num; ++i) {
+    // Varying magnitudes, so that the rounding depends on the order.
+    in[i] = static_cast<float>(i % 7) * (i % 3 ? 1E-3f : 1E3f) + 0.1f;
+  }
+
+  for (size_t num_threads = 0; num_threads <= 5; ++num_threads) {
+    ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads(), num_threads));
+    const auto load = [&](uint64_t item) { return in[item]; };
+    const auto add = [](float a, float b) { return a + b; };
+    const float scalar = ParallelReduce(pool, 0, num, 0.0f, load, add);
+    const float vector =
+        HWY_DYNAMIC_DISPATCH(SumVectors)(pool, in.get(), num);
+    for (size_t rep = 0; rep < 20; ++rep) {
+      const float scalar2 = ParallelReduce(pool, 0, num, 0.0f, load, add);
+      HWY_ASSERT(BitCastScalar<uint32_t>(scalar) ==
+                 BitCastScalar<uint32_t>(scalar2));
+      const float vector2 =
+          HWY_DYNAMIC_DISPATCH(SumVectors)(pool, in.get(), num);
+      HWY_ASSERT(BitCastScalar<uint32_t>(vector) ==
+                 BitCastScalar<uint32_t>(vector2));
+    }
+    // Different order of additions, but the same value up to rounding.
+    HWY_ASSERT(ScalarAbs(scalar - vector) <= 1E-4f * scalar);
+  }
+}
+
+HWY_BEFORE_TEST(ParallelVectorsTest);
+HWY_EXPORT_AND_TEST_P(ParallelVectorsTest, TestAllParallelReduceVectors);
+HWY_AFTER_TEST();
+
+}  // namespace
+}  // namespace hwy
+
+HWY_TEST_MAIN();
+#endif  // HWY_ONCE
@@ -44,6 +44,15 @@
 #endif
 #endif  // HWY_ENABLE_UMONITOR
 
+#ifndef HWY_ENABLE_WFE  // allow override
+// WFE is part of the base Armv8 ISA, but we require inline assembly.
+#if HWY_ARCH_ARM_A64 && (HWY_COMPILER_CLANG || HWY_COMPILER_GCC)
+#define HWY_ENABLE_WFE 1
+#else
+#define HWY_ENABLE_WFE 0
+#endif
+#endif  // HWY_ENABLE_WFE
+
 // Inline assembly is preferred because it allows inlining of `UntilDifferent`
 // etc, but we also support intrinsics for MSVC.
 #ifndef HWY_ENABLE_SPIN_ASM  // allow override
@@ -77,14 +86,16 @@ struct SpinResult {
   uint32_t reps;
 };
 
-// User-space monitor/wait are supported on Zen2+ AMD and SPR+ Intel. Spin waits
-// are rarely called from SIMD code, hence we do not integrate this into
-// `HWY_TARGET` and its runtime dispatch mechanism. Returned by `Type()`, also
-// used by callers to set the `disabled` argument for `DetectSpin`.
+// User-space monitor/wait are supported on Zen2+ AMD and SPR+ Intel, and the
+// similar WFE on all Armv8. Spin waits are rarely called from SIMD code, hence
+// we do not integrate this into `HWY_TARGET` and its runtime dispatch
+// mechanism. Returned by `Type()`, also used by callers to set the `disabled`
+// argument for `DetectSpin`.
 enum class SpinType : uint8_t {
   kMonitorX = 1,  // AMD
   kUMonitor,      // Intel
   kPause,
+  kWFE,      // Arm. After kPause so that the values of others are unchanged.
   kSentinel  // for iterating over all enumerators. Must be last.
 };
 
@@ -97,6 +108,8 @@ static inline const char* ToString(SpinType type) {
       return "UMonitor_C0.2";
     case SpinType::kPause:
       return "Pause";
+    case SpinType::kWFE:
+      return "WFE";
     case SpinType::kSentinel:
       return nullptr;
     default:
@@ -269,7 +282,51 @@ HWY_POP_ATTRIBUTES
 #endif
 #endif  // HWY_ENABLE_UMONITOR
 
-// TODO(janwas): add WFE on Arm. May wake at 10 kHz, but still worthwhile.
+#if HWY_ENABLE_WFE || HWY_IDE
+
+// Arm's wait-for-event. A load-exclusive arms the 'exclusive monitor', which is
+// cleared when another core writes the cache line, which in turn sends the
+// event that wakes WFE. Hence the waker only has to store, without SEV. WFE
+// also wakes spuriously, e.g. from the 10 kHz event stream that Linux enables,
+// but that is still much less often than Pause. WFET (Armv8.7) would only add
+// a timeout, which we do not require.
+class SpinWFE {
+ public:
+  SpinType Type() const { return SpinType::kWFE; }
+
+  HWY_INLINE SpinResult UntilDifferent(
+      const uint32_t prev, const std::atomic<uint32_t>& watched) const {
+    for (uint32_t reps = 0;; ++reps) {
+      // Checking after arming the monitor avoids missed events: a store after
+      // this load generates an event, so `Wait` returns immediately.
+      const uint32_t current = LoadExclusive(&watched);
+      if (current != prev) return SpinResult{current, reps};
+      Wait();
+    }
+  }
+
+  HWY_INLINE size_t UntilEqual(const uint32_t expected,
+                               const std::atomic<uint32_t>& watched) const {
+    for (size_t reps = 0;; ++reps) {
+      const uint32_t current = LoadExclusive(&watched);
+      if (current == expected) return reps;
+      Wait();
+    }
+  }
+
+ private:
+  // Load-acquire, which also arms the exclusive monitor for `addr`. We do not
+  // clear it afterwards because a dangling reservation is harmless.
+  static HWY_INLINE uint32_t LoadExclusive(const std::atomic<uint32_t>* addr) {
+    uint32_t value;
+    asm volatile("ldaxr %w0, [%1]" : "=r"(value) : "r"(addr) : "memory");
+    return value;
+  }
+
+  static HWY_INLINE void Wait() { asm volatile("wfe" ::: "memory"); }
+};
+
+#endif  // HWY_ENABLE_WFE
 
 // Returns the best-available type whose bit in `disabled` is not set. Example:
 // to disable kUMonitor, pass `1 << static_cast<int>(SpinType::kUMonitor)`.
@@ -296,6 +353,11 @@ static inline SpinType DetectSpin(int disabled = 0) {
   }
 #endif  // HWY_ENABLE_UMONITOR
 
+#if HWY_ENABLE_WFE
+  // Always supported, and the OS allows it in user mode.
+  if (enabled(SpinType::kWFE)) return SpinType::kWFE;
+#endif  // HWY_ENABLE_WFE
+
   if (!enabled(SpinType::kPause)) {
     HWY_WARN("Ignoring attempt to disable Pause, it is the only option left.");
   }
@@ -315,6 +377,11 @@ HWY_INLINE void CallWithSpin(SpinType spin_type, Func&& func) {
     case SpinType::kUMonitor:
       func(SpinUMonitor());
       break;
+#endif
+#if HWY_ENABLE_WFE
+    case SpinType::kWFE:
+      func(SpinWFE());
+      break;
 #endif
     case SpinType::kPause:
     default:
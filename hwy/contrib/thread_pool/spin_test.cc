@@ -110,6 +110,67 @@ TEST(SpinTest, TestPingPong) {
   CallWithSpin(spin_type, TestPingPongT());
 }
 
+// Measures the average wake latency: one thread stores the next epoch, the
+// other waits until it observes that epoch and replies with the same.
+struct TestWakeLatencyT {
+  template <class Spin>
+  void operator()(const Spin& spin) const {
+    alignas(HWY_ALIGNMENT) std::atomic<uint32_t> request{0};
+    alignas(HWY_ALIGNMENT) std::atomic<uint32_t> reply{0};
+    const uint32_t kRoundTrips = static_cast<uint32_t>(AdjustedReps(10000));
+
+    hwy::ThreadPool pool(1);
+    HWY_ASSERT(pool.NumWorkers() == 2);
+    double elapsed = 0.0;
+    std::atomic<size_t> reps{0};
+    std::atomic<uint32_t> num_answered{0};
+    pool.Run(0, 2, [&](uint64_t task, size_t thread) {
+      HWY_ASSERT(task == thread);
+      if (task == 0) {
+        for (uint32_t epoch = 1; epoch <= kRoundTrips; ++epoch) {
+          reps.fetch_add(spin.UntilEqual(epoch, request));
+          num_answered.fetch_add(1);
+          reply.store(epoch, std::memory_order_release);
+        }
+      } else {
+        const double t0 = hwy::platform::Now();
+        for (uint32_t epoch = 1; epoch <= kRoundTrips; ++epoch) {
+          request.store(epoch, std::memory_order_release);
+          reps.fetch_add(spin.UntilEqual(epoch, reply));
+        }
+        elapsed = hwy::platform::Now() - t0;
+      }
+    });
+    // Every request was answered exactly once, in order.
+    HWY_ASSERT(num_answered.load() == kRoundTrips);
+    HWY_ASSERT(request.load() == kRoundTrips && reply.load() == kRoundTrips);
+    HWY_ASSERT(elapsed > 0.0);
+
+    // Two wakes per round trip.
+    fprintf(stderr, "%14s: wake latency %.3f us, reps per wake %.1f\n",
+            ToString(spin.Type()), elapsed * 1E6 / (2.0 * kRoundTrips),
+            static_cast<double>(reps.load()) / (2.0 * kRoundTrips));
+  }
+};
+
+TEST(SpinTest, TestWakeLatency) {
+  if (!HaveThreadingSupport()) {
+    HWY_WARN("Threads not supported, skipping test\n");
+    return;
+  }
+  // Spinning is only meaningful if both threads can run concurrently.
+  if (ThreadPool::MaxThreads() == 0) return;
+
+  // All supported types, in order of preference.
+  int disabled = 0;
+  for (;;) {
+    const SpinType spin_type = DetectSpin(disabled);
+    CallWithSpin(spin_type, TestWakeLatencyT());
+    if (spin_type == SpinType::kPause) break;
+    disabled |= 1 << static_cast<int>(spin_type);
+  }
+}
+
 }  // namespace
 }  // namespace hwy
 
@@ -22,10 +22,13 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>  // snprintf
+#include <stdio.h>  // snprintf, fopen
+#include <string.h>  // strcmp, strstr
 
+#include <algorithm>  // std::remove_if
 #include <array>
 #include <atomic>
+#include <mutex>  // NOLINT
 #include <string>
 #include <thread>  // NOLINT
 #include <vector>
@@ -34,6 +37,11 @@
 #if HWY_OS_FREEBSD
 #include <pthread_np.h>
 #endif
+#if HWY_OS_WIN
+#include <process.h>  // _getpid
+#else
+#include <unistd.h>  // getpid
+#endif
 
 #include "hwy/aligned_allocator.h"  // HWY_ALIGNMENT
 #include "hwy/auto_tune.h"
@@ -49,6 +57,14 @@
 // Define to HWY_NOINLINE to see profiles of `WorkerRun*` and waits.
 #define HWY_POOL_PROFILE
 
+// If nonzero, `ThreadPool::Run` measures per-worker busy time, task and steal
+// counts, plus wake and barrier latency, and aggregates them per call site.
+// See `ThreadPool::PrintRunStats`. If zero (the default), this is compiled out.
+// Must be the same for all translation units because it changes `Worker`.
+#ifndef HWY_POOL_INSTRUMENT
+#define HWY_POOL_INSTRUMENT 0
+#endif
+
 namespace hwy {
 
 // Sets the name of the current thread to the format string `format`, which must
@@ -73,6 +89,17 @@ static inline void SetThreadName(const char* format, int thread) {
 // Whether workers should block or spin.
 enum class PoolWaitMode : uint8_t { kBlock = 1, kSpin };
 
+// Whether a pool pinned via `PoolPinning` may share logical processors with
+// other pools in the same process, see `pool::Arbiter`.
+enum class PoolLease : uint8_t {
+  // Pins to the LPs given by `PinningOrder`, regardless of other pools.
+  kShared,
+  // Pins only to LPs not leased by other pools, and reduces the number of
+  // threads accordingly. Avoids oversubscription when independent components
+  // each create a pool.
+  kExclusive,
+};
+
 namespace pool {
 
 #ifndef HWY_POOL_VERBOSITY
@@ -278,10 +305,26 @@ class Config {  // 8 bytes
   WaitType wait_type;
   BarrierType barrier_type;
   bool exit;
-  uint32_t reserved = 0;
+  // Set by `ThreadPool::SendConfig`, not auto-tuned: whether idle workers
+  // block instead of spinning while another arbitrated pool is in `Run`.
+  bool arbitrated = false;
+  uint8_t reserved[3] = {0, 0, 0};
 };
 static_assert(sizeof(Config) == 8, "");
 
+#if HWY_POOL_INSTRUMENT
+// Measurements of one worker during one `Run`, in timer ticks. Written by the
+// worker, reset and read by the main thread while the worker is waiting.
+struct WorkerStats {
+  uint64_t t_begin;  // after waking
+  uint64_t t_end;    // after finishing its tasks
+  uint64_t busy;     // sum of task durations
+  uint64_t tasks;
+  uint64_t steals;  // tasks from the range of another worker
+};
+static_assert(sizeof(WorkerStats) == 40, "");
+#endif  // HWY_POOL_INSTRUMENT
+
 // Per-worker state used by both main and worker threads. `ThreadFunc`
 // (threads) and `ThreadPool` (main) have a few additional members of their own.
 class alignas(HWY_ALIGNMENT) Worker {  // HWY_ALIGNMENT bytes
@@ -363,12 +406,60 @@ class alignas(HWY_ALIGNMENT) Worker {  // HWY_ALIGNMENT bytes
   std::atomic<uint32_t>& MutableWaiter() { return wait_epoch_; }  // futex
   void StoreWaiter(uint32_t epoch) { wait_epoch_.store(epoch, kRel); }
 
+  // Only used in the main thread's `Worker`: number of threads that are
+  // blocked in a spinning `Wait*` because another pool is active.
+  std::atomic<uint32_t>& NumBlocked() const { return num_blocked_; }
+
   // ------------------------ Barrier: Main thread waits for workers
 
   const std::atomic<uint32_t>& Barrier() const { return barrier_epoch_; }
   std::atomic<uint32_t>& MutableBarrier() { return barrier_epoch_; }
   void StoreBarrier(uint32_t epoch) { barrier_epoch_.store(epoch, kRel); }
 
+  // ------------------------ Instrumentation: no-ops unless HWY_POOL_INSTRUMENT
+
+#if HWY_POOL_INSTRUMENT
+  const WorkerStats& Stats() const { return stats_; }
+#endif
+
+  // Called by the main thread before waking the workers.
+  void ResetStats() {
+#if HWY_POOL_INSTRUMENT
+    stats_ = WorkerStats();
+#endif
+  }
+
+  // Called by the worker before and after running its tasks.
+  void BeginRun() {
+#if HWY_POOL_INSTRUMENT
+    stats_.t_begin = timer::Start();
+#endif
+  }
+  void EndRun() {
+#if HWY_POOL_INSTRUMENT
+    stats_.t_end = timer::Start();
+#endif
+  }
+
+  // Returns the timestamp to pass to `EndTask`.
+  uint64_t BeginTask() const {
+#if HWY_POOL_INSTRUMENT
+    return timer::Start();
+#else
+    return 0;
+#endif
+  }
+  void EndTask(uint64_t t0, bool stolen) {
+#if HWY_POOL_INSTRUMENT
+    stats_.busy += timer::Start() - t0;
+    stats_.tasks += 1;
+    stats_.steals += stolen ? 1 : 0;
+#else
+    (void)t0;
+    (void)stolen;
+#endif
+  }
+
  private:
   // Atomics first because arm7 clang otherwise makes them unaligned.
 
@@ -379,6 +470,8 @@ class alignas(HWY_ALIGNMENT) Worker {  // HWY_ALIGNMENT bytes
   // Use u32 to match futex.h.
   alignas(4) std::atomic<uint32_t> wait_epoch_{0};
   alignas(4) std::atomic<uint32_t> barrier_epoch_{0};  // is reset
+  // Mutable because waiters only have a const `Worker*`.
+  alignas(4) mutable std::atomic<uint32_t> num_blocked_{0};
 
   uint32_t num_victims_;  // <= kPoolMaxVictims
   std::array<uint32_t, kMaxVictims> victims_;
@@ -390,7 +483,12 @@ class alignas(HWY_ALIGNMENT) Worker {  // HWY_ALIGNMENT bytes
   const size_t num_threads_;
   Worker* const workers_;
 
+#if HWY_POOL_INSTRUMENT
+  WorkerStats stats_;
+  uint8_t padding_[HWY_ALIGNMENT - 64 - sizeof(victims_) - sizeof(stats_)];
+#else
   uint8_t padding_[HWY_ALIGNMENT - 64 - sizeof(victims_)];
+#endif
 };
 static_assert(sizeof(Worker) == HWY_ALIGNMENT, "");
 
@@ -453,6 +551,16 @@ class alignas(8) Tasks {
     end_.store(end, kRel);
     func_.store(static_cast<RunFunc>(&CallClosure<Closure>), kRel);
     opaque_.store(reinterpret_cast<const void*>(&closure), kRel);
+    skip_main_.store(0, kRel);
+  }
+
+  // As `Set`, but for `ThreadPool::RunAsync`, in which the main thread (worker
+  // 0) does not run tasks. If there is more than one task per thread, the
+  // caller must also call `DivideRangeAmongThreads`.
+  template <class Closure>
+  void SetAsync(uint64_t begin, uint64_t end, const Closure& closure) {
+    Set(begin, end, closure);
+    skip_main_.store(1, std::memory_order_release);
   }
 
   // Assigns workers their share of `[begin, end)`. Called from the main
@@ -481,28 +589,53 @@ class alignas(8) Tasks {
     HWY_DASSERT(my_begin == end);
   }
 
+  // As `DivideRangeAmongWorkers`, but for `SetAsync`: the main thread's range
+  // is empty, so that only the threads run tasks.
+  static void DivideRangeAmongThreads(const uint64_t begin, const uint64_t end,
+                                      const size_t num_threads,
+                                      Worker* workers) {
+    HWY_DASSERT(num_threads != 0);
+    HWY_DASSERT(begin <= end);
+    const uint64_t num_tasks = end - begin;
+    const uint64_t min_tasks = num_tasks / num_threads;
+    const uint64_t remainder = num_tasks % num_threads;
+
+    workers[0].SetRange(begin, begin);
+    uint64_t my_begin = begin;
+    for (size_t thread = 0; thread < num_threads; ++thread) {
+      const uint64_t my_end = my_begin + min_tasks + (thread < remainder);
+      workers[1 + thread].SetRange(my_begin, my_end);
+      my_begin = my_end;
+    }
+    HWY_DASSERT(my_begin == end);
+  }
+
   // Runs the worker's assigned range of tasks, plus work stealing if needed.
   HWY_POOL_PROFILE void WorkerRun(Worker* worker) const {
-    if (NumTasks() > worker->NumThreads() + 1) {
+    const size_t skip_main = SkipMain();
+    if (NumTasks() > worker->NumThreads() + 1 - skip_main) {
       WorkerRunWithStealing(worker);
     } else {
-      WorkerRunSingle(worker->Index());
+      WorkerRunSingle(worker, skip_main);
     }
   }
 
  private:
   // Special case for <= 1 task per worker, where stealing is unnecessary.
-  void WorkerRunSingle(size_t worker) const {
+  void WorkerRunSingle(Worker* worker, size_t skip_main) const {
     const uint64_t begin = begin_.load(kAcq);
     const uint64_t end = end_.load(kAcq);
     HWY_DASSERT(begin <= end);
+    HWY_DASSERT(worker->Index() >= skip_main);
 
-    const uint64_t task = begin + worker;
+    const uint64_t task = begin + worker->Index() - skip_main;
     // We might still have more workers than tasks, so check first.
     if (HWY_LIKELY(task < end)) {
       const void* opaque = Opaque();
       const RunFunc func = Func();
-      func(opaque, task, worker);
+      const uint64_t t0 = worker->BeginTask();
+      func(opaque, task, worker->Index());
+      worker->EndTask(t0, /*stolen=*/false);
     }
   }
 
@@ -542,7 +675,9 @@ class alignas(8) Tasks {
         }
         // Pass the index we are actually running on; this is important
         // because it is the TLS index for user code.
+        const uint64_t t0 = worker->BeginTask();
         func(opaque, task, index);
+        worker->EndTask(t0, /*stolen=*/victim != index);
       }
     }
   }
@@ -553,6 +688,7 @@ class alignas(8) Tasks {
 
   const void* Opaque() const { return opaque_.load(kAcq); }
   RunFunc Func() const { return func_.load(kAcq); }
+  size_t SkipMain() const { return static_cast<size_t>(skip_main_.load(kAcq)); }
 
   // Calls closure(task, worker). Signature must match `RunFunc`.
   template <class Closure>
@@ -564,10 +700,67 @@ class alignas(8) Tasks {
   std::atomic<uint64_t> end_;
   std::atomic<RunFunc> func_;
   std::atomic<const void*> opaque_;
+  // 1 if only threads run tasks, see `SetAsync`. Only the main thread calls
+  // `WorkerRun` with `worker->Index() == 0`, hence the subtraction is safe.
+  std::atomic<uint64_t> skip_main_;
 };
-static_assert(sizeof(Tasks) == 16 + 2 * sizeof(void*), "");
+static_assert(sizeof(Tasks) == 24 + 2 * sizeof(void*), "");
 #pragma pack(pop)
 
+// Process-wide registry through which pools that coexist in the same process
+// avoid oversubscribing cores: they can lease disjoint sets of logical
+// processors (LPs), and arbitrated pools (see `ThreadPool::SetArbitrated`)
+// do not spin while another is in `Run`. Thread-safe.
+class Arbiter {
+ public:
+  static Arbiter& Get() {
+    static Arbiter arbiter;
+    return arbiter;
+  }
+
+  // Returns up to `max_lps` of the LPs in `order` which are not currently
+  // leased, in that order, and marks them as leased.
+  std::vector<size_t> Lease(const std::vector<size_t>& order, size_t max_lps) {
+    std::vector<size_t> lps;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const size_t lp : order) {
+      if (lps.size() == max_lps) break;
+      if (lp >= kMaxLogicalProcessors || leased_.Get(lp)) continue;
+      leased_.Set(lp);
+      lps.push_back(lp);
+    }
+    return lps;
+  }
+
+  // Returns LPs from a prior `Lease` so they can be leased again.
+  void Release(const std::vector<size_t>& lps) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const size_t lp : lps) {
+      HWY_DASSERT(leased_.Get(lp));
+      leased_.Clear(lp);
+    }
+  }
+
+  // Called by pools that opted in via `ThreadPool::SetArbitrated` when they
+  // begin a `Run`. Returns how many other such pools are currently in `Run`.
+  uint32_t BeginRun() {
+    return num_running_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  // Called at the end of each `Run` that called `BeginRun`.
+  void EndRun() { num_running_.fetch_sub(1, std::memory_order_acq_rel); }
+
+  // Whether any arbitrated pool is in `Run`. Polled by idle workers of
+  // arbitrated pools, see `SpinOrBlockUntil`.
+  bool AnyRunning() const {
+    return num_running_.load(std::memory_order_relaxed) != 0;
+  }
+
+ private:
+  std::mutex mutex_;
+  LogicalProcessorSet leased_;  // protected by `mutex_`
+  std::atomic<uint32_t> num_running_{0};
+};
+
 // ------------------------------ Threads wait, main wakes them
 
 // Considerations:
@@ -590,6 +783,53 @@ static_assert(sizeof(Tasks) == 16 + 2 * sizeof(void*), "");
 // All methods are const because they only use storage in `Worker`, and we
 // prefer to pass const-references to empty classes to enable type deduction.
 
+// Spins until `waiter == epoch`. However, if the pool is arbitrated (see
+// `ThreadPool::SetArbitrated`) and another arbitrated pool is in `Run`, instead
+// blocks so that the other pool's threads can use this core.
+template <class Spin>
+void SpinOrBlockUntil(const Worker* worker, const Spin& spin,
+                      const uint32_t epoch,
+                      const std::atomic<uint32_t>& waiter) {
+  if (HWY_LIKELY(!worker->LatchedConfig().arbitrated)) {
+    (void)spin.UntilEqual(epoch, waiter);
+    // TODO: store reps in stats.
+    return;
+  }
+
+  // Polling `Arbiter` in every iteration would add a load of a shared line.
+  constexpr size_t kCheckInterval = 64;
+  const Arbiter& arbiter = Arbiter::Get();
+  for (size_t reps = 0;; ++reps) {
+    if (waiter.load(std::memory_order_acquire) == epoch) return;
+    if (reps % kCheckInterval == 0 && arbiter.AnyRunning()) break;
+    hwy::Pause();
+  }
+
+  // Pairs with the read-modify-write in `WakeBlocked`: if ours is ordered
+  // after it, we observe the main thread's store of `epoch` and do not block,
+  // otherwise the main thread sees our increment and wakes us.
+  std::atomic<uint32_t>& num_blocked = worker->AllWorkers()[0].NumBlocked();
+  num_blocked.fetch_add(1, std::memory_order_acq_rel);
+  // The main thread only increments the epoch after all workers have reached
+  // the barrier, hence `waiter` is either `epoch - 1` or `epoch`.
+  BlockUntilDifferent(epoch - 1, waiter);
+  num_blocked.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// Called by the main thread after storing the epoch(s) for spinning waiters.
+// Only arbitrated pools pay for an atomic read-modify-write, and the futex
+// wake is only required if a worker blocked in `SpinOrBlockUntil`.
+static inline void WakeBlocked(Worker* workers, size_t num_waiters) {
+  if (HWY_LIKELY(!workers[0].LatchedConfig().arbitrated)) return;
+  // Read-modify-write instead of a load, see `SpinOrBlockUntil`.
+  if (workers[0].NumBlocked().fetch_add(0, std::memory_order_acq_rel) == 0) {
+    return;
+  }
+  for (size_t i = 0; i < num_waiters; ++i) {
+    WakeAll(workers[1 + i].MutableWaiter());  // futex: expensive syscall
+  }
+}
+
 // Futex: blocking reduces apparent CPU usage, but has higher wake latency.
 struct WaitBlock {
   WaitType Type() const { return WaitType::kBlock; }
@@ -619,6 +859,7 @@ struct WaitSpin1 {
 
   void WakeWorkers(Worker* workers, const uint32_t epoch) const {
     workers[1].StoreWaiter(epoch);
+    WakeBlocked(workers, 1);
   }
 
   template <class Spin>
@@ -626,8 +867,7 @@ struct WaitSpin1 {
                   const uint32_t epoch) const {
     HWY_DASSERT(worker->Index() != 0);  // main is 0
     const Worker* workers = worker->AllWorkers();
-    (void)spin.UntilEqual(epoch, workers[1].Waiter());
-    // TODO: store reps in stats.
+    SpinOrBlockUntil(worker, spin, epoch, workers[1].Waiter());
   }
 };
 
@@ -640,14 +880,14 @@ struct WaitSpinSeparate {
     for (size_t thread = 0; thread < workers->NumThreads(); ++thread) {
       workers[1 + thread].StoreWaiter(epoch);
     }
+    WakeBlocked(workers, workers->NumThreads());
   }
 
   template <class Spin>
   void UntilWoken(const Worker* worker, const Spin& spin,
                   const uint32_t epoch) const {
     HWY_DASSERT(worker->Index() != 0);  // main is 0
-    (void)spin.UntilEqual(epoch, worker->Waiter());
-    // TODO: store reps in stats.
+    SpinOrBlockUntil(worker, spin, epoch, worker->Waiter());
   }
 };
 
@@ -710,6 +950,17 @@ class BarrierCounter {
       }
     }
   }
+
+  // Non-blocking version of `UntilReached`, for `ThreadPool::RunAsync`.
+  bool IsReached(size_t num_threads, const Worker* workers,
+                 uint32_t /*epoch*/) const {
+    const auto kAcq = std::memory_order_acquire;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < kShards; ++i) {
+      sum += workers[kMaxThreads - i].Barrier().load(kAcq);
+    }
+    return sum == num_threads;
+  }
 };
 
 // As with the wait, a store-release of the same local epoch counter serves as a
@@ -735,6 +986,15 @@ class BarrierOrdered {
       (void)spin.UntilEqual(epoch, workers[1 + i].Barrier());
     }
   }
+
+  bool IsReached(size_t num_threads, const Worker* workers,
+                 uint32_t epoch) const {
+    for (size_t i = 0; i < num_threads; ++i) {
+      const auto kAcq = std::memory_order_acquire;
+      if (workers[1 + i].Barrier().load(kAcq) != epoch) return false;
+    }
+    return true;
+  }
 };
 
 // Leader threads wait for others in the group, main thread loops over leaders.
@@ -777,6 +1037,15 @@ class BarrierGroup {
       (void)spin.UntilEqual(epoch, workers[1 + i].Barrier());
     }
   }
+
+  bool IsReached(size_t num_threads, const Worker* workers,
+                 uint32_t epoch) const {
+    for (size_t i = 0; i < num_threads; i += kGroupSize) {
+      const auto kAcq = std::memory_order_acquire;
+      if (workers[1 + i].Barrier().load(kAcq) != epoch) return false;
+    }
+    return true;
+  }
 };
 
 // ------------------------------ Inlining policy classes
@@ -915,7 +1184,9 @@ class MainAdapter {
     // them at the barrier below.
 
     // Also perform work on the main thread before the barrier.
+    main_->BeginRun();
     tasks_->WorkerRun(main_);
+    main_->EndRun();
 
     // Waits until all *threads* (not the main thread, because it already knows
     // it is here) called `WorkerReached`. All `barrier` types use spinning.
@@ -932,6 +1203,47 @@ class MainAdapter {
   uint32_t epoch_;
 };
 
+// For `ThreadPool::RunAsync`, which splits the work of `MainAdapter` into
+// three steps, and the main thread does not run tasks.
+class AsyncAdapter {
+ public:
+  enum class Step { kStart, kPoll, kFinish };
+
+  AsyncAdapter(Worker* main, Step step, uint32_t epoch)
+      : main_(main), step_(step), epoch_(epoch) {
+    HWY_DASSERT(main_ == main->AllWorkers());  // main is first.
+  }
+
+  // Only valid after `kPoll` or `kFinish`.
+  bool Reached() const { return reached_; }
+
+  template <class Spin, class Wait, class Barrier>
+  HWY_POOL_PROFILE void operator()(const Spin& spin, const Wait& wait,
+                                   const Barrier& barrier) {
+    Worker* workers = main_->AllWorkers();
+    const size_t num_threads = main_->NumThreads();
+    switch (step_) {
+      case Step::kStart:
+        barrier.Reset(workers);
+        wait.WakeWorkers(workers, epoch_);
+        break;
+      case Step::kPoll:
+        reached_ = barrier.IsReached(num_threads, workers, epoch_);
+        break;
+      case Step::kFinish:
+        barrier.UntilReached(num_threads, workers, spin, epoch_);
+        reached_ = true;
+        break;
+    }
+  }
+
+ private:
+  Worker* const main_;
+  const Step step_;
+  const uint32_t epoch_;
+  bool reached_ = false;
+};
+
 class WorkerAdapter {
  public:
   explicit WorkerAdapter(Worker* worker) : worker_(worker) {}
@@ -1006,7 +1318,9 @@ class ThreadFunc {
       // Must happen before `WorkerRun` because `SendConfig` writes it there.
       config_ = worker_->LatchedConfig();
 
+      worker_->BeginRun();
       tasks_->WorkerRun(worker_);
+      worker_->EndRun();
 
       // Notify barrier after `WorkerRun`.
       CallWithSpinBarrier(config_, worker_adapter_);
@@ -1024,6 +1338,240 @@ class ThreadFunc {
   WorkerAdapter worker_adapter_;
 };
 
+#if HWY_POOL_INSTRUMENT
+
+// Aggregates `WorkerStats` of all `ThreadPool::Run` with the same call site.
+class RunSiteStats {
+  static uint64_t ClampedSubtract(uint64_t minuend, uint64_t subtrahend) {
+    return minuend > subtrahend ? minuend - subtrahend : 0;
+  }
+
+ public:
+  // `t_wake` is when the main thread began waking the workers, and `t_done`
+  // when all reached the barrier.
+  void Notify(const Worker* workers, size_t num_workers, uint64_t t_wake,
+              uint64_t t_done) {
+    uint64_t sum_busy = 0;
+    uint64_t max_busy = 0;
+    size_t active = 0;
+    for (size_t i = 0; i < num_workers; ++i) {
+      const WorkerStats& stats = workers[i].Stats();
+      sum_busy += stats.busy;
+      max_busy = HWY_MAX(max_busy, stats.busy);
+      active += stats.tasks != 0;
+      tasks_ += stats.tasks;
+      steals_ += stats.steals;
+      // The main thread (worker 0) does not need to be woken.
+      if (i != 0) wake_ += ClampedSubtract(stats.t_begin, t_wake);
+      barrier_ += ClampedSubtract(t_done, stats.t_end);
+    }
+
+    ++runs_;
+    worker_runs_ += num_workers;
+    elapsed_ += t_done - t_wake;
+    busy_ += sum_busy;
+    max_busy_ += max_busy;
+    active_.Notify(static_cast<float>(active));
+    // 1 if perfectly balanced, `num_workers` if one worker did everything.
+    if (sum_busy != 0) {
+      imbalance_.Notify(static_cast<float>(
+          static_cast<double>(max_busy) * static_cast<double>(num_workers) /
+          static_cast<double>(sum_busy)));
+    }
+  }
+
+  // Fork-join overhead is the elapsed time minus that of the slowest worker.
+  // Times are in microseconds per `Run`, except wake/barrier per worker.
+  void Print(const char* name, size_t name_len, double us_per_tick) const {
+    if (runs_ == 0) return;
+    const double per_run = us_per_tick / static_cast<double>(runs_);
+    const double per_worker = us_per_tick / static_cast<double>(worker_runs_);
+    const double tasks = static_cast<double>(tasks_);
+    const bool any_busy = imbalance_.Count() != 0;
+    printf(
+        "%-40.*s: %8zu x %9.2f us, overhead %8.2f, busy %8.2f | tasks %8.1f "
+        "steals %5.1f%% | wake %7.2f barrier %7.2f | active %5.1f "
+        "imbalance %5.2f [%5.2f]\n",
+        static_cast<int>(name_len), name, static_cast<size_t>(runs_),
+        static_cast<double>(elapsed_) * per_run,
+        static_cast<double>(ClampedSubtract(elapsed_, max_busy_)) * per_run,
+        static_cast<double>(busy_) * per_run,
+        tasks / static_cast<double>(runs_),
+        tasks_ == 0 ? 0.0 : 100.0 * static_cast<double>(steals_) / tasks,
+        static_cast<double>(wake_) * per_worker,
+        static_cast<double>(barrier_) * per_worker, active_.Mean(),
+        any_busy ? imbalance_.Mean() : 1.0, any_busy ? imbalance_.Max() : 1.0);
+  }
+
+  uint64_t Runs() const { return runs_; }
+  uint64_t Tasks() const { return tasks_; }
+  uint64_t Steals() const { return steals_; }
+
+ private:
+  uint64_t runs_ = 0;
+  uint64_t worker_runs_ = 0;  // sum of `num_workers` over all runs
+  uint64_t elapsed_ = 0;
+  uint64_t busy_ = 0;
+  uint64_t max_busy_ = 0;  // sum over runs of the busiest worker
+  uint64_t tasks_ = 0;
+  uint64_t steals_ = 0;
+  uint64_t wake_ = 0;
+  uint64_t barrier_ = 0;
+  Stats active_;     // workers that ran at least one task
+  Stats imbalance_;  // busiest worker relative to the average
+};
+
+// Process-wide `RunSiteStats` for all pools, indexed by call site.
+class RunStats {
+  static constexpr size_t kMaxSites = 64;
+
+ public:
+  static RunStats& Get() {
+    static RunStats run_stats;
+    return run_stats;
+  }
+
+  // `name` is from `HWY_FUNCTION` in `ThreadPool::Run`, which includes the
+  // closure type and thus identifies the call site. It must outlive this.
+  // Called once per site, possibly concurrently.
+  size_t AddSite(const char* name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (HWY_UNLIKELY(num_sites_ == kMaxSites)) {
+      HWY_WARN("ThreadPool: more than %zu call sites, merging.", kMaxSites);
+      return kMaxSites - 1;
+    }
+    names_[num_sites_] = name;
+    return num_sites_++;
+  }
+
+  // Called by the main thread of any pool after the barrier.
+  void Notify(size_t site, const Worker* workers, size_t num_workers,
+              uint64_t t_wake, uint64_t t_done) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sites_[site].Notify(workers, num_workers, t_wake, t_done);
+  }
+
+  // Calls `func(name, const RunSiteStats&)` for each site, e.g. for tests.
+  template <class Func>
+  void Foreach(const Func& func) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t site = 0; site < num_sites_; ++site) {
+      func(names_[site], sites_[site]);
+    }
+  }
+
+  // Prints one line per site and resets.
+  void Print() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double us_per_tick = 1E6 / platform::InvariantTicksPerSecond();
+    for (size_t site = 0; site < num_sites_; ++site) {
+      // Shorten to the closure type if possible, which is followed by either
+      // ';' (GCC) or ']' (Clang).
+      const char* name = names_[site];
+      size_t len = strlen(name);
+      const char* closure = strstr(name, "Closure = ");
+      if (closure) {
+        name = closure + 10;
+        const char* end = strchr(name, ';');
+        if (!end) end = strrchr(name, ']');
+        len = end ? static_cast<size_t>(end - name) : strlen(name);
+      }
+      sites_[site].Print(name, len, us_per_tick);
+      sites_[site] = RunSiteStats();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  size_t num_sites_ = 0;
+  const char* names_[kMaxSites];
+  RunSiteStats sites_[kMaxSites];
+};
+
+#endif  // HWY_POOL_INSTRUMENT
+
+// Result of a completed auto-tuning, persisted across processes by
+// `ThreadPool::SaveAutoTune`. Only valid for the same CPU, number of threads
+// and wait mode. Stored as raw bytes, hence also for the same layout. Only
+// contains plain values, which `LoadAutoTune` validates, because the file may
+// be corrupt or truncated.
+struct TunedConfig {
+  static constexpr uint32_t kMagic = 0x4C4F4F50;  // "POOL"
+  // Increment whenever the layout or `Config` change meaning.
+  static constexpr uint32_t kVersion = 2;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t num_threads;
+  uint32_t wait_mode;
+  char cpu[112];  // from `GetCpuString`
+  Config config;
+  double cost;  // `CostDistribution::EstimateCost` of `config`
+};
+static_assert(sizeof(TunedConfig) == 144, "Increment kVersion");
+
+// Returns the records in the file at `path` with the expected magic and
+// version, or an empty vector if the file does not exist.
+static inline std::vector<TunedConfig> ReadTunedConfigs(const char* path) {
+  std::vector<TunedConfig> records;
+  HWY_DIAGNOSTICS(push)
+#if HWY_COMPILER_MSVC || HWY_COMPILER_CLANGCL
+  HWY_DIAGNOSTICS_OFF(disable : 4996, ignored "-Wdeprecated-declarations")
+#endif
+  FILE* file = fopen(path, "rb");
+  HWY_DIAGNOSTICS(pop)
+  if (!file) return records;
+  TunedConfig record;
+  while (fread(&record, sizeof(record), 1, file) == 1) {
+    if (record.magic == TunedConfig::kMagic &&
+        record.version == TunedConfig::kVersion) {
+      records.push_back(record);
+    }
+  }
+  fclose(file);
+  return records;
+}
+
+// Replaces the file at `path` with `records`. Writes to a temporary file first
+// so that concurrent readers see either the old or new contents. Its name is
+// unique per process and call, so that concurrent writers do not interleave.
+static inline bool WriteTunedConfigs(const char* path,
+                                     const std::vector<TunedConfig>& records) {
+  static std::atomic<uint32_t> num_calls{0};
+#if HWY_OS_WIN
+  const int pid = _getpid();
+#else
+  const int pid = static_cast<int>(getpid());
+#endif
+  const std::string temp = std::string(path) + "." + std::to_string(pid) +
+                           "." + std::to_string(num_calls.fetch_add(1)) +
+                           ".tmp";
+  HWY_DIAGNOSTICS(push)
+#if HWY_COMPILER_MSVC || HWY_COMPILER_CLANGCL
+  HWY_DIAGNOSTICS_OFF(disable : 4996, ignored "-Wdeprecated-declarations")
+#endif
+  FILE* file = fopen(temp.c_str(), "wb");
+  HWY_DIAGNOSTICS(pop)
+  if (!file) return false;
+  const bool wrote = fwrite(records.data(), sizeof(TunedConfig),
+                            records.size(), file) == records.size();
+  if (fclose(file) != 0 || !wrote) {
+    remove(temp.c_str());
+    return false;
+  }
+  if (rename(temp.c_str(), path) != 0) {
+#if HWY_OS_WIN
+    // Windows does not replace existing files.
+    remove(path);
+    if (rename(temp.c_str(), path) == 0) return true;
+#endif
+    // Keep the existing file, e.g. if the directory is not writable.
+    remove(temp.c_str());
+    return false;
+  }
+  return true;
+}
+
 }  // namespace pool
 
 // Highly efficient parallel-for, intended for workloads with thousands of
@@ -1089,8 +1637,48 @@ class alignas(HWY_ALIGNMENT) ThreadPool {
     // relative order of wake and wait.
   }
 
+  // As above, but also pins the calling (main) thread and each worker to the
+  // logical processors returned by `PinningOrder(topology, pinning)`, where
+  // `worker` of `Run` is pinned to the `worker`-th entry. Workers beyond the
+  // number of entries are not pinned. Note that the main thread remains pinned
+  // after the pool is destroyed.
+  //
+  // If `lease` is `kExclusive`, the pool instead leases `1 + num_threads` of
+  // these LPs from `pool::Arbiter`, skipping those already leased by other
+  // pools, and only spawns as many threads as it could lease LPs. The LP
+  // reserved for the main thread is then not pinned because the thread calling
+  // `Run` need not be the one that constructed the pool. LPs are returned to
+  // the arbiter by the destructor. If `pinning` is `kNone` or `topology` is
+  // unknown, there is nothing to lease, and this behaves like `kShared`.
+  ThreadPool(size_t num_threads, const Topology& topology, PoolPinning pinning,
+             PoolLease lease = PoolLease::kShared)
+      : ThreadPool(num_threads, LeaseOrOrder(PinningOrder(topology, pinning),
+                                             num_threads, lease)) {}
+
+  // As the first constructor, but skips auto-tuning if `LoadAutoTune` finds
+  // results for this CPU and number of threads in the file at `autotune_path`,
+  // and the destructor adds any newly completed results to that file. This
+  // avoids re-tuning in each short-lived process.
+  ThreadPool(size_t num_threads, const char* autotune_path)
+      : ThreadPool(num_threads) {
+    autotune_path_ = autotune_path;
+    (void)LoadAutoTune(autotune_path);
+  }
+
   // Waits for all threads to exit.
   ~ThreadPool() {
+    if (!autotune_path_.empty()) {
+      bool any_new = false;
+      for (PoolWaitMode mode : {PoolWaitMode::kSpin, PoolWaitMode::kBlock}) {
+        any_new |= auto_tune_[static_cast<size_t>(mode) - 1].Best() &&
+                   !(restored_modes_ & (1u << static_cast<size_t>(mode)));
+      }
+      if (any_new && !SaveAutoTune(autotune_path_.c_str())) {
+        HWY_WARN("Failed to save auto-tuning results to %s.",
+                 autotune_path_.c_str());
+      }
+    }
+
     // There is no portable way to request threads to exit like `ExitThread` on
     // Windows, otherwise we could call that from `Run`. Instead, we must cause
     // the thread to wake up and exit. We can use the same `SendConfig`
@@ -1105,6 +1693,7 @@ class alignas(HWY_ALIGNMENT) ThreadPool {
     }
 
     pool::WorkerLifecycle::Destroy(workers_, num_threads_);
+    if (!leased_lps_.empty()) pool::Arbiter::Get().Release(leased_lps_);
   }
 
   ThreadPool(const ThreadPool&) = delete;
@@ -1122,16 +1711,115 @@ class alignas(HWY_ALIGNMENT) ThreadPool {
   // concurrently with any `Run`, because this uses the same waiter/barrier.
   void SetWaitMode(PoolWaitMode mode) {
     wait_mode_ = mode;
-    SendConfig(AutoTuneComplete() ? *AutoTuner().Best()
-                                  : AutoTuner().NextConfig());
+    SendConfig(NextConfig());
+  }
+
+  // Opt-in for pools whose threads share logical processors with other pools,
+  // to avoid oversubscribing cores: arbitrated pools count as active while in
+  // `Run`. If another arbitrated pool is active when this one begins a `Run`,
+  // its workers block instead of spinning during and after that `Run`, until
+  // a later `Run` finds no other pool active. Idle workers also periodically
+  // check whether another arbitrated pool is active, and if so, block until
+  // woken. Only has an effect in `kSpin` mode, in which it costs two atomic
+  // read-modify-writes per `Run`. Auto-tuning pauses while backed off. Not
+  // required for pools constructed with `kExclusive`. Must not be called
+  // concurrently with `Run`.
+  void SetArbitrated(bool arbitrated) {
+    arbitrated_ = arbitrated;
+    SendConfig(NextConfig());
   }
 
   // For printing which are in use.
   pool::Config config() const { return config_; }
 
+  // How many idle workers are blocked because another arbitrated pool is in
+  // `Run`, see `SetArbitrated`. Used in tests.
+  size_t NumBlockedWorkers() const {
+    return workers_[0].NumBlocked().load(std::memory_order_acquire);
+  }
+
   bool AutoTuneComplete() const { return AutoTuner().Best(); }
   Span<CostDistribution> AutoTuneCosts() { return AutoTuner().Costs(); }
 
+  // Restores results of `SaveAutoTune` from the file at `path`, for each wait
+  // mode with a record matching this CPU (see `GetCpuString`) and number of
+  // threads. Records are ignored if their config is no longer a candidate, or
+  // their cost is invalid, in which case auto-tuning proceeds as usual. Returns
+  // whether any were restored. Must not be called concurrently with `Run`.
+  bool LoadAutoTune(const char* path) {
+    char cpu[100];
+    if (!platform::GetCpuString(cpu)) return false;
+
+    const PoolWaitMode prev_mode = wait_mode_;
+    bool any = false;
+    for (const pool::TunedConfig& record : pool::ReadTunedConfigs(path)) {
+      if (!IsRecordForThisPool(record, cpu)) continue;
+      wait_mode_ = static_cast<PoolWaitMode>(record.wait_mode);  // AutoTuner
+      AutoTuneT& auto_tuner = AutoTuner();
+      if (auto_tuner.Best()) continue;  // Already tuned or restored.
+
+      const Span<const pool::Config> candidates = auto_tuner.Candidates();
+      size_t idx = 0;
+      while (idx < candidates.size() &&
+             !IsSameConfig(candidates[idx], record.config)) {
+        ++idx;
+      }
+      if (idx == candidates.size()) continue;  // Stale.
+      // Also false for NaN.
+      if (!(record.cost > 0.0 && record.cost < HighestValue<double>())) {
+        continue;
+      }
+
+      CostDistribution cost;
+      cost.Notify(record.cost);
+      auto_tuner.SetBest(idx, cost);
+      restored_modes_ |= 1u << record.wait_mode;
+      any = true;
+    }
+    wait_mode_ = prev_mode;
+
+    if (AutoTuneComplete()) SendConfig(NextConfig());
+    return any;
+  }
+
+  // Adds the results of each completed auto-tuning to the file at `path`,
+  // replacing previous records for this CPU and number of threads. Returns
+  // false if there are no results or writing failed. Must not be called
+  // concurrently with `Run`.
+  bool SaveAutoTune(const char* path) {
+    char cpu[100];
+    if (!platform::GetCpuString(cpu)) return false;
+
+    std::vector<pool::TunedConfig> records = pool::ReadTunedConfigs(path);
+    bool any = false;
+    for (PoolWaitMode mode : {PoolWaitMode::kSpin, PoolWaitMode::kBlock}) {
+      AutoTuneT& auto_tuner = auto_tune_[static_cast<size_t>(mode) - 1];
+      if (!auto_tuner.Best()) continue;
+
+      pool::TunedConfig record = {};
+      record.magic = pool::TunedConfig::kMagic;
+      record.version = pool::TunedConfig::kVersion;
+      record.num_threads = static_cast<uint32_t>(num_threads_);
+      record.wait_mode = static_cast<uint32_t>(mode);
+      CopyBytes<sizeof(cpu)>(cpu, record.cpu);
+      record.config = *auto_tuner.Best();
+      const size_t idx = static_cast<size_t>(auto_tuner.Best() -
+                                             auto_tuner.Candidates().data());
+      record.cost = auto_tuner.Costs()[idx].EstimateCost();
+
+      records.erase(
+          std::remove_if(records.begin(), records.end(),
+                         [&](const pool::TunedConfig& other) {
+                           return other.wait_mode == record.wait_mode &&
+                                  IsRecordForThisPool(other, cpu);
+                         }),
+          records.end());
+      records.push_back(record);
+      any = true;
+    }
+    return any && pool::WriteTunedConfigs(path, records);
+  }
+
   // parallel-for: Runs `closure(task, worker)` on workers for every `task` in
   // `[begin, end)`. Note that the unit of work should be large enough to
   // amortize the function call overhead, but small enough that each worker
@@ -1153,6 +1841,15 @@ class alignas(HWY_ALIGNMENT) ThreadPool {
       return;
     }
 
+    // See `SetArbitrated`. Only sends a config if another pool became active,
+    // or all others became idle.
+    const bool arbitrated = arbitrated_ && wait_mode_ == PoolWaitMode::kSpin;
+    if (HWY_UNLIKELY(arbitrated)) {
+      const bool others_running = pool::Arbiter::Get().BeginRun() != 0;
+      const pool::Config next = NextConfig(/*may_spin=*/!others_running);
+      if (!IsSameConfig(next, config_)) SendConfig(next);
+    }
+
     SetBusy();
     const bool is_root = PROFILER_IS_ROOT_RUN();
 
@@ -1165,22 +1862,41 @@ class alignas(HWY_ALIGNMENT) ThreadPool {
 
     main_adapter_.SetEpoch(++epoch_);
 
+#if HWY_POOL_INSTRUMENT
+    // One per closure type, i.e. call site.
+    static const size_t site = pool::RunStats::Get().AddSite(HWY_FUNCTION);
+    for (size_t worker = 0; worker < num_workers; ++worker) {
+      workers_[worker].ResetStats();
+    }
+    const uint64_t t_wake = timer::Start();
+#endif
+
     AutoTuneT& auto_tuner = AutoTuner();
-    if (HWY_LIKELY(auto_tuner.Best())) {
+    // Also skip tuning while backed off, because `config_` is not a candidate.
+    if (HWY_LIKELY(auto_tuner.Best() || IsBackedOff())) {
       CallWithConfig(config_, main_adapter_);
+#if HWY_POOL_INSTRUMENT
+      pool::RunStats::Get().Notify(site, workers_, num_workers, t_wake,
+                                   timer::Start());
+#endif
       if (is_root) {
         PROFILER_END_ROOT_RUN();
       }
       ClearBusy();
+      if (HWY_UNLIKELY(arbitrated)) pool::Arbiter::Get().EndRun();
     } else {
       const uint64_t t0 = timer::Start();
       CallWithConfig(config_, main_adapter_);
       const uint64_t t1 = have_timer_stop_ ? timer::Stop() : timer::Start();
+#if HWY_POOL_INSTRUMENT
+      pool::RunStats::Get().Notify(site, workers_, num_workers, t_wake, t1);
+#endif
       auto_tuner.NotifyCost(t1 - t0);
       if (is_root) {
         PROFILER_END_ROOT_RUN();
       }
       ClearBusy();              // before `SendConfig`
+      if (HWY_UNLIKELY(arbitrated)) pool::Arbiter::Get().EndRun();
       if (auto_tuner.Best()) {  // just finished
         HWY_IF_CONSTEXPR(pool::kVerbosity >= 1) {
           const size_t idx_best = static_cast<size_t>(
@@ -1211,7 +1927,183 @@ class alignas(HWY_ALIGNMENT) ThreadPool {
     }
   }
 
+  // Prints, to stdout, one line per `Run` call site (closure type) with the
+  // number of calls and per-call averages: elapsed time, fork-join overhead
+  // (elapsed minus the busiest worker), total busy time of all workers, task
+  // count and how many were stolen, wake and barrier latency per worker,
+  // number of workers that ran tasks, and the ratio of the busiest worker to
+  // the average (mean and max). Then resets all measurements. Measures all
+  // pools in the process. Requires HWY_POOL_INSTRUMENT, otherwise no-op.
+  static void PrintRunStats() {
+#if HWY_POOL_INSTRUMENT
+    pool::RunStats::Get().Print();
+#endif
+  }
+
+  // Returned by `RunAsync`. Movable but not copyable. The destructor calls
+  // `Wait`.
+  class AsyncRun {
+   public:
+    AsyncRun() : pool_(nullptr), epoch_(0) {}  // already done
+    AsyncRun(AsyncRun&& other) noexcept
+        : pool_(other.pool_), epoch_(other.epoch_) {
+      other.pool_ = nullptr;
+    }
+    AsyncRun& operator=(AsyncRun&& other) noexcept {
+      Wait();
+      pool_ = other.pool_;
+      epoch_ = other.epoch_;
+      other.pool_ = nullptr;
+      return *this;
+    }
+    AsyncRun(const AsyncRun&) = delete;
+    AsyncRun& operator=(const AsyncRun&) = delete;
+    ~AsyncRun() { Wait(); }
+
+    // Returns whether all tasks have finished, without blocking.
+    bool IsDone() const {
+      return pool_ == nullptr || pool_->PollAsync(epoch_);
+    }
+
+    // Blocks until all tasks have finished. Afterwards, the pool may be used
+    // again. Subsequent calls have no effect.
+    void Wait() {
+      if (pool_ != nullptr) {
+        pool_->FinishAsync(epoch_);
+        pool_ = nullptr;
+      }
+    }
+
+   private:
+    friend class ThreadPool;
+    AsyncRun(ThreadPool* pool, uint32_t epoch) : pool_(pool), epoch_(epoch) {}
+
+    ThreadPool* pool_;  // nullptr if done and waited for.
+    uint32_t epoch_;
+  };
+
+  // As `Run`, but returns immediately after waking the threads, so that the
+  // main thread can do other work (e.g. I/O) in the meantime. Only the threads
+  // run tasks, hence `worker` is nonzero unless there are no threads, in which
+  // case this runs all tasks before returning.
+  //
+  // `closure` must remain valid, and the pool must not be used for anything
+  // else, including `Run`, `RunAsync` and `SetWaitMode`, until the returned
+  // `AsyncRun` has been waited for or destroyed.
+  template <class Closure>
+  AsyncRun RunAsync(uint64_t begin, uint64_t end, const Closure& closure) {
+    if (HWY_UNLIKELY(num_threads_ == 0 || begin == end)) {
+      for (uint64_t task = begin; task < end; ++task) {
+        closure(task, /*worker=*/0);
+      }
+      return AsyncRun();
+    }
+
+    SetBusy();
+    tasks_.SetAsync(begin, end, closure);
+    // More than one task per thread: use work stealing.
+    if (HWY_LIKELY(end - begin > num_threads_)) {
+      pool::Tasks::DivideRangeAmongThreads(begin, end, num_threads_, workers_);
+    }
+
+    const uint32_t epoch = ++epoch_;
+    pool::AsyncAdapter adapter(workers_, pool::AsyncAdapter::Step::kStart,
+                               epoch);
+    CallWithConfig(config_, adapter);
+    return AsyncRun(this, epoch);
+  }
+
  private:
+  bool PollAsync(uint32_t epoch) {
+    HWY_DASSERT(epoch == epoch_);
+    pool::AsyncAdapter adapter(workers_, pool::AsyncAdapter::Step::kPoll,
+                               epoch);
+    CallWithConfig(config_, adapter);
+    return adapter.Reached();
+  }
+
+  void FinishAsync(uint32_t epoch) {
+    HWY_DASSERT(epoch == epoch_);
+    pool::AsyncAdapter adapter(workers_, pool::AsyncAdapter::Step::kFinish,
+                               epoch);
+    CallWithConfig(config_, adapter);
+    ClearBusy();
+  }
+
+  // LPs for `PinWorkers`, and whether they were leased from `pool::Arbiter`.
+  struct PinTo {
+    std::vector<size_t> lps;
+    bool leased;
+  };
+
+  static PinTo LeaseOrOrder(std::vector<size_t> order, size_t num_threads,
+                            PoolLease lease) {
+    if (lease == PoolLease::kShared || order.empty()) {
+      return PinTo{std::move(order), false};
+    }
+    const size_t max_lps = 1 + HWY_MIN(num_threads, pool::kMaxThreads);
+    return PinTo{pool::Arbiter::Get().Lease(order, max_lps), true};
+  }
+
+  // For the pinning constructor, after `LeaseOrOrder`.
+  ThreadPool(size_t num_threads, PinTo pin_to)
+      : ThreadPool(pin_to.leased
+                       ? HWY_MIN(num_threads,
+                                 HWY_MAX(pin_to.lps.size(), size_t{1}) - 1)
+                       : num_threads) {
+    if (pin_to.leased) {
+      leased_lps_ = std::move(pin_to.lps);
+      PinWorkers(leased_lps_, /*first_worker=*/1);
+    } else {
+      PinWorkers(pin_to.lps, /*first_worker=*/0);
+    }
+  }
+
+  // Pins `worker` to `lps[worker]` for all `worker >= first_worker`. Each
+  // worker runs exactly one task because there are `NumWorkers()`.
+  void PinWorkers(const std::vector<size_t>& lps, size_t first_worker) {
+    if (lps.size() <= first_worker) return;
+    Run(0, NumWorkers(), [&lps, first_worker](uint64_t /*task*/,
+                                              size_t worker) {
+      if (worker < first_worker || worker >= lps.size()) return;
+      if (!PinThreadToLogicalProcessor(lps[worker])) {
+        HWY_WARN("Pinning worker %zu to LP %zu failed.", worker, lps[worker]);
+      }
+    });
+  }
+
+  bool IsRecordForThisPool(const pool::TunedConfig& record,
+                           const char* cpu) const {
+    if (record.num_threads != num_threads_) return false;
+    if (record.wait_mode != static_cast<uint32_t>(PoolWaitMode::kBlock) &&
+        record.wait_mode != static_cast<uint32_t>(PoolWaitMode::kSpin)) {
+      return false;
+    }
+    if (record.cpu[sizeof(record.cpu) - 1] != '\0') return false;
+    return strcmp(record.cpu, cpu) == 0;
+  }
+
+  // Returns the config to use for the next `Run`: the tuned one, or the next
+  // candidate to measure, or if `!may_spin`, a blocking variant.
+  pool::Config NextConfig(bool may_spin = true) {
+    const AutoTuneT& auto_tuner = AutoTuner();
+    pool::Config next =
+        auto_tuner.Best() ? *auto_tuner.Best() : auto_tuner.NextConfig();
+    if (!may_spin) next.wait_type = pool::WaitType::kBlock;
+    return next;
+  }
+
+  // Whether `NextConfig` replaced a spinning wait type.
+  bool IsBackedOff() const {
+    return wait_mode_ == PoolWaitMode::kSpin &&
+           config_.wait_type == pool::WaitType::kBlock;
+  }
+
+  static bool IsSameConfig(const pool::Config& a, const pool::Config& b) {
+    return a.spin_type == b.spin_type && a.wait_type == b.wait_type &&
+           a.barrier_type == b.barrier_type;
+  }
+
   // Used to initialize ThreadPool::num_threads_ from its ctor argument.
   static size_t ClampedNumThreads(size_t num_threads) {
     // Upper bound is required for `worker_bytes_`.
@@ -1241,6 +2133,8 @@ class alignas(HWY_ALIGNMENT) ThreadPool {
   // - Threads notify a barrier and wait, BOTH with the new config.
   // - Main thread switches to `copy` for the next wake.
   HWY_NOINLINE void SendConfig(pool::Config copy) {
+    // Not part of the auto-tuned candidates, hence set here.
+    copy.arbitrated = arbitrated_ && wait_mode_ == PoolWaitMode::kSpin;
     if (NumWorkers() == 1) {
       config_ = copy;
       return;
@@ -1305,6 +2199,12 @@ class alignas(HWY_ALIGNMENT) ThreadPool {
 
   PoolWaitMode wait_mode_;
   AutoTuneT auto_tune_[2];  // accessed via `AutoTuner`
+  // For the constructor that restores and saves auto-tuning results.
+  std::string autotune_path_;
+  uint32_t restored_modes_ = 0;  // bit index is the `PoolWaitMode`
+  // Non-empty if constructed with `PoolLease::kExclusive`.
+  std::vector<size_t> leased_lps_;
+  bool arbitrated_ = false;  // see `SetArbitrated`
 
   // Last because it is large. Store inside `ThreadPool` so that callers can
   // bind it to the NUMA node's memory. Not stored inside `WorkerLifecycle`
@@ -0,0 +1,109 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Built with -DHWY_POOL_INSTRUMENT=1, see CMakeLists.txt and BUILD.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>  // strstr
+
+#include <atomic>
+
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/tests/hwy_gtest.h"
+#include "hwy/tests/test_util-inl.h"
+
+#if !HWY_POOL_INSTRUMENT
+#error "This test requires HWY_POOL_INSTRUMENT=1."
+#endif
+
+namespace hwy {
+namespace pool {
+namespace {
+
+// Named closure types, so that their call sites can be found via the
+// `HWY_FUNCTION` recorded by `RunStats`, independently of the compiler.
+struct ManyTasks {
+  void operator()(uint64_t task, size_t /*worker*/) const {
+    sum->fetch_add(task);
+  }
+  std::atomic<uint64_t>* sum;
+};
+
+struct FewTasks {
+  void operator()(uint64_t task, size_t /*worker*/) const {
+    sum->fetch_add(task);
+  }
+  std::atomic<uint64_t>* sum;
+};
+
+// Returns the stats of the site whose name contains `closure`, or nullptr.
+const RunSiteStats* FindSite(const char* closure) {
+  const RunSiteStats* found = nullptr;
+  RunStats::Get().Foreach(
+      [&](const char* name, const RunSiteStats& site) {
+        if (strstr(name, closure) != nullptr) {
+          HWY_ASSERT(found == nullptr);  // must be unique
+          found = &site;
+        }
+      });
+  return found;
+}
+
+TEST(ThreadPoolInstrumentTest, TestRunStatsCounts) {
+  if (!hwy::HaveThreadingSupport()) return;
+
+  // Explicit thread count because `Run` bypasses instrumentation if there is
+  // only one worker.
+  ThreadPool pool(2);
+  HWY_ASSERT(pool.NumWorkers() == 3);
+
+  // Reset any measurements from earlier tests.
+  ThreadPool::PrintRunStats();
+
+  constexpr size_t kReps = 20;
+  constexpr uint64_t kManyTasks = 50;  // work stealing
+  constexpr uint64_t kFewTasks = 3;    // one per worker
+  std::atomic<uint64_t> sum{0};
+  for (size_t rep = 0; rep < kReps; ++rep) {
+    pool.Run(0, kManyTasks, ManyTasks{&sum});
+    pool.Run(0, kFewTasks, FewTasks{&sum});
+  }
+  HWY_ASSERT_EQ(
+      uint64_t{kReps * (kManyTasks * (kManyTasks - 1) / 2 +
+                        kFewTasks * (kFewTasks - 1) / 2)},
+      sum.load());
+
+  const RunSiteStats* many = FindSite("ManyTasks");
+  const RunSiteStats* few = FindSite("FewTasks");
+  HWY_ASSERT(many != nullptr && few != nullptr);
+  HWY_ASSERT_EQ(uint64_t{kReps}, many->Runs());
+  HWY_ASSERT_EQ(uint64_t{kReps} * kManyTasks, many->Tasks());
+  HWY_ASSERT(many->Steals() <= many->Tasks());
+  HWY_ASSERT_EQ(uint64_t{kReps}, few->Runs());
+  HWY_ASSERT_EQ(uint64_t{kReps} * kFewTasks, few->Tasks());
+
+  // Printing resets the measurements.
+  ThreadPool::PrintRunStats();
+  HWY_ASSERT_EQ(uint64_t{0}, FindSite("ManyTasks")->Runs());
+  HWY_ASSERT_EQ(uint64_t{0}, FindSite("FewTasks")->Tasks());
+}
+
+}  // namespace
+}  // namespace pool
+}  // namespace hwy
+
+HWY_TEST_MAIN();
@@ -29,11 +29,15 @@
 #include <vector>
 
 #include "hwy/base.h"  // PopCount
+#include "hwy/cache_control.h"  // Pause
+#include "hwy/contrib/thread_pool/hierarchical_pool.h"
 #include "hwy/contrib/thread_pool/spin.h"
 #include "hwy/contrib/thread_pool/topology.h"
+#include "hwy/contrib/thread_pool/work_stealing.h"
 #include "hwy/profiler.h"
 #include "hwy/tests/hwy_gtest.h"
 #include "hwy/tests/test_util-inl.h"  // AdjustedReps
+#include "hwy/timer.h"
 
 namespace hwy {
 namespace pool {
@@ -483,6 +487,411 @@ TEST(ThreadPoolTest, TestCounter) {
   }
 }
 
+TEST(ThreadPoolTest, TestHierarchicalLPs) {
+  const Topology topology;
+  const std::vector<HierarchicalPool::PackageLPs> packages =
+      HierarchicalPool::AvailableLPs(topology);
+  HWY_ASSERT(!packages.empty());
+  LogicalProcessorSet seen;
+  for (const HierarchicalPool::PackageLPs& clusters : packages) {
+    HWY_ASSERT(!clusters.empty());
+    for (const HierarchicalPool::ClusterLPs& lps : clusters) {
+      HWY_ASSERT(!lps.empty());
+      for (size_t lp : lps) {
+        HWY_ASSERT(!seen.Get(lp));  // Each LP is in only one cluster.
+        seen.Set(lp);
+      }
+    }
+  }
+}
+
+// Every task runs once, on a worker of the cluster whose share contains it.
+TEST(ThreadPoolTest, TestHierarchicalPool) {
+  if (!hwy::HaveThreadingSupport()) return;
+
+  // LP numbers are not used because we do not pin.
+  const std::vector<HierarchicalPool::PackageLPs> packages = {
+      {{0, 1, 2}, {3}}, {{4, 5}}};
+  const size_t cluster_of_worker[6] = {0, 0, 0, 1, 2, 2};
+  const size_t first_worker[4] = {0, 3, 4, 6};
+  HierarchicalPool pool(packages, /*pin=*/false);
+  HWY_ASSERT_EQ(size_t{2}, pool.NumPackages());
+  HWY_ASSERT_EQ(size_t{3}, pool.NumClusters());
+  HWY_ASSERT_EQ(size_t{6}, pool.NumWorkers());
+
+  constexpr uint64_t kMaxTasks = 50;
+  static std::atomic<uint64_t> counts[kMaxTasks];
+  static std::atomic<size_t> workers[kMaxTasks];
+  for (bool spin : {true, false}) {
+    pool.SetWaitMode(spin ? PoolWaitMode::kSpin : PoolWaitMode::kBlock);
+    for (uint64_t num_tasks = 0; num_tasks < kMaxTasks; ++num_tasks) {
+      const uint64_t begin = num_tasks * 7;
+      for (uint64_t i = 0; i < num_tasks; ++i) counts[i].store(0);
+      pool.Run(begin, begin + num_tasks, [begin](uint64_t task, size_t worker) {
+        HWY_ASSERT(begin <= task && task < begin + kMaxTasks);
+        counts[task - begin].fetch_add(1);
+        workers[task - begin].store(worker);
+      });
+
+      for (uint64_t i = 0; i < num_tasks; ++i) {
+        HWY_ASSERT_EQ(uint64_t{1}, counts[i].load());
+        const size_t worker = workers[i].load();
+        HWY_ASSERT(worker < pool.NumWorkers());
+        const size_t cluster = cluster_of_worker[worker];
+        HWY_ASSERT(num_tasks * first_worker[cluster] / 6 <= i);
+        HWY_ASSERT(i < num_tasks * first_worker[cluster + 1] / 6);
+      }
+    }
+  }
+}
+
+TEST(ThreadPoolTest, TestPinning) {
+  if (!hwy::HaveThreadingSupport()) return;
+
+  const Topology topology;
+  LogicalProcessorSet original;
+  if (topology.packages.empty() || !GetThreadAffinity(original)) return;
+
+  const std::vector<size_t> lps =
+      PinningOrder(topology, PoolPinning::kScatterCores);
+  HWY_ASSERT(!lps.empty());
+  {
+    ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads(), size_t{3}), topology,
+                    PoolPinning::kScatterCores);
+    static std::atomic<size_t> pinned_lp[4];
+    pool.Run(0, pool.NumWorkers(), [](uint64_t /*task*/, size_t worker) {
+      LogicalProcessorSet affinity;
+      HWY_ASSERT(GetThreadAffinity(affinity));
+      HWY_ASSERT(affinity.Count() == 1);
+      affinity.Foreach([worker](size_t lp) { pinned_lp[worker].store(lp); });
+    });
+    for (size_t worker = 0; worker < pool.NumWorkers(); ++worker) {
+      HWY_ASSERT_EQ(lps[worker], pinned_lp[worker].load());
+    }
+  }
+
+  // Undo the pinning of the main thread.
+  HWY_ASSERT(SetThreadAffinity(original));
+}
+
+TEST(ThreadPoolTest, TestArbiterLease) {
+  // High LP numbers to avoid interfering with pools.
+  const std::vector<size_t> order = {1000, 1001, 1002, 1003};
+  pool::Arbiter& arbiter = pool::Arbiter::Get();
+
+  const std::vector<size_t> first = arbiter.Lease(order, 3);
+  HWY_ASSERT(first == std::vector<size_t>({1000, 1001, 1002}));
+  const std::vector<size_t> second = arbiter.Lease(order, 3);
+  HWY_ASSERT(second == std::vector<size_t>({1003}));
+  HWY_ASSERT(arbiter.Lease(order, 3).empty());
+
+  arbiter.Release(first);
+  const std::vector<size_t> third = arbiter.Lease(order, 4);
+  HWY_ASSERT(third == first);
+  arbiter.Release(second);
+  arbiter.Release(third);
+}
+
+TEST(ThreadPoolTest, TestLeaseExclusive) {
+  if (!hwy::HaveThreadingSupport()) return;
+
+  const Topology topology;
+  const size_t num_lps = PinningOrder(topology, PoolPinning::kCompact).size();
+  if (num_lps == 0) return;
+  const size_t num_threads = HWY_MIN(num_lps - 1, pool::kMaxThreads);
+
+  size_t first_workers;
+  {
+    ThreadPool first(num_threads, topology, PoolPinning::kCompact,
+                     PoolLease::kExclusive);
+    first_workers = first.NumWorkers();
+    HWY_ASSERT(first_workers == 1 + num_threads);
+    // The second only receives the LPs not leased by the first, which is none
+    // unless `num_threads` was clamped, and thus has no threads of its own.
+    ThreadPool second(num_threads, topology, PoolPinning::kCompact,
+                      PoolLease::kExclusive);
+    HWY_ASSERT(first.NumWorkers() + second.NumWorkers() <= num_lps + 1);
+
+    std::atomic<uint64_t> sum{0};
+    second.Run(0, 100, [&sum, num_threads](uint64_t task, size_t worker) {
+      HWY_ASSERT(worker < 1 + num_threads);
+      sum.fetch_add(task);
+    });
+    HWY_ASSERT(sum.load() == 4950);
+  }
+
+  // The destructors released the LPs.
+  ThreadPool third(num_threads, topology, PoolPinning::kCompact,
+                   PoolLease::kExclusive);
+  HWY_ASSERT(third.NumWorkers() == first_workers);
+}
+
+TEST(ThreadPoolTest, TestSpinArbitration) {
+  if (!hwy::HaveThreadingSupport()) return;
+
+  ThreadPool first(2);
+  ThreadPool second(2);
+  first.SetWaitMode(PoolWaitMode::kSpin);
+  second.SetWaitMode(PoolWaitMode::kSpin);
+
+  std::atomic<uint64_t> sum{0};
+  const auto add = [&sum](uint64_t task, size_t /*worker*/) {
+    sum.fetch_add(task);
+  };
+  // Runs `second` while `first` is active.
+  const auto nested = [&](uint64_t task, size_t /*worker*/) {
+    if (task == 0) second.Run(0, 100, add);
+  };
+
+  // Not arbitrated by default: both keep spinning.
+  first.Run(0, first.NumWorkers(), nested);
+  HWY_ASSERT(first.config().wait_type != pool::WaitType::kBlock);
+  HWY_ASSERT(second.config().wait_type != pool::WaitType::kBlock);
+
+  first.SetArbitrated(true);
+  second.SetArbitrated(true);
+  // The second backs off while the first is active.
+  first.Run(0, first.NumWorkers(), nested);
+  HWY_ASSERT(first.config().wait_type != pool::WaitType::kBlock);
+  HWY_ASSERT(second.config().wait_type == pool::WaitType::kBlock);
+
+  // The first remains in spin mode, but is idle, hence the second may spin on
+  // its next `Run`. Meanwhile, the idle workers of the first block.
+  const size_t first_threads = first.NumWorkers() - 1;
+  std::atomic<bool> all_blocked{false};
+  second.Run(0, second.NumWorkers(), [&](uint64_t task, size_t /*worker*/) {
+    if (task != 0) return;
+    const double t0 = platform::Now();
+    while (platform::Now() - t0 < 10.0) {  // seconds; bounded in case of bugs
+      if (first.NumBlockedWorkers() == first_threads) {
+        all_blocked.store(true);
+        break;
+      }
+      hwy::Pause();
+    }
+  });
+  HWY_ASSERT(all_blocked.load());
+  HWY_ASSERT(second.config().wait_type != pool::WaitType::kBlock);
+  // Wakes the blocked workers of the first, which then spin again.
+  first.Run(0, 100, add);
+  HWY_ASSERT(first.config().wait_type != pool::WaitType::kBlock);
+  HWY_ASSERT(first.NumBlockedWorkers() == 0);
+  first.Run(0, 100, add);
+  HWY_ASSERT(sum.load() == 4 * 4950);
+
+  first.SetWaitMode(PoolWaitMode::kBlock);
+  second.SetWaitMode(PoolWaitMode::kBlock);
+}
+
+// Calls `pool.Run` until auto-tuning of the current wait mode is complete.
+void RunUntilTuned(ThreadPool& pool) {
+  for (size_t rep = 0; rep < 100000 && !pool.AutoTuneComplete(); ++rep) {
+    pool.Run(0, pool.NumWorkers(), [](uint64_t /*task*/, size_t /*worker*/) {});
+  }
+  HWY_ASSERT(pool.AutoTuneComplete());
+}
+
+TEST(ThreadPoolTest, TestPersistAutoTune) {
+  if (!hwy::HaveThreadingSupport()) return;
+  char cpu100[100];
+  if (!platform::GetCpuString(cpu100)) return;
+
+  const char* path = "thread_pool_test_autotune.bin";
+  (void)remove(path);
+  const size_t num_threads = 2;  // Run does not tune without threads.
+
+  // No file yet: tunes, then saves in the destructor.
+  Config best;
+  {
+    ThreadPool pool(num_threads, path);
+    HWY_ASSERT(!pool.AutoTuneComplete());
+    RunUntilTuned(pool);
+    best = pool.config();
+  }
+
+  // Restored, without any `Run`.
+  {
+    ThreadPool pool(num_threads, path);
+    HWY_ASSERT(pool.AutoTuneComplete());
+    HWY_ASSERT(pool.config().spin_type == best.spin_type);
+    HWY_ASSERT(pool.config().wait_type == best.wait_type);
+    HWY_ASSERT(pool.config().barrier_type == best.barrier_type);
+    pool.Run(0, 10, [](uint64_t /*task*/, size_t /*worker*/) {});
+    // Only the tuned wait mode was saved.
+    pool.SetWaitMode(PoolWaitMode::kSpin);
+    HWY_ASSERT(!pool.AutoTuneComplete());
+  }
+
+  // Records are specific to the number of threads.
+  {
+    ThreadPool pool(num_threads + 1);
+    HWY_ASSERT(!pool.LoadAutoTune(path));
+    HWY_ASSERT(!pool.AutoTuneComplete());
+  }
+
+  // A stale config that is no longer a candidate is ignored.
+  std::vector<TunedConfig> records = ReadTunedConfigs(path);
+  HWY_ASSERT(records.size() == 1);
+  for (TunedConfig& record : records) {
+    record.config.wait_type = WaitType::kSentinel;
+  }
+  HWY_ASSERT(WriteTunedConfigs(path, records));
+  {
+    ThreadPool pool(num_threads);
+    HWY_ASSERT(!pool.LoadAutoTune(path));
+    HWY_ASSERT(!pool.AutoTuneComplete());
+  }
+
+  // As are records with invalid costs.
+  records = ReadTunedConfigs(path);
+  for (TunedConfig& record : records) {
+    record.config = best;
+    record.cost = -1.0;
+  }
+  HWY_ASSERT(WriteTunedConfigs(path, records));
+  {
+    ThreadPool pool(num_threads);
+    HWY_ASSERT(!pool.LoadAutoTune(path));
+    HWY_ASSERT(!pool.AutoTuneComplete());
+  }
+
+  // And an invalid file.
+  FILE* file = fopen(path, "wb");
+  HWY_ASSERT(file);
+  const char garbage[] = "not a tuning record";
+  HWY_ASSERT(fwrite(garbage, sizeof(garbage), 1, file) == 1);
+  HWY_ASSERT(fclose(file) == 0);
+  {
+    ThreadPool pool(num_threads);
+    HWY_ASSERT(!pool.LoadAutoTune(path));
+    HWY_ASSERT(!pool.AutoTuneComplete());
+  }
+
+  HWY_ASSERT(remove(path) == 0);
+}
+
+// Recursively splits [begin, end) and spawns the left half. Leaves increment
+// their counter, and sometimes spin to make the task costs irregular.
+struct SpawnHalves {
+  void operator()(size_t worker) const {
+    HWY_ASSERT(worker < scheduler->NumWorkers());
+    if (end - begin == 1) {
+      if ((begin % 7) == 0) {
+        for (size_t i = 0; i < 10 * begin; ++i) hwy::Pause();
+      }
+      counts[begin].fetch_add(1);
+      return;
+    }
+    const size_t mid = begin + (end - begin) / 2;
+    TaskGroup group;
+    const SpawnHalves left = {scheduler, counts, begin, mid};
+    scheduler->Spawn(group, worker, left);
+    SpawnHalves{scheduler, counts, mid, end}(worker);
+    scheduler->Sync(group, worker);
+  }
+
+  TaskScheduler* scheduler;
+  std::atomic<uint64_t>* counts;
+  size_t begin;
+  size_t end;
+};
+
+TEST(ThreadPoolTest, TestTaskScheduler) {
+  if (!hwy::HaveThreadingSupport()) return;
+
+  constexpr size_t kNumLeaves = 1000;
+  static std::atomic<uint64_t> counts[kNumLeaves];
+  for (size_t num_threads = 0; num_threads <= 5; num_threads += 2) {
+    ThreadPool pool(num_threads);
+    TaskScheduler scheduler(pool);
+    for (bool spin : {true, false}) {
+      pool.SetWaitMode(spin ? PoolWaitMode::kSpin : PoolWaitMode::kBlock);
+      for (size_t rep = 0; rep < 3; ++rep) {
+        for (std::atomic<uint64_t>& count : counts) count.store(0);
+        scheduler.Run(SpawnHalves{&scheduler, counts, 0, kNumLeaves});
+        for (std::atomic<uint64_t>& count : counts) {
+          HWY_ASSERT_EQ(uint64_t{1}, count.load());
+        }
+      }
+
+      // More tasks in one group than fit in the deque.
+      std::atomic<uint64_t> sum{0};
+      const auto add = [&sum](size_t /*worker*/) { sum.fetch_add(1); };
+      scheduler.Run([&](size_t worker) {
+        TaskGroup group;
+        for (size_t i = 0; i < 2 * pool::TaskDeque::kCapacity; ++i) {
+          scheduler.Spawn(group, worker, add);
+        }
+        scheduler.Sync(group, worker);
+        HWY_ASSERT(group.IsDone());
+      });
+      HWY_ASSERT_EQ(uint64_t{2 * pool::TaskDeque::kCapacity}, sum.load());
+    }
+  }
+}
+
+TEST(ThreadPoolTest, TestRunAsync) {
+  if (!hwy::HaveThreadingSupport()) return;
+
+  constexpr uint64_t kMaxTasks = 100;
+  static std::atomic<uint64_t> counts[kMaxTasks];
+  for (size_t num_threads = 0; num_threads <= 5; num_threads += 2) {
+    ThreadPool pool(num_threads);
+    for (bool spin : {true, false}) {
+      pool.SetWaitMode(spin ? PoolWaitMode::kSpin : PoolWaitMode::kBlock);
+      const uint64_t all_num_tasks[] = {0, 1, 2, 3, 5, 6, 20, 100};
+      for (uint64_t num_tasks : all_num_tasks) {
+        const uint64_t begin = 3;
+        for (uint64_t i = 0; i < num_tasks; ++i) counts[i].store(0);
+        const auto closure = [&pool, begin](uint64_t task, size_t worker) {
+          HWY_ASSERT(worker < pool.NumWorkers());
+          // The main thread only runs tasks if there are no other threads.
+          HWY_ASSERT(worker != 0 || pool.NumWorkers() == 1);
+          counts[task - begin].fetch_add(1);
+        };
+        ThreadPool::AsyncRun async =
+            pool.RunAsync(begin, begin + num_tasks, closure);
+        // Main thread is free to do other work until the tasks are done.
+        while (!async.IsDone()) hwy::Pause();
+        async.Wait();
+        HWY_ASSERT(async.IsDone());
+        async.Wait();  // no effect
+        for (uint64_t i = 0; i < num_tasks; ++i) {
+          HWY_ASSERT_EQ(uint64_t{1}, counts[i].load());
+        }
+
+        // The pool is usable again, also if the destructor waits.
+        { ThreadPool::AsyncRun async2 = pool.RunAsync(0, 0, closure); }
+        pool.Run(begin, begin + num_tasks,
+                 [](uint64_t task, size_t /*worker*/) {
+                   counts[task - 3].fetch_add(1);
+                 });
+        for (uint64_t i = 0; i < num_tasks; ++i) {
+          HWY_ASSERT_EQ(uint64_t{2}, counts[i].load());
+        }
+      }
+    }
+  }
+}
+
+// Only prints if HWY_POOL_INSTRUMENT. The counts are verified by
+// thread_pool_instrument_test.
+TEST(ThreadPoolTest, TestPrintRunStats) {
+  if (!hwy::HaveThreadingSupport()) return;
+
+  ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads(), size_t{3}));
+  std::atomic<uint64_t> sum{0};
+  for (size_t rep = 0; rep < 20; ++rep) {
+    // Uneven task costs.
+    pool.Run(0, 50, [&sum](uint64_t task, size_t /*worker*/) {
+      for (uint64_t i = 0; i < task * 10; ++i) hwy::Pause();
+      sum.fetch_add(task);
+    });
+  }
+  HWY_ASSERT_EQ(uint64_t{20 * 50 * 49 / 2}, sum.load());
+  ThreadPool::PrintRunStats();
+}
+
 }  // namespace
 }  // namespace pool
 }  // namespace hwy
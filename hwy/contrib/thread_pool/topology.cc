@@ -20,9 +20,11 @@
 #include <stdio.h>
 #include <string.h>  // strchr
 
+#include <algorithm>  // std::sort
 #include <array>
 #include <map>
 #include <string>
+#include <utility>  // std::pair
 #include <vector>
 
 #include "hwy/base.h"  // HWY_OS_WIN, HWY_WARN
@@ -874,6 +876,84 @@ HWY_CONTRIB_DLLEXPORT Topology::Topology() {
 #endif  // HWY_OS_*
 }
 
+// ------------------------------ Pinning
+
+namespace {
+
+// Sort key, from most to least significant field.
+uint64_t PinningKey(size_t a, size_t b, size_t c, size_t d) {
+  HWY_DASSERT(a <= 0xFFFF && b <= 0xFFFF && c <= 0xFFFF && d <= 0xFFFF);
+  return (static_cast<uint64_t>(a) << 48) | (static_cast<uint64_t>(b) << 32) |
+         (static_cast<uint64_t>(c) << 16) | static_cast<uint64_t>(d);
+}
+
+}  // namespace
+
+HWY_CONTRIB_DLLEXPORT std::vector<size_t> PinningOrder(
+    const Topology& topology, PoolPinning pinning) {
+  std::vector<size_t> order;
+  if (pinning == PoolPinning::kNone || topology.packages.empty()) return order;
+
+  LogicalProcessorSet enabled;
+  const bool have_affinity = GetThreadAffinity(enabled);
+
+  std::vector<std::pair<uint64_t, size_t>> keyed;  // (key, lp)
+  std::vector<size_t> clusters_per_node;  // number of clusters seen so far
+  size_t global_cluster = 0;
+  for (const Topology::Package& package : topology.packages) {
+    for (const Topology::Cluster& cluster : package.clusters) {
+      std::vector<size_t> lps;
+      cluster.lps.Foreach([&](size_t lp) {
+        if (lp < topology.lps.size() && (!have_affinity || enabled.Get(lp))) {
+          lps.push_back(lp);
+        }
+      });
+      if (lps.empty()) continue;
+
+      // Rank of each core within this cluster, and of the cluster within its
+      // NUMA node.
+      std::vector<size_t> cores;
+      for (size_t lp : lps) cores.push_back(topology.lps[lp].core);
+      std::sort(cores.begin(), cores.end());
+      cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+      const size_t node = topology.lps[lps[0]].node;
+      if (node >= clusters_per_node.size()) clusters_per_node.resize(node + 1);
+      const size_t cluster_in_node = clusters_per_node[node]++;
+
+      for (size_t lp : lps) {
+        const Topology::LP& info = topology.lps[lp];
+        const size_t core_in_cluster = static_cast<size_t>(
+            std::lower_bound(cores.begin(), cores.end(), info.core) -
+            cores.begin());
+        uint64_t key = 0;
+        switch (pinning) {
+          case PoolPinning::kNone:
+            break;
+          case PoolPinning::kCompact:
+            key = PinningKey(global_cluster, info.core, info.smt, 0);
+            break;
+          case PoolPinning::kScatterCores:
+            key = PinningKey(info.smt, global_cluster, info.core, 0);
+            break;
+          case PoolPinning::kPerCluster:
+            key = PinningKey(info.smt, core_in_cluster, global_cluster, 0);
+            break;
+          case PoolPinning::kPerNode:
+            key = PinningKey(info.smt, core_in_cluster, cluster_in_node, node);
+            break;
+        }
+        keyed.emplace_back(key, lp);
+      }
+      ++global_cluster;
+    }
+  }
+
+  std::sort(keyed.begin(), keyed.end());
+  order.reserve(keyed.size());
+  for (const auto& key_lp : keyed) order.push_back(key_lp.second);
+  return order;
+}
+
 // ------------------------------ Cache detection
 
 namespace {
@@ -1227,4 +1307,25 @@ HWY_CONTRIB_DLLEXPORT const Cache* DataCaches() {
   return caches;
 }
 
+HWY_CONTRIB_DLLEXPORT Tiles TileRange(size_t total_bytes, size_t bytes_per_item,
+                                      size_t level) {
+  HWY_ASSERT(bytes_per_item != 0);
+  HWY_ASSERT(1 <= level && level <= 3);
+
+  // Typical per-core portions if detection failed.
+  static constexpr uint32_t kDefaultKiB[4] = {0, 32, 256, 1024};
+  uint32_t kib = kDefaultKiB[level];
+  if (const Cache* caches = DataCaches()) {
+    while (level > 1 && caches[level].size_kib == 0) --level;
+    if (caches[level].size_kib != 0) kib = caches[level].size_kib;
+  }
+
+  const size_t budget = size_t{kib} * 1024 / 2;
+  Tiles tiles;
+  tiles.items_per_tile = HWY_MAX(budget / bytes_per_item, size_t{1});
+  const size_t num_items = DivCeil(total_bytes, bytes_per_item);
+  tiles.num_tiles = DivCeil(num_items, tiles.items_per_tile);
+  return tiles;
+}
+
 }  // namespace hwy
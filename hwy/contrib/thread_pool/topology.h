@@ -103,6 +103,33 @@ struct Topology {
   std::vector<LP> lps;  // size() == TotalLogicalProcessors().
 };
 
+// Policies for assigning threads to logical processors (LPs), see
+// `PinningOrder`. Only LPs of the first `N` returned are used if there are `N`
+// threads, hence the order determines which cores and caches are shared.
+enum class PoolPinning : uint8_t {
+  // Threads are not pinned, and the OS may migrate them.
+  kNone,
+  // All LPs of a core, then the next core of the cluster, then the next
+  // cluster or package. Uses the fewest cores and caches, which is best if
+  // threads share data.
+  kCompact,
+  // As `kCompact`, but one LP per core before any of their SMT siblings.
+  // Avoids competing for the resources of a core.
+  kScatterCores,
+  // One LP per core, round-robin across clusters. Maximizes the total private
+  // and shared cache capacity available to the first threads.
+  kPerCluster,
+  // As `kPerCluster`, but round-robin across NUMA nodes, and only then across
+  // the clusters of a node. Maximizes the total memory bandwidth.
+  kPerNode,
+};
+
+// Returns the LPs available to the calling thread (see `GetThreadAffinity`) in
+// the order given by `pinning`, or an empty vector if `pinning` is `kNone` or
+// `topology` is unknown.
+HWY_CONTRIB_DLLEXPORT std::vector<size_t> PinningOrder(
+    const Topology& topology, PoolPinning pinning);
+
 #pragma pack(push, 1)
 // Cache parameters. Note the overlap with `HWY_ALIGNMENT`, which is intended
 // but not guaranteed to be an upper bound for L1/L2 line sizes, and
@@ -136,6 +163,21 @@ static_assert(sizeof(Cache) == 16, "Unexpected size");
 // callers should cache the result.
 HWY_CONTRIB_DLLEXPORT const Cache* DataCaches();
 
+// Partition of a range of items into tiles, see `TileRange`.
+struct Tiles {
+  size_t items_per_tile = 1;
+  size_t num_tiles = 0;  // The last tile may have fewer items.
+};
+
+// Returns how to split `total_bytes`, consisting of items of `bytes_per_item`,
+// into tiles that fit in half of the data cache `level` (1 to 3), leaving room
+// for other data. For shared caches, this is the per-core portion because all
+// cores are assumed to process tiles concurrently. Tiles have at least one
+// item, even if it does not fit. If `DataCaches` is unknown, uses typical
+// sizes; if the level does not exist, uses the next lower level.
+HWY_CONTRIB_DLLEXPORT Tiles TileRange(size_t total_bytes, size_t bytes_per_item,
+                                      size_t level);
+
 }  // namespace hwy
 
 #endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_TOPOLOGY_H_
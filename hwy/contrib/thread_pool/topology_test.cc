@@ -129,6 +129,94 @@ TEST(TopologyTest, TestCaches) {
   }
 }
 
+TEST(TopologyTest, TestTileRange) {
+  for (size_t level = 1; level <= 3; ++level) {
+    const Tiles empty = TileRange(0, 64, level);
+    HWY_ASSERT(empty.num_tiles == 0 && empty.items_per_tile >= 1);
+
+    // A single item larger than any cache is still one tile.
+    const size_t huge = size_t{1} << 30;
+    const Tiles one = TileRange(huge, huge, level);
+    HWY_ASSERT(one.items_per_tile == 1 && one.num_tiles == 1);
+
+    // The tiles cover all items, and each fits in the cache.
+    const size_t bytes_per_item = 192;
+    const size_t num_items = 100000;
+    const Tiles tiles = TileRange(num_items * bytes_per_item, bytes_per_item,
+                                  level);
+    HWY_ASSERT(tiles.num_tiles * tiles.items_per_tile >= num_items);
+    HWY_ASSERT((tiles.num_tiles - 1) * tiles.items_per_tile < num_items);
+    const Cache* caches = DataCaches();
+    if (caches && caches[level].size_kib != 0) {
+      HWY_ASSERT(tiles.items_per_tile * bytes_per_item <=
+                 size_t{caches[level].size_kib} * 1024);
+    }
+    // Higher levels are at least as large.
+    if (level != 1) {
+      HWY_ASSERT(tiles.items_per_tile >=
+                 TileRange(num_items * bytes_per_item, bytes_per_item,
+                           level - 1)
+                     .items_per_tile);
+    }
+  }
+}
+
+TEST(TopologyTest, TestPinningOrder) {
+  Topology topology;
+  HWY_ASSERT(PinningOrder(topology, PoolPinning::kNone).empty());
+  if (topology.packages.empty()) return;
+
+  LogicalProcessorSet enabled;
+  const bool have_affinity = GetThreadAffinity(enabled);
+
+  const PoolPinning policies[] = {PoolPinning::kCompact,
+                                  PoolPinning::kScatterCores,
+                                  PoolPinning::kPerCluster,
+                                  PoolPinning::kPerNode};
+  for (PoolPinning pinning : policies) {
+    const std::vector<size_t> order = PinningOrder(topology, pinning);
+    HWY_ASSERT(!order.empty());
+    // Each available LP exactly once.
+    LogicalProcessorSet seen;
+    for (size_t lp : order) {
+      HWY_ASSERT(lp < topology.lps.size());
+      HWY_ASSERT(!seen.Get(lp));
+      seen.Set(lp);
+      if (have_affinity) HWY_ASSERT(enabled.Get(lp));
+    }
+    if (have_affinity) HWY_ASSERT(seen.Count() == enabled.Count());
+
+    // All but `kCompact` use one LP per core before any SMT sibling.
+    if (pinning != PoolPinning::kCompact) {
+      for (size_t i = 1; i < order.size(); ++i) {
+        HWY_ASSERT(topology.lps[order[i - 1]].smt <=
+                   topology.lps[order[i]].smt);
+      }
+    }
+  }
+
+  // `kCompact` visits each cluster in one contiguous run.
+  const std::vector<size_t> compact =
+      PinningOrder(topology, PoolPinning::kCompact);
+  size_t num_runs = 1;
+  for (size_t i = 1; i < compact.size(); ++i) {
+    const Topology::LP& prev = topology.lps[compact[i - 1]];
+    const Topology::LP& lp = topology.lps[compact[i]];
+    num_runs += prev.package != lp.package || prev.cluster != lp.cluster;
+  }
+  size_t num_clusters = 0;
+  for (const Topology::Package& package : topology.packages) {
+    for (const Topology::Cluster& cluster : package.clusters) {
+      bool any = false;
+      cluster.lps.Foreach([&](size_t lp) {
+        any |= !have_affinity || enabled.Get(lp);
+      });
+      num_clusters += any;
+    }
+  }
+  HWY_ASSERT(num_runs == num_clusters);
+}
+
 }  // namespace
 }  // namespace hwy
 
@@ -0,0 +1,337 @@
+// Copyright 2025 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HIGHWAY_HWY_CONTRIB_THREAD_POOL_WORK_STEALING_H_
+#define HIGHWAY_HWY_CONTRIB_THREAD_POOL_WORK_STEALING_H_
+
+// Nested parallelism with Spawn/Sync on top of `ThreadPool`.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "hwy/aligned_allocator.h"  // MakeUniqueAlignedArray
+#include "hwy/base.h"
+#include "hwy/cache_control.h"  // Pause
+#include "hwy/contrib/thread_pool/futex.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+
+namespace hwy {
+
+class TaskGroup;
+
+namespace pool {
+
+// A closure passed to `TaskScheduler::Spawn`, plus the group to notify once it
+// has run. Closures are referenced, not copied.
+struct SpawnedTask {
+  typedef void (*Func)(const void* opaque, size_t worker);
+
+  Func func;
+  const void* opaque;
+  TaskGroup* group;
+};
+
+// Chase-Lev work-stealing deque with a fixed capacity, as described in "Correct
+// and Efficient Work-Stealing for Weak Memory Models" (Le et al., 2013). The
+// owner pushes and pops at the bottom (LIFO, for locality); other workers steal
+// from the top (FIFO, which are typically the largest tasks).
+class TaskDeque {
+  static constexpr auto kRlx = std::memory_order_relaxed;
+  static constexpr auto kAcq = std::memory_order_acquire;
+  static constexpr auto kRel = std::memory_order_release;
+  static constexpr auto kSeqCst = std::memory_order_seq_cst;
+
+ public:
+  // Power of two. Recursive algorithms require only about one entry per level;
+  // `TaskScheduler::Spawn` runs tasks immediately if the deque is full.
+  static constexpr int64_t kCapacity = 256;
+
+  // Owner only. Returns false if full.
+  bool Push(const SpawnedTask& task) {
+    const int64_t b = bottom_.load(kRlx);
+    const int64_t t = top_.load(kAcq);
+    if (HWY_UNLIKELY(b - t >= kCapacity)) return false;
+    Slot& slot = slots_[b & (kCapacity - 1)];
+    slot.func.store(task.func, kRlx);
+    slot.opaque.store(task.opaque, kRlx);
+    slot.group.store(task.group, kRlx);
+    bottom_.store(b + 1, kRel);  // publishes the slot
+    return true;
+  }
+
+  // Owner only. Returns false if empty.
+  bool Pop(SpawnedTask& task) {
+    const int64_t b = bottom_.load(kRlx) - 1;
+    bottom_.store(b, kRlx);
+    std::atomic_thread_fence(kSeqCst);
+    int64_t t = top_.load(kRlx);
+    if (t > b) {  // was empty
+      bottom_.store(b + 1, kRlx);
+      return false;
+    }
+    Load(b, task);
+    if (t != b) return true;  // more than one: no race with thieves
+
+    // Last task: race with thieves by advancing `top_` as they do.
+    const bool won = top_.compare_exchange_strong(t, t + 1, kSeqCst, kRlx);
+    bottom_.store(b + 1, kRlx);
+    return won;
+  }
+
+  // Any thread. Returns false if empty or another thread won the race.
+  bool Steal(SpawnedTask& task) {
+    int64_t t = top_.load(kAcq);
+    std::atomic_thread_fence(kSeqCst);
+    const int64_t b = bottom_.load(kAcq);
+    if (t >= b) return false;
+    // If the owner overwrites this slot after we read it, it has observed a
+    // larger `top_`, so the following CAS fails.
+    Load(t, task);
+    return top_.compare_exchange_strong(t, t + 1, kSeqCst, kRlx);
+  }
+
+  // Any thread; may be stale by the time it returns.
+  bool MaybeNonEmpty() const { return top_.load(kAcq) < bottom_.load(kAcq); }
+
+ private:
+  // Atomic because thieves may read a slot while the owner overwrites it.
+  struct Slot {
+    std::atomic<SpawnedTask::Func> func;
+    std::atomic<const void*> opaque;
+    std::atomic<TaskGroup*> group;
+  };
+
+  void Load(int64_t i, SpawnedTask& task) const {
+    const Slot& slot = slots_[i & (kCapacity - 1)];
+    task.func = slot.func.load(kRlx);
+    task.opaque = slot.opaque.load(kRlx);
+    task.group = slot.group.load(kRlx);
+  }
+
+  // Separate cache lines: thieves write `top_`, the owner mostly `bottom_`.
+  alignas(HWY_ALIGNMENT) std::atomic<int64_t> top_{0};
+  alignas(HWY_ALIGNMENT) std::atomic<int64_t> bottom_{0};
+  alignas(HWY_ALIGNMENT) Slot slots_[kCapacity];
+};
+
+// Per-worker state of `TaskScheduler`.
+struct alignas(HWY_ALIGNMENT) TaskWorker {
+  TaskDeque deque;
+  // Only accessed by the owner: the order in which to visit victims, and the
+  // most recent one, from which we first attempt to steal again.
+  ShuffledIota shuffled_iota;
+  uint32_t victim = 0;
+};
+
+}  // namespace pool
+
+// Counts the tasks spawned into it that have not yet finished. Must outlive
+// the `TaskScheduler::Sync` that waits for them.
+class TaskGroup {
+ public:
+  TaskGroup() = default;
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  bool IsDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+ private:
+  friend class TaskScheduler;
+
+  std::atomic<uint64_t> pending_{0};
+};
+
+// Fork-join scheduler for irregular or recursive workloads, whose tasks may
+// spawn further tasks. `ThreadPool::Run` instead requires all tasks to be known
+// up front and is more efficient for regular workloads.
+//
+// Each worker of the pool has a deque of spawned tasks. Workers run their own
+// tasks in LIFO order, and when out of work, steal from other workers in the
+// random order of `pool::ShuffledIota`. Workers without anything to steal spin
+// briefly, then block on a futex until a task is spawned.
+//
+// Example (`worker` is the argument passed to the closure):
+//   TaskGroup group;
+//   const auto left = [&](size_t worker) { ... };
+//   scheduler.Spawn(group, worker, left);
+//   right(worker);  // runs concurrently with `left`
+//   scheduler.Sync(group, worker);
+class TaskScheduler {
+  static constexpr auto kAcq = std::memory_order_acquire;
+  static constexpr auto kRel = std::memory_order_release;
+
+  // Number of unsuccessful attempts to find work before blocking.
+  static constexpr size_t kSpinRounds = 1000;
+
+ public:
+  // `pool` must outlive this, and must not be used for other `Run` while
+  // `TaskScheduler::Run` is active.
+  explicit TaskScheduler(ThreadPool& pool)
+      : pool_(pool),
+        div_workers_(pool.NumWorkers()),
+        workers_(MakeUniqueAlignedArray<pool::TaskWorker>(pool.NumWorkers())) {
+    const uint32_t num_workers = static_cast<uint32_t>(pool.NumWorkers());
+    for (uint32_t worker = 0; worker < num_workers; ++worker) {
+      // Same seeding as `pool::Worker`, to reduce collisions.
+      workers_[worker].shuffled_iota =
+          pool::ShuffledIota(pool::ShuffledIota::FindAnotherCoprime(
+              num_workers, (worker + 1) * 257 + worker * 13));
+      workers_[worker].victim = worker;
+    }
+  }
+
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  size_t NumWorkers() const { return pool_.NumWorkers(); }
+
+  // Calls `root(worker)` on the main thread, while all other workers run
+  // tasks spawned by it or its descendants. `root` must `Sync` all groups it
+  // spawns into before returning. Not thread-safe.
+  template <class Closure>
+  void Run(const Closure& root) {
+    done_.store(0, kRel);
+    pool_.Run(0, NumWorkers(), [this, &root](uint64_t task, size_t worker) {
+      // One task per worker, hence `ThreadPool` assigns them in order.
+      HWY_DASSERT(task == worker);
+      (void)task;
+      if (worker == 0) {
+        root(worker);
+        done_.store(1, kRel);
+        WakeIdle();
+      } else {
+        WorkerLoop(worker);
+      }
+    });
+  }
+
+  // Arranges for `closure(worker)` to be called by some worker, possibly this
+  // one, before `Sync(group, worker)` returns. `worker` is the index passed to
+  // the currently running closure. `closure` is not copied, so it must remain
+  // valid until then.
+  template <class Closure>
+  void Spawn(TaskGroup& group, size_t worker, const Closure& closure) {
+    HWY_DASSERT(worker < NumWorkers());
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+    const pool::SpawnedTask task = {&CallClosure<Closure>, &closure, &group};
+    if (HWY_UNLIKELY(!workers_[worker].deque.Push(task))) {
+      return Execute(task, worker);
+    }
+
+    // Pairs with the fence in `Block`: either we see the idle worker, or it
+    // sees our task.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (HWY_UNLIKELY(num_idle_.load(std::memory_order_relaxed) != 0)) {
+      WakeIdle();
+    }
+  }
+
+  // Runs tasks, spawned into any group, until all tasks spawned into `group`
+  // have finished.
+  void Sync(TaskGroup& group, size_t worker) {
+    HWY_DASSERT(worker < NumWorkers());
+    while (!group.IsDone()) {
+      if (!RunOne(worker)) hwy::Pause();
+    }
+  }
+
+ private:
+  template <class Closure>
+  static void CallClosure(const void* opaque, size_t worker) {
+    (*reinterpret_cast<const Closure*>(opaque))(worker);
+  }
+
+  void Execute(const pool::SpawnedTask& task, size_t worker) {
+    task.func(task.opaque, worker);
+    task.group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  // Runs our most recently spawned task, or else one stolen from another
+  // worker. Returns false if none were found.
+  bool RunOne(size_t worker) {
+    pool::TaskWorker& self = workers_[worker];
+    pool::SpawnedTask task;
+    if (self.deque.Pop(task)) {
+      Execute(task, worker);
+      return true;
+    }
+
+    // Begin with the most recent victim, then visit all others.
+    uint32_t victim = self.victim;
+    for (size_t i = 0; i < NumWorkers(); ++i) {
+      if (victim != worker && workers_[victim].deque.Steal(task)) {
+        self.victim = victim;
+        Execute(task, worker);
+        return true;
+      }
+      victim = self.shuffled_iota.Next(victim, div_workers_);
+    }
+    return false;
+  }
+
+  void WorkerLoop(size_t worker) {
+    size_t rounds = 0;
+    while (!done_.load(kAcq)) {
+      if (RunOne(worker)) {
+        rounds = 0;
+      } else if (++rounds < kSpinRounds) {
+        hwy::Pause();
+      } else {
+        rounds = 0;
+        Block();
+      }
+    }
+    HWY_DASSERT(!workers_[worker].deque.MaybeNonEmpty());
+  }
+
+  bool AnyWork() const {
+    for (size_t worker = 0; worker < NumWorkers(); ++worker) {
+      if (workers_[worker].deque.MaybeNonEmpty()) return true;
+    }
+    return false;
+  }
+
+  // Waits until `WakeIdle`, unless there is work or we are done.
+  void Block() {
+    num_idle_.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Load before checking for work, so that a wakeup in between causes
+    // `BlockUntilDifferent` to return immediately.
+    const uint32_t epoch = wake_epoch_.load(kAcq);
+    if (!done_.load(kAcq) && !AnyWork()) {
+      (void)BlockUntilDifferent(epoch, wake_epoch_);
+    }
+    num_idle_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void WakeIdle() {
+    wake_epoch_.fetch_add(1, kRel);
+    WakeAll(wake_epoch_);
+  }
+
+  ThreadPool& pool_;
+  const Divisor64 div_workers_;
+  AlignedUniquePtr<pool::TaskWorker[]> workers_;
+
+  alignas(HWY_ALIGNMENT) std::atomic<uint32_t> done_{0};
+  std::atomic<uint32_t> num_idle_{0};
+  std::atomic<uint32_t> wake_epoch_{0};  // futex
+};
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_WORK_STEALING_H_